@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/14/2015
+// Last modified: 10/19/2026
 // Description: The entry point for the entire application.
 // ====================================================================================================================
 
@@ -16,18 +16,32 @@
 // Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 // ====================================================================================================================
 
+#include "utils/cbor.hpp"
 #include "utils/command_line_exception.hpp"
 #include "utils/http_exception.hpp"
 #include "utils/json_exception.hpp"
+#include "utils/helper.hpp"
 #include "command_line_parser.hpp"
+#include "endpoint_selector.hpp"
 #include "http_get_request.hpp"
 #include "http_post_request.hpp"
+#include "http_session.hpp"
+#include "offline_dictionary.hpp"
 #include "result_writer.hpp"
 #include "configuration_reader.hpp"
 
 #include <json/json.h>
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
 #include <unistd.h>
 #include <sys/types.h>
 #include <pwd.h>
@@ -37,16 +51,23 @@ using lgeorgieff::translate::utils::CommandLineException;
 using lgeorgieff::translate::utils::Exception;
 using lgeorgieff::translate::utils::HttpException;
 using lgeorgieff::translate::utils::JsonException;
+using lgeorgieff::translate::utils::trim;
+using lgeorgieff::translate::client::EndpointSelector;
 using lgeorgieff::translate::client::HttpGetRequest;
 using lgeorgieff::translate::client::HttpPostRequest;
+using lgeorgieff::translate::client::HttpRequest;
+using lgeorgieff::translate::client::HttpSession;
+using lgeorgieff::translate::client::HttpTiming;
+using lgeorgieff::translate::client::OfflineDictionary;
 using lgeorgieff::translate::client::ResultWriter;
 using lgeorgieff::translate::client::ConfigurationReader;
 
-// Create a JSON string based on the corresponding command line arguments
+// Create a JSON object based on the corresponding command line arguments
 // that can be used for a post/translation request.
-std::string create_post_data(const CommandLineParser &cmd_parser, const ConfigurationReader &config_reader) {
+Json::Value create_post_data(const std::string &phrase, const CommandLineParser &cmd_parser,
+                             const ConfigurationReader &config_reader) {
   Json::Value result;
-  result["phrase"] = cmd_parser.phrase();
+  result["phrase"] = phrase;
   result["show_phrase"] = cmd_parser.has_show_phrase() || !config_reader.available() ? cmd_parser.show_phrase()
                                                                                      : config_reader.show_phrase();
   result["show_word_class"] = cmd_parser.has_show_word_class() || !config_reader.available()
@@ -61,21 +82,283 @@ std::string create_post_data(const CommandLineParser &cmd_parser, const Configur
                                     : config_reader.show_abbreviation();
   result["show_comment"] = cmd_parser.has_show_comment() || !config_reader.available() ? cmd_parser.show_comment()
                                                                                        : config_reader.show_comment();
-  Json::StreamWriterBuilder json_writer;
-  json_writer.settings_["indentation"] = "";
-  return Json::writeString(json_writer, result);
+  return result;
+}
+
+// The signature of the ResultWriter functions that write a response of the service
+typedef void (ResultWriter::*WriteFunction)(const std::string &);
+
+// Returns true if the timing of each request is written, either set by --timing or by the configuration file.
+bool show_timing(const CommandLineParser &cmd_parser, const ConfigurationReader &config_reader) {
+  return cmd_parser.timing() || config_reader.timing();
+}
+
+// Writes the passed duration in microseconds as milliseconds.
+std::ostream &write_milliseconds(std::ostream &destination, int64_t microseconds) {
+  return destination << std::fixed << std::setprecision(3) << microseconds / 1000.0 << " ms";
+}
+
+// Writes the phases of the passed request to stderr. The server time is the time to the first byte after the
+// connection was established, so a slow network and a slow server can be told apart.
+void write_timing(const std::string &url, const HttpTiming &timing) {
+  std::cerr << "Timing of \"" << url << "\": name lookup ";
+  write_milliseconds(std::cerr, timing.name_lookup) << ", connect ";
+  write_milliseconds(std::cerr, timing.connect) << ", TLS handshake ";
+  write_milliseconds(std::cerr, timing.tls_handshake) << ", first byte ";
+  write_milliseconds(std::cerr, timing.first_byte) << " (server ";
+  write_milliseconds(std::cerr, timing.first_byte - std::max(timing.connect, timing.tls_handshake)) << "), total ";
+  write_milliseconds(std::cerr, timing.total) << ", " << timing.bytes_down << " bytes down" << std::endl;
+}
+
+// Writes the passed duration of a local step, e.g. the rendering of a response, to stderr.
+void write_timing(const std::string &step, std::chrono::steady_clock::duration duration) {
+  std::cerr << "Timing of " << step << ": ";
+  write_milliseconds(std::cerr, std::chrono::duration_cast<std::chrono::microseconds>(duration).count())
+      << std::endl;
+}
+
+// Writes the passed response by the passed function of the writer. If timing is set, the duration of parsing and
+// writing the response is written to stderr.
+void render(ResultWriter &writer, WriteFunction write, const std::string &response, bool timing) {
+  const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  (writer.*write)(response);
+  if (timing) write_timing("parsing and rendering", std::chrono::steady_clock::now() - start);
+}
+
+// The prefix of an endpoint or service address that denotes the path of a Unix domain socket, e.g.
+// "unix:/run/trlt.sock"
+const std::string UNIX_SOCKET_PREFIX{"unix:"};
+
+// The accept header of all requests to the service. CBOR is preferred since it is smaller and faster to decode, older
+// services that only know JSON still answer with JSON.
+const std::string ACCEPT_HEADER{lgeorgieff::translate::utils::CBOR_MEDIA_TYPE + ", application/json;q=0.9"};
+
+// The endpoints of the service and the way requests are sent to them
+struct Service {
+  EndpointSelector endpoints;
+  // The path of all requests in front of the resource, e.g. "/trlt/"
+  std::string url_prefix;
+  // The delay in milliseconds before a request is sent to the next endpoint as well, 0 disables hedged requests
+  long hedge_delay;
+  // The session whose connections are reused or nullptr
+  HttpSession *session;
+};
+
+// Sends the request that the passed function creates for a URL to the endpoints of the service, the fastest healthy
+// endpoint first, and returns the first answered request, see HttpRequest::perform_first. The latency history of
+// the endpoints is updated. If all endpoints fail, an HttpException is thrown.
+std::unique_ptr<HttpRequest> perform(Service &service, const std::string &path,
+                                     const std::function<HttpRequest *(const std::string &)> &create) {
+  const std::vector<std::string> endpoints{service.endpoints.ranked()};
+  std::vector<std::unique_ptr<HttpRequest>> requests;
+  std::vector<HttpRequest *> pending_requests;
+  for (const std::string &endpoint : endpoints) {
+    if (!endpoint.compare(0, UNIX_SOCKET_PREFIX.size(), UNIX_SOCKET_PREFIX)) {
+      // the host is only used for the Host header of a request through a Unix domain socket
+      requests.emplace_back(create("localhost" + service.url_prefix + path));
+      requests.back()->unix_socket(endpoint.substr(UNIX_SOCKET_PREFIX.size()));
+    } else {
+      requests.emplace_back(create(endpoint + service.url_prefix + path));
+    }
+    requests.back()->session(service.session);
+    pending_requests.push_back(requests.back().get());
+  }
+
+  HttpRequest *first{nullptr};
+  std::string error;
+  try {
+    first = &HttpRequest::perform_first(pending_requests, service.hedge_delay);
+  } catch (HttpException &err) {
+    error = err.what();
+  }
+  // Requests that were cancelled after the first answer neither succeeded nor failed
+  size_t first_pos{0};
+  for (size_t pos{0}; pos != requests.size(); ++pos) {
+    if (first == requests[pos].get()) first_pos = pos;
+    if (!requests[pos]->error().empty() || 500 <= requests[pos]->status_code())
+      service.endpoints.record_failure(endpoints[pos]);
+    else if (first == requests[pos].get())
+      service.endpoints.record_success(endpoints[pos], first->timing().total);
+  }
+  service.endpoints.save();
+  if (!first) throw HttpException{error};
+  return std::move(requests[first_pos]);
+}
+
+// Returns the body of the passed answered request as JSON text, a CBOR body is converted. In error case a
+// JsonException is thrown.
+std::string response_json(const HttpRequest &request) {
+  const std::string content_type{request.content_type()};
+  if (content_type.compare(0, lgeorgieff::translate::utils::CBOR_MEDIA_TYPE.size(),
+                           lgeorgieff::translate::utils::CBOR_MEDIA_TYPE))
+    return request.result();
+  return lgeorgieff::translate::utils::cbor_to_json_string(request.result());
 }
 
 // A helper function that performs an HTTP get request and returns the reponse's string value.
-// In error case an HttpException is thrown.
-std::string process_request(const std::string &url) {
-  HttpGetRequest request{url};
-  request();
-  if (200 != request.status_code()) {
-    throw HttpException{"HTTP status code " + std::to_string(request.status_code()) + " for \"" + request.url() +
+// In error case an HttpException is thrown. If timing is set, the phases of the request are written to stderr.
+std::string process_request(Service &service, const std::string &path, bool timing) {
+  std::unique_ptr<HttpRequest> request{
+      perform(service, path, [](const std::string &url) { return new HttpGetRequest{url, ACCEPT_HEADER}; })};
+  if (timing) write_timing(request->url(), request->timing());
+  if (200 != request->status_code()) {
+    throw HttpException{"HTTP status code " + std::to_string(request->status_code()) + " for \"" + request->url() +
                         "\"!"};
   }
-  return request.result();
+  return response_json(*request);
+}
+
+// Requests the translation of the passed phrase and writes it. Nothing is written if there is no translation.
+// The translation is looked up in the local dictionary if --offline is set or if the request fails and there is a
+// dictionary for the languages. In error case an HttpException, a JsonException or an Exception is thrown.
+void process_translation(Service &service, const std::string &phrase, const std::string &language_in,
+                         const std::string &language_out, const CommandLineParser &cmd_parser,
+                         const ConfigurationReader &config_reader, ResultWriter &writer,
+                         OfflineDictionary &dictionary) {
+  const bool timing{show_timing(cmd_parser, config_reader)};
+  Json::Value post_data{create_post_data(phrase, cmd_parser, config_reader)};
+  if (!cmd_parser.offline()) {
+    try {
+      Json::StreamWriterBuilder json_writer;
+      json_writer.settings_["indentation"] = "";
+      const std::string post_string{Json::writeString(json_writer, post_data)};
+      std::unique_ptr<HttpRequest> request{
+          perform(service, "translation/" + language_in + "/" + language_out + "/",
+                  [&post_string](const std::string &url) {
+                    return new HttpPostRequest{url, post_string, ACCEPT_HEADER};
+                  })};
+      if (timing) write_timing(request->url(), request->timing());
+      if (200 != request->status_code() && 404 != request->status_code()) {
+        throw HttpException{"Could not process \"" + request->url() + "\", HTTP status code: " +
+                            std::to_string(request->status_code())};
+      } else if (404 != request->status_code()) {
+        render(writer, &ResultWriter::write_translation, response_json(*request), timing);
+      }
+      return;
+    } catch (HttpException &err) {
+      if (!dictionary.available(language_in, language_out)) throw;
+      std::cerr << "Could not process server request: " << err.what() << std::endl
+                << "Using the local dictionary instead" << std::endl;
+    }
+  }
+  const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  std::string translation{dictionary(phrase, language_in, language_out, post_data)};
+  if (timing) write_timing("the local dictionary lookup", std::chrono::steady_clock::now() - start);
+  render(writer, &ResultWriter::write_translation, translation, timing);
+}
+
+// The commands of the interactive mode
+const std::string INTERACTIVE_USAGE{
+    "Each line is translated from the current origin to the current target language, except for the commands:\n"
+    ":in <language ID>   set the origin language\n"
+    ":out <language ID>  set the target language\n"
+    ":swap               swap the origin and the target language\n"
+    ":languages          show all languages that are available\n"
+    ":word-classes       show all word classes that are available\n"
+    ":genders            show all genders that are available\n"
+    ":numeri             show all numeri that are available\n"
+    ":help               show this message\n"
+    ":quit               quit, as well as the end of the input\n"};
+
+// The state of the interactive mode that is kept for all lines: the connections to the service and the lists of the
+// service, which are requested only once.
+struct InteractiveSession {
+  Service &service;
+  std::string language_in;
+  std::string language_out;
+  bool timing;
+  HttpSession http_session;
+  // The responses of the list requests by their URL path
+  std::map<std::string, std::string> lists;
+};
+
+// Returns the response of the passed list, e.g. "languages", and requests it only if it is not cached yet.
+const std::string &request_list(InteractiveSession &session, const std::string &path) {
+  auto list = session.lists.find(path);
+  if (session.lists.end() == list)
+    list = session.lists.emplace(path, process_request(session.service, path, session.timing)).first;
+  return list->second;
+}
+
+// Returns true if the passed language ID is one of the languages of the server.
+bool is_language(InteractiveSession &session, const std::string &language_id) {
+  Json::Value languages;
+  Json::CharReaderBuilder json_reader;
+  std::string errors;
+  std::istringstream input{request_list(session, "languages")};
+  if (!Json::parseFromStream(json_reader, input, &languages, &errors) || !languages.isArray()) {
+    throw JsonException{"Cannot process the json data " + request_list(session, "languages") + ". " + errors};
+  }
+  for (const Json::Value &language : languages) {
+    if (language.isObject() && language["id"].isString() && language_id == language["id"].asString()) return true;
+  }
+  return false;
+}
+
+// Reads phrases and commands line by line from the standard input until the end of the input or ":quit". The errors
+// of a single line are reported without quitting.
+int process_interactive(Service &service, const CommandLineParser &cmd_parser,
+                        const ConfigurationReader &config_reader, ResultWriter &writer,
+                        OfflineDictionary &dictionary) {
+  InteractiveSession session{service, cmd_parser.has_in() ? cmd_parser.in() : config_reader.language_in(),
+                             cmd_parser.has_out() ? cmd_parser.out() : config_reader.language_out(),
+                             show_timing(cmd_parser, config_reader), HttpSession{},
+                             std::map<std::string, std::string>{}};
+  service.session = &session.http_session;
+  const bool prompt{1 == isatty(STDIN_FILENO)};
+  std::string line;
+  while (true) {
+    if (prompt) std::cout << session.language_in << " -> " << session.language_out << "> " << std::flush;
+    if (!std::getline(std::cin, line)) break;
+    trim(line);
+    if (line.empty()) continue;
+    try {
+      if (":quit" == line) {
+        break;
+      } else if (":help" == line) {
+        std::cout << INTERACTIVE_USAGE;
+      } else if (":swap" == line) {
+        std::swap(session.language_in, session.language_out);
+      } else if (":languages" == line) {
+        render(writer, &ResultWriter::write_languages, request_list(session, "languages"), session.timing);
+      } else if (":word-classes" == line) {
+        render(writer, &ResultWriter::write_word_classes, request_list(session, "word_classes"), session.timing);
+      } else if (":genders" == line) {
+        render(writer, &ResultWriter::write_genders, request_list(session, "genders"), session.timing);
+      } else if (":numeri" == line) {
+        render(writer, &ResultWriter::write_numeri, request_list(session, "numeri"), session.timing);
+      } else if (0 == line.find(":in ") || 0 == line.find(":out ")) {
+        const bool in{0 == line.find(":in ")};
+        std::string language_id{line.substr(in ? 4 : 5)};
+        trim(language_id);
+        bool known{true};
+        try {
+          // the language is only checked if the service is reachable
+          if (!cmd_parser.offline()) known = is_language(session, language_id);
+        } catch (HttpException &) {
+        }
+        if (known) {
+          (in ? session.language_in : session.language_out) = language_id;
+        } else {
+          std::cerr << "The language \"" << language_id << "\" is not known, try \":languages\"" << std::endl;
+        }
+      } else if (':' == line[0]) {
+        std::cerr << "The command \"" << line << "\" is not known, try \":help\"" << std::endl;
+      } else {
+        process_translation(service, line, session.language_in, session.language_out, cmd_parser, config_reader,
+                            writer, dictionary);
+      }
+    } catch (HttpException &err) {
+      std::cerr << "Could not process server request: " << err.what() << std::endl;
+    } catch (JsonException &err) {
+      std::cerr << "Could not process the server's response: " << err.what() << std::endl;
+    } catch (Exception &err) {
+      std::cerr << "Could not process the local dictionary: " << err.what() << std::endl;
+    }
+  }
+  if (prompt) std::cout << std::endl;
+  service.session = nullptr;
+  return 0;
 }
 
 int main(const int argc, const char **argv) {
@@ -88,20 +371,20 @@ int main(const int argc, const char **argv) {
   }  // try-catch get confguration file path
 
   ConfigurationReader config_reader{config_path};
-  std::string base_url{"localhost:8885/trlt/"};
+  std::string url_prefix{"/trlt/"};
   try {
     cmd_parser(argc, argv);
 
     if (!cmd_parser.help()) {
       try {
         config_reader();
-        base_url = config_reader.service_address() + ":" + std::to_string(config_reader.service_port());
+        url_prefix.clear();
         if (!config_reader.service_url_prefix().empty() && config_reader.service_url_prefix()[0] != '/')
-          base_url += '/';
-        base_url += config_reader.service_url_prefix();
+          url_prefix += '/';
+        url_prefix += config_reader.service_url_prefix();
         if (!config_reader.service_url_prefix().empty() &&
             config_reader.service_url_prefix()[config_reader.service_url_prefix().size() - 1] != '/')
-          base_url += '/';
+          url_prefix += '/';
       } catch (const JsonException &err) {
         std::cerr << "Could not process configuration file: " << err.what() << std::endl;
       } catch (const Exception &err) {
@@ -109,43 +392,61 @@ int main(const int argc, const char **argv) {
       }
     }  // try-catch configuration reader
 
+    // The local dictionaries and the latency history are stored next to the configuration file by default
+    const std::string config_folder{std::string::npos == config_path.rfind('/')
+                                        ? std::string{"."}
+                                        : config_path.substr(0, config_path.rfind('/'))};
+    std::vector<std::string> endpoints{config_reader.service_endpoints()};
+    if (endpoints.empty() &&
+        !config_reader.service_address().compare(0, UNIX_SOCKET_PREFIX.size(), UNIX_SOCKET_PREFIX))
+      endpoints.push_back(config_reader.service_address());
+    else if (endpoints.empty())
+      endpoints.push_back(config_reader.service_address() + ":" + std::to_string(config_reader.service_port()));
+    Service service{EndpointSelector{endpoints, config_folder + "/latency.json"}, url_prefix,
+                    static_cast<long>(config_reader.hedge_delay()), nullptr};
+    service.endpoints.load();
+    OfflineDictionary dictionary{config_reader.dictionary_folder().empty() ? config_folder
+                                                                           : config_reader.dictionary_folder()};
+
     ResultWriter writer{&std::cout};
+    const bool timing{show_timing(cmd_parser, config_reader)};
     if (cmd_parser.help()) {
       std::cout << cmd_parser.usage() << std::endl
                 << std::endl;
       return 0;
+    } else if (cmd_parser.interactive()) {
+      return process_interactive(service, cmd_parser, config_reader, writer, dictionary);
     } else if (cmd_parser.all_languages()) {
-      writer.write_languages(process_request(base_url + "languages"));
+      render(writer, &ResultWriter::write_languages, process_request(service, "languages", timing), timing);
     } else if (cmd_parser.all_word_classes()) {
-      writer.write_word_classes(process_request(base_url + "word_classes"));
+      render(writer, &ResultWriter::write_word_classes, process_request(service, "word_classes", timing), timing);
     } else if (cmd_parser.all_genders()) {
-      writer.write_genders(process_request(base_url + "genders"));
+      render(writer, &ResultWriter::write_genders, process_request(service, "genders", timing), timing);
     } else if (cmd_parser.all_numeri()) {
-      writer.write_numeri(process_request(base_url + "numeri"));
+      render(writer, &ResultWriter::write_numeri, process_request(service, "numeri", timing), timing);
     } else if (cmd_parser.has_language_id()) {
-      writer.write_language_name(process_request(base_url + "language/id/" + cmd_parser.language_id()));
+      render(writer, &ResultWriter::write_language_name,
+             process_request(service, "language/id/" + cmd_parser.language_id(), timing), timing);
     } else if (cmd_parser.has_language_name()) {
-      writer.write_language_id(process_request(base_url + "language/name/" + cmd_parser.language_name()));
+      render(writer, &ResultWriter::write_language_id,
+             process_request(service, "language/name/" + cmd_parser.language_name(), timing), timing);
     } else if (cmd_parser.has_word_class_id()) {
-      writer.write_word_class_name(process_request(base_url + "word_class/id/" + cmd_parser.word_class_id()));
+      render(writer, &ResultWriter::write_word_class_name,
+             process_request(service, "word_class/id/" + cmd_parser.word_class_id(), timing), timing);
     } else if (cmd_parser.has_word_class_name()) {
-      writer.write_word_class_id(process_request(base_url + "word_class/name/" + cmd_parser.word_class_name()));
+      render(writer, &ResultWriter::write_word_class_id,
+             process_request(service, "word_class/name/" + cmd_parser.word_class_name(), timing), timing);
     } else if (cmd_parser.has_gender_id()) {
-      writer.write_gender_name(process_request(base_url + "gender/id/" + cmd_parser.gender_id()));
+      render(writer, &ResultWriter::write_gender_name,
+             process_request(service, "gender/id/" + cmd_parser.gender_id(), timing), timing);
     } else if (cmd_parser.has_gender_name()) {
-      writer.write_gender_id(process_request(base_url + "gender/name/" + cmd_parser.gender_name()));
+      render(writer, &ResultWriter::write_gender_id,
+             process_request(service, "gender/name/" + cmd_parser.gender_name(), timing), timing);
     } else if (cmd_parser.has_phrase()) {
       std::string language_in{cmd_parser.has_in() ? cmd_parser.in() : config_reader.language_in()};
       std::string language_out{cmd_parser.has_out() ? cmd_parser.out() : config_reader.language_out()};
-      HttpPostRequest request{base_url + "translation/" + language_in + "/" + language_out + "/",
-                              create_post_data(cmd_parser, config_reader)};
-      request();
-      if (200 != request.status_code() && 404 != request.status_code()) {
-        throw HttpException{"Could not process \"" + request.url() + "\", HTTP status code: " +
-                            std::to_string(request.status_code())};
-      } else if (404 != request.status_code()) {
-        writer.write_translation(request.result());
-      }
+      process_translation(service, cmd_parser.phrase(), language_in, language_out, cmd_parser, config_reader,
+                          writer, dictionary);
     } else {
       std::cerr << "Expected an argument representing a phrase to be translated!" << std::endl
                 << "Try \"" << *argv << " --help\" for more information" << std::endl;
@@ -162,5 +463,8 @@ int main(const int argc, const char **argv) {
   } catch (JsonException &err) {
     std::cerr << "Could not process the server's response: " << err.what() << std::endl;
     return 2;
+  } catch (Exception &err) {
+    std::cerr << "Could not process the local dictionary: " << err.what() << std::endl;
+    return 2;
   }  // try-catch command line parser
 }
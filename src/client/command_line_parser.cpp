@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/10/2015
+// Last modified: 10/19/2026
 // Description: Implements the command line parser interface which is adapted to the supported options of this program.
 // ====================================================================================================================
 
@@ -44,6 +44,9 @@ const std::string CommandLineParser::ALL_GENDERS_LONG{"--all-genders"};
 const std::string CommandLineParser::GENDER_ID_LONG{"--gender-id"};
 const std::string CommandLineParser::GENDER_NAME_LONG{"--gender-name"};
 const std::string CommandLineParser::ALL_NUMERI_LONG{"--all-numeri"};
+const std::string CommandLineParser::INTERACTIVE_LONG{"--interactive"};
+const std::string CommandLineParser::OFFLINE_LONG{"--offline"};
+const std::string CommandLineParser::TIMING_LONG{"--timing"};
 const std::string CommandLineParser::SHOW_PHRASE_LONG{"--show-phrase"};
 const std::string CommandLineParser::SHOW_WORD_CLASS_LONG{"--show-word-class"};
 const std::string CommandLineParser::SHOW_GENDER_LONG{"--show-gender"};
@@ -80,6 +83,9 @@ CommandLineParser::CommandLineParser(const std::string &default_in, const std::s
       all_word_classes_{},
       all_genders_{},
       all_numeri_{},
+      interactive_{},
+      offline_{},
+      timing_{},
       has_language_id_{},
       has_language_name_{},
       has_word_class_id_{},
@@ -155,6 +161,12 @@ CommandLineParser &CommandLineParser::operator()(const int argc, const char **ar
       throw CommandLineException{"The value for \"" + std::string{argv[i]} + "\" is missing!"};
     } else if (ALL_NUMERI_LONG == argv[i]) {
       this->all_numeri_ = true;
+    } else if (INTERACTIVE_LONG == argv[i]) {
+      this->interactive_ = true;
+    } else if (OFFLINE_LONG == argv[i]) {
+      this->offline_ = true;
+    } else if (TIMING_LONG == argv[i]) {
+      this->timing_ = true;
     } else if (argc - 1 == i) {
       this->phrase_ = argv[i];
       this->has_phrase_ = true;
@@ -235,7 +247,15 @@ std::string CommandLineParser::usage() const noexcept {
          "                                    ID\n" + GENDER_NAME_LONG +
          " <gender name>         show the gender ID for the given gender\n" +
          "                                    name\n" + ALL_NUMERI_LONG +
-         "                        show all numeri that are available\n" + SHOW_PHRASE_LONG +
+         "                        show all numeri that are available\n" + INTERACTIVE_LONG +
+         "                       read the phrases line by line from the\n" +
+         "                                    standard input, see \":help\"\n" + OFFLINE_LONG +
+         "                           translate from the local dictionaries\n" +
+         "                                    without requesting the service, they\n" +
+         "                                    are also used if the service cannot be\n" +
+         "                                    reached\n" + TIMING_LONG +
+         "                            write the network, server and rendering\n" +
+         "                                    time of each request to stderr\n" + SHOW_PHRASE_LONG +
          "                       show the phrase part of a translation\n" +
          "                                    result (default)\n" + SHOW_WORD_CLASS_LONG +
          "                   show the word class part of a translation\n" +
@@ -258,6 +278,12 @@ bool CommandLineParser::all_genders() const noexcept { return this->all_genders_
 
 bool CommandLineParser::all_numeri() const noexcept { return this->all_numeri_; }
 
+bool CommandLineParser::interactive() const noexcept { return this->interactive_; }
+
+bool CommandLineParser::offline() const noexcept { return this->offline_; }
+
+bool CommandLineParser::timing() const noexcept { return this->timing_; }
+
 bool CommandLineParser::has_language_id() const noexcept { return this->has_language_id_; }
 
 std::string CommandLineParser::language_id() const noexcept { return this->language_id_; }
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/10/2015
+// Last modified: 10/19/2026
 // Description: Declares the interface of the command line parser which is adapted to the supported options of this
 //              program.
 // ====================================================================================================================
@@ -55,6 +55,12 @@ class CommandLineParser {
   static const std::string GENDER_NAME_LONG;
   // The name of the option for getting all numeri
   static const std::string ALL_NUMERI_LONG;
+  // The name of the option for reading phrases line by line from the standard input
+  static const std::string INTERACTIVE_LONG;
+  // The name of the option for translating from the local dictionaries without requesting the service
+  static const std::string OFFLINE_LONG;
+  // The name of the option for writing the timing of each request
+  static const std::string TIMING_LONG;
   // The name of the option for showing the phrase of a final result
   static const std::string SHOW_PHRASE_LONG;
   // The name of the option for showing the word class of a final result
@@ -122,6 +128,12 @@ class CommandLineParser {
   bool all_genders() const noexcept;
   // A getter that indicates whether all numeri are requested or not
   bool all_numeri() const noexcept;
+  // A getter that indicates whether phrases are read from the standard input or not
+  bool interactive() const noexcept;
+  // A getter that indicates whether translations are only looked up in the local dictionaries or not
+  bool offline() const noexcept;
+  // A getter indicating whether to write the timing of each request or not
+  bool timing() const noexcept;
   // A getter that indicates whether a language id was passed or not
   bool has_language_id() const noexcept;
   // A getter for the language id
@@ -197,6 +209,9 @@ class CommandLineParser {
   bool all_word_classes_;
   bool all_genders_;
   bool all_numeri_;
+  bool interactive_;
+  bool offline_;
+  bool timing_;
   bool has_language_id_;
   bool has_language_name_;
   bool has_word_class_id_;
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/14/2015
+// Last modified: 10/19/2026
 // Description: Implements the class ConfigurationReader which reads the configuration for the client. It reads a json
 //              string from the specified file and offers some getters for the parsed data.
 // ====================================================================================================================
@@ -51,6 +51,23 @@ void process_json_string_value(const Json::Value &json_object, const std::string
     destination = json_object[member_name].asString();
   }
 }
+
+// Tries to read the array of strings with member_name from json_object and finally the parsed string values are
+// written into the destination.
+void process_json_string_array(const Json::Value &json_object, const std::string &member_name,
+                               std::vector<std::string> &destination) {
+  if (json_object.isMember(member_name)) {
+    const Json::Value &array = json_object[member_name];
+    bool strings{array.isArray()};
+    for (const Json::Value &item : array) strings = strings && item.isString();
+    if (!strings) {
+      throw lgeorgieff::translate::utils::JsonException{"Cannot process the json data " + array.toStyledString() +
+                                                        ". Expected an array of strings!"};
+    }
+    destination.clear();
+    for (const Json::Value &item : array) destination.push_back(item.asString());
+  }
+}
 }
 
 namespace lgeorgieff {
@@ -65,24 +82,30 @@ const std::string ConfigurationReader::SERVICE_URL_PREFIX_DEFAULT{"trlt"};
 const std::string ConfigurationReader::LANGUAGE_IN_DEFAULT{"DE"};
 const std::string ConfigurationReader::LANGUAGE_OUT_DEFAULT{"EN"};
 const size_t ConfigurationReader::SERVICE_PORT_DEFAULT{8885};
+const size_t ConfigurationReader::HEDGE_DELAY_DEFAULT{0};
 const bool ConfigurationReader::SHOW_PHRASE_DEFAULT{true};
 const bool ConfigurationReader::SHOW_WORD_CLASS_DEFAULT{};
 const bool ConfigurationReader::SHOW_GENDER_DEFAULT{};
 const bool ConfigurationReader::SHOW_NUMERUS_DEFAULT{};
 const bool ConfigurationReader::SHOW_ABBREVIATON_DEFAULT{};
 const bool ConfigurationReader::SHOW_COMMENT_DEFAULT{};
+const bool ConfigurationReader::TIMING_DEFAULT{};
 
 ConfigurationReader::ConfigurationReader(const std::string &configuration_file_path)
     : config_file_path_{configuration_file_path},
       service_address_{SERVICE_ADDRESS_DEFAULT},
       service_url_prefix_{SERVICE_URL_PREFIX_DEFAULT},
+      dictionary_folder_{},
       service_port_{SERVICE_PORT_DEFAULT},
+      service_endpoints_{},
+      hedge_delay_{HEDGE_DELAY_DEFAULT},
       show_phrase_{SHOW_PHRASE_DEFAULT},
       show_word_class_{SHOW_WORD_CLASS_DEFAULT},
       show_gender_{SHOW_GENDER_DEFAULT},
       show_numerus_{SHOW_NUMERUS_DEFAULT},
       show_abbreviation_{SHOW_ABBREVIATON_DEFAULT},
       show_comment_{SHOW_COMMENT_DEFAULT},
+      timing_{TIMING_DEFAULT},
       available_{} {}
 
 ConfigurationReader &ConfigurationReader::operator()() {
@@ -99,6 +122,7 @@ ConfigurationReader &ConfigurationReader::operator()() {
   process_json_string_value(json, "language_in", this->language_in_);
   process_json_string_value(json, "language_out", this->language_out_);
   process_json_string_value(json, "service_url_prefix", this->service_url_prefix_);
+  process_json_string_value(json, "dictionary_folder", this->dictionary_folder_);
 
   if (json.isMember("service_port")) {
     if (!json["service_port"].isUInt()) {
@@ -107,12 +131,21 @@ ConfigurationReader &ConfigurationReader::operator()() {
     }
     this->service_port_ = json["service_port"].asUInt();
   }
+  process_json_string_array(json, "service_endpoints", this->service_endpoints_);
+  if (json.isMember("hedge_delay")) {
+    if (!json["hedge_delay"].isUInt()) {
+      throw JsonException{"Cannot process the json data " + json["hedge_delay"].toStyledString() +
+                          ". Expected a positive json number!"};
+    }
+    this->hedge_delay_ = json["hedge_delay"].asUInt();
+  }
   process_json_bool_value(json, "show_phrase", this->show_phrase_);
   process_json_bool_value(json, "show_word_class", this->show_word_class_);
   process_json_bool_value(json, "show_gender", this->show_gender_);
   process_json_bool_value(json, "show_numerus", this->show_numerus_);
   process_json_bool_value(json, "show_abbreviation", this->show_abbreviation_);
   process_json_bool_value(json, "show_comment", this->show_comment_);
+  process_json_bool_value(json, "timing", this->timing_);
 
   this->available_ = true;
   return *this;
@@ -126,6 +159,10 @@ std::string ConfigurationReader::service_url_prefix() const noexcept { return th
 
 size_t ConfigurationReader::service_port() const noexcept { return this->service_port_; }
 
+std::vector<std::string> ConfigurationReader::service_endpoints() const noexcept { return this->service_endpoints_; }
+
+size_t ConfigurationReader::hedge_delay() const noexcept { return this->hedge_delay_; }
+
 bool ConfigurationReader::show_phrase() const noexcept { return this->show_phrase_; }
 
 bool ConfigurationReader::show_word_class() const noexcept { return this->show_word_class_; }
@@ -138,12 +175,16 @@ bool ConfigurationReader::show_abbreviation() const noexcept { return this->show
 
 bool ConfigurationReader::show_comment() const noexcept { return this->show_comment_; }
 
+bool ConfigurationReader::timing() const noexcept { return this->timing_; }
+
 bool ConfigurationReader::available() const noexcept { return this->available_; }
 
 std::string ConfigurationReader::language_in() const noexcept { return this->language_in_; }
 
 std::string ConfigurationReader::language_out() const noexcept { return this->language_out_; }
 
+std::string ConfigurationReader::dictionary_folder() const noexcept { return this->dictionary_folder_; }
+
 std::string ConfigurationReader::read_file_() {
   std::ifstream in{this->config_file_path_, std::ifstream::in};
   if (in) {
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/14/2015
+// Last modified: 10/19/2026
 // Description: Declares the interface of the configuration reader for the client. It reads a json string from the
 //              specified file and offers some getters for the parsed data.
 // ====================================================================================================================
@@ -24,14 +24,18 @@
 //    "service_address" : <STRING>,
 //    "service_port" : <NUMBER>,
 //    "service_url_prefix" : <STRING>,
+//    "service_endpoints" : [ <STRING>, ... ],
+//    "hedge_delay" : <NUMBER>,
 //    "show_phrase" : <BOOLEAN>,
 //    "show_word_class" : <BOOLEAN>,
 //    "show_gender" : <BOOLEAN>,
 //    "show_numerus" : <BOOLEAN>,
 //    "show_abbreviation" : <BOOLEAN>,
 //    "show_comment" : <BOOLEAN>,
+//    "timing" : <BOOLEAN>,
 //    "language_in": <STRING>,
-//    "language_out": <STRING>
+//    "language_out": <STRING>,
+//    "dictionary_folder": <STRING>
 // }
 //
 // If one of the presented values is not defined, the following default value will be used for the particular
@@ -39,14 +43,28 @@
 //  *service_address: "localhost"
 //  *service_port: 8885
 //  *service_url_prefix: "trlt"
+//  *service_endpoints: [], i.e. only service_address and service_port
+//  *hedge_delay: 0
 //  *show_phrase: true
 //  *show_word_class: false
 //  *show_gender: false
 //  *show_numerus: false
 //  *show_abbreviation: false
 //  *show_comment: false
+//  *timing: false
 //  *language_in: "DE"
 //  *language_out: "EN"
+//  *dictionary_folder: "", i.e. the folder of the configuration file
+//
+// The service endpoints are of the form "<address>:<port>" and replace service_address and service_port. Each request
+// is sent to the fastest healthy endpoint, see EndpointSelector. If hedge_delay is set, the request is sent to the
+// next endpoint as well if it is not answered within this number of milliseconds, the first answer is used.
+//
+// A service address or endpoint of the form "unix:<path>", e.g. "unix:/run/trlt.sock", denotes the Unix domain socket
+// of a trlt.service on the same host (see its option --unix-socket), the service port is ignored then.
+//
+// The dictionary folder contains the binary dictionaries of dict2bin, e.g. DE-EN.bin, which are used by the client
+// if the service cannot be reached or if it is started with --offline.
 // ====================================================================================================================
 
 #ifndef CONFIGURATION_READER_HPP_
@@ -54,6 +72,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 namespace lgeorgieff {
 namespace translate {
@@ -66,12 +85,14 @@ class ConfigurationReader {
   static const std::string LANGUAGE_IN_DEFAULT;
   static const std::string LANGUAGE_OUT_DEFAULT;
   static const size_t SERVICE_PORT_DEFAULT;
+  static const size_t HEDGE_DELAY_DEFAULT;
   static const bool SHOW_PHRASE_DEFAULT;
   static const bool SHOW_WORD_CLASS_DEFAULT;
   static const bool SHOW_GENDER_DEFAULT;
   static const bool SHOW_NUMERUS_DEFAULT;
   static const bool SHOW_ABBREVIATON_DEFAULT;
   static const bool SHOW_COMMENT_DEFAULT;
+  static const bool TIMING_DEFAULT;
 
   explicit ConfigurationReader(const std::string &);
   ConfigurationReader(const ConfigurationReader &) = default;
@@ -90,13 +111,18 @@ class ConfigurationReader {
   std::string service_url_prefix() const noexcept;
   std::string language_in() const noexcept;
   std::string language_out() const noexcept;
+  std::string dictionary_folder() const noexcept;
   size_t service_port() const noexcept;
+  std::vector<std::string> service_endpoints() const noexcept;
+  size_t hedge_delay() const noexcept;
   bool show_phrase() const noexcept;
   bool show_word_class() const noexcept;
   bool show_gender() const noexcept;
   bool show_numerus() const noexcept;
   bool show_abbreviation() const noexcept;
   bool show_comment() const noexcept;
+  // Returns true if the timing of each request is written to stderr.
+  bool timing() const noexcept;
   // Returns true if the configuration files was read and parsed successfully.
   bool available() const noexcept;
 
@@ -108,13 +134,17 @@ class ConfigurationReader {
   std::string service_url_prefix_;
   std::string language_in_;
   std::string language_out_;
+  std::string dictionary_folder_;
   size_t service_port_;
+  std::vector<std::string> service_endpoints_;
+  size_t hedge_delay_;
   bool show_phrase_;
   bool show_word_class_;
   bool show_gender_;
   bool show_numerus_;
   bool show_abbreviation_;
   bool show_comment_;
+  bool timing_;
   bool available_;
 };
 
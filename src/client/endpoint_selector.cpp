@@ -0,0 +1,115 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements the ordering of the service endpoints by their recent latency and health.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if/ not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+
+#include "endpoint_selector.hpp"
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace lgeorgieff {
+namespace translate {
+namespace client {
+
+const double EndpointSelector::LATENCY_WEIGHT{0.3};
+const std::time_t EndpointSelector::FAILURE_BACKOFF{30};
+
+EndpointSelector::EndpointSelector(const std::vector<std::string> &endpoints, const std::string &history_path)
+    : endpoints_{endpoints}, history_path_{history_path}, history_{} {}
+
+EndpointSelector &EndpointSelector::load() {
+  std::ifstream history_stream{this->history_path_};
+  if (!history_stream) return *this;
+  Json::Value json;
+  Json::CharReaderBuilder json_reader;
+  std::string errors;
+  if (!Json::parseFromStream(json_reader, history_stream, &json, &errors) || !json.isObject()) return *this;
+  for (const std::string &endpoint : this->endpoints_) {
+    const Json::Value &entry = json[endpoint];
+    if (!entry.isObject() || !entry["latency"].isNumeric() || !entry["failures"].isUInt() ||
+        !entry["last_failure"].isNumeric())
+      continue;
+    this->history_[endpoint] = History{entry["latency"].asDouble(), entry["failures"].asUInt(),
+                                       static_cast<std::time_t>(entry["last_failure"].asInt64())};
+  }
+  return *this;
+}
+
+bool EndpointSelector::save() const {
+  Json::Value json{Json::objectValue};
+  for (const auto &entry : this->history_) {
+    json[entry.first]["latency"] = entry.second.latency;
+    json[entry.first]["failures"] = static_cast<Json::UInt64>(entry.second.failures);
+    json[entry.first]["last_failure"] = static_cast<Json::Int64>(entry.second.last_failure);
+  }
+  // the file is replaced at once, so concurrent clients never read a partial history
+  const std::string temporary_file{this->history_path_ + ".tmp"};
+  {
+    std::ofstream history_stream{temporary_file, std::ios::trunc};
+    Json::StreamWriterBuilder json_writer;
+    json_writer.settings_["indentation"] = "";
+    history_stream << Json::writeString(json_writer, json) << '\n';
+    if (!history_stream) return false;
+  }
+  return !std::rename(temporary_file.c_str(), this->history_path_.c_str());
+}
+
+std::vector<std::string> EndpointSelector::ranked() const {
+  std::vector<std::string> result{this->endpoints_};
+  std::stable_sort(result.begin(), result.end(), [this](const std::string &lft, const std::string &rgt) {
+    const bool lft_healthy{this->healthy(lft)}, rgt_healthy{this->healthy(rgt)};
+    if (lft_healthy != rgt_healthy) return lft_healthy;
+    if (!lft_healthy) return this->history_.at(lft).last_failure < this->history_.at(rgt).last_failure;
+    return this->latency(lft) < this->latency(rgt);
+  });
+  return result;
+}
+
+void EndpointSelector::record_success(const std::string &endpoint, int64_t latency) {
+  auto entry = this->history_.find(endpoint);
+  if (this->history_.end() == entry || 0 == entry->second.latency) {
+    this->history_[endpoint] = History{static_cast<double>(latency), 0, 0};
+  } else {
+    entry->second.latency = LATENCY_WEIGHT * latency + (1 - LATENCY_WEIGHT) * entry->second.latency;
+    entry->second.failures = 0;
+  }
+}
+
+void EndpointSelector::record_failure(const std::string &endpoint) {
+  History &entry = this->history_[endpoint];
+  ++entry.failures;
+  entry.last_failure = std::time(nullptr);
+}
+
+double EndpointSelector::latency(const std::string &endpoint) const {
+  auto entry = this->history_.find(endpoint);
+  return this->history_.end() == entry ? 0 : entry->second.latency;
+}
+
+bool EndpointSelector::healthy(const std::string &endpoint) const {
+  auto entry = this->history_.find(endpoint);
+  return this->history_.end() == entry || !entry->second.failures ||
+         std::time(nullptr) - entry->second.last_failure >= FAILURE_BACKOFF;
+}
+
+}  // client
+}  // translate
+}  // lgeorgieff
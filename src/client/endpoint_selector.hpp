@@ -0,0 +1,98 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares the ordering of the service endpoints by their recent latency and health.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if/ not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+
+// ====================================================================================================================
+// The latency history is stored as json string of the following form:
+//
+// {
+//    "<address>:<port>" : { "latency" : <NUMBER>, "failures" : <NUMBER>, "last_failure" : <NUMBER> },
+//    ...
+// }
+//
+// latency is the moving average of the total request time in microseconds, failures is the number of consecutive
+// failed requests and last_failure the time of the last failure in seconds since the epoch.
+// ====================================================================================================================
+
+#ifndef ENDPOINT_SELECTOR_HPP_
+#define ENDPOINT_SELECTOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace lgeorgieff {
+namespace translate {
+namespace client {
+
+// Orders the endpoints of the service, so each request is sent to the fastest healthy endpoint first. The latency
+// history is kept in a file, since each run of the client sends only a few requests.
+class EndpointSelector {
+ public:
+  // The weight of a new latency sample in the moving average
+  static const double LATENCY_WEIGHT;
+  // An endpoint is not healthy for this number of seconds after a failed request
+  static const std::time_t FAILURE_BACKOFF;
+
+  // Takes the endpoints, i.e. "<address>:<port>", and the path of the history file.
+  EndpointSelector(const std::vector<std::string> &, const std::string &);
+  EndpointSelector(const EndpointSelector &) = delete;
+  EndpointSelector(EndpointSelector &&) = default;
+  EndpointSelector &operator=(const EndpointSelector &) = delete;
+  EndpointSelector &operator=(EndpointSelector &&) = default;
+  ~EndpointSelector() = default;
+
+  // Reads the history file. A missing or invalid file is ignored, since the history is only a hint.
+  EndpointSelector &load();
+  // Replaces the history file by the history of all endpoints, returns false if it cannot be written.
+  bool save() const;
+
+  // Returns all endpoints in the order they should be requested: the healthy endpoints without latency samples first,
+  // so they are measured, then the healthy endpoints by ascending latency and finally the endpoints that failed
+  // recently, the longest failed one first.
+  std::vector<std::string> ranked() const;
+  // Records a request to the passed endpoint that was answered after the passed number of microseconds.
+  void record_success(const std::string &, int64_t);
+  // Records a failed request to the passed endpoint.
+  void record_failure(const std::string &);
+
+  // Returns the average latency of the passed endpoint in microseconds or 0 if it was not measured so far.
+  double latency(const std::string &) const;
+  // Returns true if the passed endpoint did not fail within the last FAILURE_BACKOFF seconds.
+  bool healthy(const std::string &) const;
+
+ private:
+  struct History {
+    double latency;
+    size_t failures;
+    std::time_t last_failure;
+  };
+
+  std::vector<std::string> endpoints_;
+  std::string history_path_;
+  std::map<std::string, History> history_;
+};  // EndpointSelector
+
+}  // client
+}  // translate
+}  // lgeorgieff
+
+#endif  // ENDPOINT_SELECTOR_HPP_
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/06/2015
+// Last modified: 10/19/2026
 // Description: Implements a class for an HTTP GET request to the translation service.
 // ====================================================================================================================
 
@@ -17,43 +17,15 @@
 // ====================================================================================================================
 
 #include "http_get_request.hpp"
-#include "utils/http_exception.hpp"
 
 namespace lgeorgieff {
 namespace translate {
 namespace client {
 
-using lgeorgieff::translate::utils::HttpException;
+HttpGetRequest::HttpGetRequest(const std::string &url, const std::string &accept_header)
+    : HttpRequest{url, accept_header} {}
 
-HttpGetRequest::HttpGetRequest(const std::string &url) : HttpRequest{url} {}
-
-std::string HttpGetRequest::operator()() {
-  CURL *curl_handle = curl_easy_init();
-  curl_easy_setopt(curl_handle, CURLOPT_URL, this->url_.c_str());
-  curl_easy_setopt(curl_handle, CURLOPT_FOLLOWLOCATION, 1L);
-  curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, &curl_write_);
-  curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, this);
-
-  struct curl_slist *headers = nullptr;
-  std::string accept_header{"Accept: " + this->accept_header_};
-  headers = curl_slist_append(headers, accept_header.c_str());
-  curl_easy_setopt(curl_handle, CURLOPT_HTTPHEADER, headers);
-
-  CURLcode curl_code{curl_easy_perform(curl_handle)};
-  if (CURLE_OK != curl_code) {
-    throw HttpException{"Failed to execute HTTP GET request: curl code " + std::to_string(curl_code) + " (" +
-                        curl_easy_strerror(curl_code) + ")"};
-  }
-
-  curl_code = curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &this->status_code_);
-  if (CURLE_OK != curl_code) {
-    throw HttpException{"Failed to complete HTTP GET request: curl code " + std::to_string(curl_code) + " (" +
-                        curl_easy_strerror(curl_code) + ")"};
-  }
-
-  curl_easy_cleanup(curl_handle);
-  return this->result_;
-}
+curl_slist *HttpGetRequest::setup_(CURL *curl_handle) { return this->setup_request_(curl_handle); }
 
 HttpGetRequest::~HttpGetRequest() {}
 }  // client
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/04/2015
+// Last modified: 10/19/2026
 // Description: Declares a class for an HTTP GET request to the translation service.
 // ====================================================================================================================
 
@@ -29,12 +29,12 @@ namespace client {
 class HttpGetRequest : public HttpRequest {
  public:
   // === Constructors and destructor ==================================================================================
-  explicit HttpGetRequest(const std::string &);
+  explicit HttpGetRequest(const std::string &, const std::string & = HttpRequest::DEFAULT_ACCEPT_HEADER);
   virtual ~HttpGetRequest();
 
-  // The actual method that handles the curl HTTP request and must be implemented in each derived class from
-  // HttpRequest
-  std::string operator()() override;
+ protected:
+  // Sets the options of a GET request
+  curl_slist *setup_(CURL *) override;
 };  // HttpGetRequest
 }  // client
 }  // translate
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/14/2015
+// Last modified: 10/19/2026
 // Description: Declares a class for an HTTP POST request to the translation service.
 // ====================================================================================================================
 
@@ -37,13 +37,13 @@ class HttpPostRequest : public HttpRequest {
                            const std::string& = DEFAULT_CONTENT_TYPE_HEADER);
   virtual ~HttpPostRequest();
 
-  // The actual method that handles the curl HTTP request and must be implemented in each derived class from
-  // HttpRequest
-  std::string operator()() override;
   // A getter for the content type header
   std::string content_type_header() const noexcept;
 
  protected:
+  // Sets the options of a POST request, i.e. the POST data and the content type header in addition
+  curl_slist* setup_(CURL*) override;
+
   std::string post_data_;
   std::string content_type_header_;
 };  // HttpPostRequest
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/06/2015
+// Last modified: 10/19/2026
 // Description: Implements the base class for an HTTP request to the translation service.
 // ====================================================================================================================
 
@@ -17,14 +17,21 @@
 // ====================================================================================================================
 
 #include "http_request.hpp"
+#include "utils/http_exception.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <utility>
 
 namespace lgeorgieff {
 namespace translate {
 namespace client {
 
+using lgeorgieff::translate::utils::HttpException;
+
 const std::string HttpRequest::DEFAULT_ACCEPT_HEADER{"application/json"};
+const long HttpRequest::CONNECT_TIMEOUT{5};
 
 size_t HttpRequest::curl_write_(void *ptr, size_t size, size_t nmemb, void *user_data) {
   HttpRequest *http_request(static_cast<HttpRequest *>(user_data));
@@ -36,36 +43,190 @@ CURLcode HttpRequest::init_curl() { return curl_global_init(CURL_GLOBAL_ALL); }
 
 void HttpRequest::cleanup_curl() { curl_global_cleanup(); }
 
+curl_slist *HttpRequest::setup_request_(CURL *curl_handle) {
+  curl_easy_setopt(curl_handle, CURLOPT_URL, this->url_.c_str());
+  if (!this->unix_socket_.empty()) curl_easy_setopt(curl_handle, CURLOPT_UNIX_SOCKET_PATH, this->unix_socket_.c_str());
+  curl_easy_setopt(curl_handle, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(curl_handle, CURLOPT_CONNECTTIMEOUT, CONNECT_TIMEOUT);
+  curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, &curl_write_);
+  curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, this);
+  return curl_slist_append(nullptr, ("Accept: " + this->accept_header_).c_str());
+}
+
+void HttpRequest::complete_(CURL *curl_handle, CURLcode curl_code) {
+  if (CURLE_OK != curl_code) {
+    this->error_ = "Failed to execute HTTP request \"" + this->url_ + "\": curl code " + std::to_string(curl_code) +
+                   " (" + curl_easy_strerror(curl_code) + ")";
+    return;
+  }
+
+  long status_code{-1};
+  curl_code = curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &status_code);
+  if (CURLE_OK != curl_code) {
+    this->error_ = "Failed to complete HTTP request \"" + this->url_ + "\": curl code " + std::to_string(curl_code) +
+                   " (" + curl_easy_strerror(curl_code) + ")";
+    return;
+  }
+  this->status_code_ = static_cast<int>(status_code);
+  char *content_type{nullptr};
+  if (CURLE_OK == curl_easy_getinfo(curl_handle, CURLINFO_CONTENT_TYPE, &content_type) && content_type)
+    this->content_type_ = content_type;
+
+  curl_off_t value{0};
+  if (CURLE_OK == curl_easy_getinfo(curl_handle, CURLINFO_NAMELOOKUP_TIME_T, &value)) this->timing_.name_lookup = value;
+  if (CURLE_OK == curl_easy_getinfo(curl_handle, CURLINFO_CONNECT_TIME_T, &value)) this->timing_.connect = value;
+  if (CURLE_OK == curl_easy_getinfo(curl_handle, CURLINFO_APPCONNECT_TIME_T, &value))
+    this->timing_.tls_handshake = value;
+  if (CURLE_OK == curl_easy_getinfo(curl_handle, CURLINFO_STARTTRANSFER_TIME_T, &value))
+    this->timing_.first_byte = value;
+  if (CURLE_OK == curl_easy_getinfo(curl_handle, CURLINFO_TOTAL_TIME_T, &value)) this->timing_.total = value;
+  if (CURLE_OK == curl_easy_getinfo(curl_handle, CURLINFO_SIZE_DOWNLOAD_T, &value)) this->timing_.bytes_down = value;
+}
+
+HttpRequest &HttpRequest::perform_first(const std::vector<HttpRequest *> &requests, long delay) {
+  if (requests.empty()) throw HttpException{"Failed to execute HTTP request: no request passed"};
+  std::unique_ptr<HttpSession> own_session;
+  if (!requests.front()->session_) own_session.reset(new HttpSession{});
+  CURLM *multi_handle{requests.front()->session_ ? requests.front()->session_->handle() : own_session->handle()};
+
+  std::vector<CURL *> handles;
+  std::vector<curl_slist *> headers;
+  std::chrono::steady_clock::time_point last_start;
+  // Cancels all running requests and frees their handles
+  auto cleanup = [&]() {
+    for (size_t pos{0}; pos != handles.size(); ++pos) {
+      curl_multi_remove_handle(multi_handle, handles[pos]);
+      curl_easy_cleanup(handles[pos]);
+      curl_slist_free_all(headers[pos]);
+    }
+  };
+  // Starts the next request
+  auto start_next = [&]() {
+    HttpRequest &request = *requests[handles.size()];
+    request.result_.clear();
+    request.content_type_.clear();
+    request.error_.clear();
+    request.status_code_ = -1;
+    request.timing_ = HttpTiming{};
+    CURL *curl_handle{curl_easy_init()};
+    if (!curl_handle) throw HttpException{"Failed to create a curl handle for \"" + request.url_ + "\""};
+    handles.push_back(curl_handle);
+    headers.push_back(nullptr);
+    headers.back() = request.setup_(curl_handle);
+    curl_easy_setopt(curl_handle, CURLOPT_HTTPHEADER, headers.back());
+    curl_multi_add_handle(multi_handle, curl_handle);
+    last_start = std::chrono::steady_clock::now();
+  };
+
+  HttpRequest *first{nullptr};
+  size_t completed{0};
+  try {
+    start_next();
+    while (!first) {
+      int running{0};
+      CURLMcode multi_code{curl_multi_perform(multi_handle, &running)};
+      if (CURLM_OK != multi_code)
+        throw HttpException{"Failed to execute HTTP request: curl multi code " + std::to_string(multi_code) + " (" +
+                            curl_multi_strerror(multi_code) + ")"};
+
+      int remaining_messages{0};
+      while (CURLMsg *message = curl_multi_info_read(multi_handle, &remaining_messages)) {
+        if (CURLMSG_DONE != message->msg) continue;
+        const size_t pos(std::find(handles.begin(), handles.end(), message->easy_handle) - handles.begin());
+        HttpRequest &request = *requests[pos];
+        request.complete_(message->easy_handle, message->data.result);
+        ++completed;
+        const bool pending{handles.size() < requests.size() || completed < handles.size()};
+        if (pending && request.error_.empty() && 500 <= request.status_code_)
+          request.error_ = "HTTP status code " + std::to_string(request.status_code_) + " for \"" + request.url_ + "\"";
+        if (request.error_.empty() || !pending) {
+          first = &request;
+          break;
+        }
+        // all started requests failed, so the next one is started without waiting for the delay
+        if (completed == handles.size()) start_next();
+      }
+      if (first) break;
+
+      int timeout{1000};
+      if (delay > 0 && handles.size() < requests.size()) {
+        const long waited{static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                std::chrono::steady_clock::now() - last_start).count())};
+        if (waited >= delay) {
+          start_next();
+          continue;
+        }
+        timeout = static_cast<int>(delay - waited);
+      }
+      curl_multi_wait(multi_handle, nullptr, 0, timeout, nullptr);
+    }
+  } catch (...) {
+    cleanup();
+    throw;
+  }
+  cleanup();
+  if (!first->error_.empty()) throw HttpException{first->error_};
+  return *first;
+}
+
 HttpRequest::HttpRequest(const std::string &url, const std::string &accept_header)
-    : url_{url}, result_{}, accept_header_{accept_header}, status_code_{-1} {}
+    : url_{url},
+      result_{},
+      content_type_{},
+      accept_header_{accept_header},
+      status_code_{-1},
+      error_{},
+      unix_socket_{},
+      session_{nullptr},
+      timing_{} {}
 
 HttpRequest::HttpRequest(const HttpRequest &other)
     : url_{other.url_},
       result_{other.result_},
+      content_type_{other.content_type_},
       accept_header_{other.accept_header_},
-      status_code_{other.status_code_} {}
+      status_code_{other.status_code_},
+      error_{other.error_},
+      unix_socket_{other.unix_socket_},
+      session_{other.session_},
+      timing_{other.timing_} {}
 
 HttpRequest::HttpRequest(HttpRequest &&other)
     : url_{std::move(other.url_)},
       result_{std::move(other.result_)},
+      content_type_{std::move(other.content_type_)},
       accept_header_{std::move(other.accept_header_)},
-      status_code_{std::move(other.status_code_)} {}
+      status_code_{std::move(other.status_code_)},
+      error_{std::move(other.error_)},
+      unix_socket_{std::move(other.unix_socket_)},
+      session_{other.session_},
+      timing_{other.timing_} {}
 
 HttpRequest::~HttpRequest() {}
 
 HttpRequest &HttpRequest::operator=(const HttpRequest &other) {
   this->url_ = other.url_;
   this->result_ = other.result_;
+  this->content_type_ = other.content_type_;
   this->accept_header_ = other.accept_header_;
   this->status_code_ = other.status_code_;
+  this->error_ = other.error_;
+  this->unix_socket_ = other.unix_socket_;
+  this->session_ = other.session_;
+  this->timing_ = other.timing_;
   return *this;
 }
 
 HttpRequest &HttpRequest::operator=(HttpRequest &&other) {
   this->url_ = std::move(other.url_);
   this->result_ = std::move(other.result_);
+  this->content_type_ = std::move(other.content_type_);
   this->accept_header_ = std::move(other.accept_header_);
   this->status_code_ = std::move(other.status_code_);
+  this->error_ = std::move(other.error_);
+  this->unix_socket_ = std::move(other.unix_socket_);
+  this->session_ = other.session_;
+  this->timing_ = other.timing_;
   return *this;
 }
 
@@ -78,11 +239,28 @@ bool HttpRequest::operator!=(const HttpRequest &other) { return !(*this == other
 
 std::string HttpRequest::result() const noexcept { return this->result_; }
 
+std::string HttpRequest::content_type() const noexcept { return this->content_type_; }
+
 int HttpRequest::status_code() const noexcept { return this->status_code_; }
 
 std::string HttpRequest::url() const noexcept { return this->url_; }
 
 std::string HttpRequest::accept_header() const noexcept { return this->accept_header_; }
+
+HttpTiming HttpRequest::timing() const noexcept { return this->timing_; }
+
+std::string HttpRequest::error() const noexcept { return this->error_; }
+
+std::string HttpRequest::operator()() {
+  perform_first({this}, 0);
+  return this->result_;
+}
+
+void HttpRequest::session(HttpSession *session) noexcept { this->session_ = session; }
+
+std::string HttpRequest::unix_socket() const noexcept { return this->unix_socket_; }
+
+void HttpRequest::unix_socket(const std::string &path) { this->unix_socket_ = path; }
 }  // client
 }  // translate
 }  // lgeorgieff
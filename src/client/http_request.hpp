@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/06/2015
+// Last modified: 10/19/2026
 // Description: Declares the base class for an HTTP request to the translation service.
 // ====================================================================================================================
 
@@ -19,17 +19,35 @@
 #ifndef HTTP_REQUEST_HPP_
 #define HTTP_REQUEST_HPP_
 
+#include "http_session.hpp"
+
 #include <curl/curl.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace lgeorgieff {
 namespace translate {
 namespace client {
+// The phases of a completed HTTP request as reported by curl. All times are in microseconds since the start of the
+// request, i.e. first_byte includes connect, which includes name_lookup.
+struct HttpTiming {
+  int64_t name_lookup;
+  int64_t connect;
+  // The end of the TLS handshake or 0 for plain HTTP
+  int64_t tls_handshake;
+  int64_t first_byte;
+  int64_t total;
+  int64_t bytes_down;
+};
+
 class HttpRequest {
  public:
   static const std::string DEFAULT_ACCEPT_HEADER;
+  // The time in seconds to wait for the connection to the service, afterwards an HttpException is thrown
+  static const long CONNECT_TIMEOUT;
 
   // === Constructors, destructor, operators ==========================================================================
   // The base constructor that takes the HTTP request's URL and optionally the accept header.
@@ -41,12 +59,14 @@ class HttpRequest {
   HttpRequest& operator=(HttpRequest&&);
   bool operator==(const HttpRequest&);
   bool operator!=(const HttpRequest&);
-  // The actual method that handles the curl HTTP request and must be implemented in each derived class.
+  // Performs the request and returns the result. The options of the request are set by each derived class.
   // This method may throw a lgeorgieff::translate::utils::HttpException
-  virtual std::string operator()() = 0;
+  std::string operator()();
 
   // A getter for the HTTP result as string value
   std::string result() const noexcept;
+  // A getter for the content-type header of the HTTP result, it is empty if the service did not send one
+  std::string content_type() const noexcept;
   // A getter for the HTTP status code.
   // If no HTTP request was completed so far, the return value is -1
   int status_code() const noexcept;
@@ -54,6 +74,26 @@ class HttpRequest {
   std::string url() const noexcept;
   // A getter for the accept header
   std::string accept_header() const noexcept;
+  // A getter for the timing of the last completed request, all values are 0 before
+  HttpTiming timing() const noexcept;
+  // A getter for the reason why the last request failed, it is empty if the request did not fail
+  std::string error() const noexcept;
+  // Lets the request use the passed session, so the connections of previous requests are reused.
+  // The session must outlive the request, nullptr restores a session of its own for each request.
+  void session(HttpSession*) noexcept;
+  // A getter for the path of the Unix domain socket the request is sent through, it is empty for TCP
+  std::string unix_socket() const noexcept;
+  // Sends the request through the Unix domain socket of the passed path instead of TCP, e.g. to a trlt.service on the
+  // same host. The host of the URL is only used for the Host header then. An empty path restores TCP.
+  void unix_socket(const std::string&);
+
+  // Performs the passed requests, e.g. the same request to several endpoints, and returns the first request that was
+  // answered. The first request is started immediately, each further request is started after the passed delay in
+  // milliseconds if none of the running requests was answered so far. If the delay is not positive, a further request
+  // is only started after all running requests failed. A request fails if it cannot be completed or if it is answered
+  // with a server error while another request may still succeed. The remaining requests are cancelled.
+  // All requests use the session of the first request. If all requests fail, an HttpException is thrown.
+  static HttpRequest& perform_first(const std::vector<HttpRequest*>&, long);
 
   // A helper for initializing curl
   static CURLcode init_curl();
@@ -63,8 +103,22 @@ class HttpRequest {
  protected:
   std::string url_;
   std::string result_;
+  std::string content_type_;
   std::string accept_header_;
   int status_code_;
+  std::string error_;
+  std::string unix_socket_;
+  HttpSession* session_;
+  HttpTiming timing_;
+  // Sets the options of this request on the passed handle and returns the list of its headers, which is freed after
+  // the request. Derived classes set their options and headers in addition to the ones of setup_request_.
+  virtual curl_slist* setup_(CURL*) = 0;
+  // Sets the options that are common to all requests, i.e. URL, Unix domain socket, accept header, connect timeout and
+  // the callback, and returns the list of headers
+  curl_slist* setup_request_(CURL*);
+  // Reads the status code, the content-type and the timing of the request from the passed handle, which was completed
+  // with the passed code. If the request failed, the error is set.
+  void complete_(CURL*, CURLcode);
   // The callback function that is called by curl during the HTTP request
   static size_t curl_write_(void*, size_t, size_t, void*);
 };  // HttpRequest
@@ -0,0 +1,49 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements a curl multi handle that is shared by several HTTP requests to reuse the connections.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if/ not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+
+#include "http_session.hpp"
+#include "utils/http_exception.hpp"
+
+#include <utility>
+
+namespace lgeorgieff {
+namespace translate {
+namespace client {
+
+using lgeorgieff::translate::utils::HttpException;
+
+HttpSession::HttpSession() : handle_{curl_multi_init()} {
+  if (!this->handle_) throw HttpException{"Failed to create a curl multi handle for the HTTP session"};
+}
+
+HttpSession::HttpSession(HttpSession &&other) : handle_{other.handle_} { other.handle_ = nullptr; }
+
+HttpSession::~HttpSession() {
+  if (this->handle_) curl_multi_cleanup(this->handle_);
+}
+
+HttpSession &HttpSession::operator=(HttpSession &&other) {
+  std::swap(this->handle_, other.handle_);
+  return *this;
+}
+
+CURLM *HttpSession::handle() noexcept { return this->handle_; }
+}  // client
+}  // translate
+}  // lgeorgieff
@@ -0,0 +1,51 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares a curl multi handle that is shared by several HTTP requests to reuse the connections.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if/ not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+
+#ifndef HTTP_SESSION_HPP_
+#define HTTP_SESSION_HPP_
+
+#include <curl/curl.h>
+
+namespace lgeorgieff {
+namespace translate {
+namespace client {
+// Owns the curl multi handle that performs all requests of the session. curl keeps the connections to the servers in
+// the cache of the multi handle alive between the requests, so each further request only costs one round trip.
+class HttpSession {
+ public:
+  // === Constructors, destructor, operators ==========================================================================
+  // May throw a lgeorgieff::translate::utils::HttpException if curl cannot create a multi handle.
+  HttpSession();
+  HttpSession(const HttpSession &) = delete;
+  HttpSession(HttpSession &&);
+  ~HttpSession();
+  HttpSession &operator=(const HttpSession &) = delete;
+  HttpSession &operator=(HttpSession &&);
+
+  // Returns the multi handle. Requests that are added to it share its connection cache.
+  CURLM *handle() noexcept;
+
+ private:
+  CURLM *handle_;
+};  // HttpSession
+}  // client
+}  // translate
+}  // lgeorgieff
+
+#endif  // HTTP_SESSION_HPP_
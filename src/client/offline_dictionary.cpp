@@ -0,0 +1,129 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements the lookup of translations in the local binary dictionaries if the service is not used.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if/ not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+
+#include "offline_dictionary.hpp"
+#include "utils/exception.hpp"
+#include "utils/gender.hpp"
+#include "utils/numerus.hpp"
+#include "utils/word_class.hpp"
+
+#include <unistd.h>
+
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace {
+// Appends the passed values to the json array with the passed name of the passed object, values that are contained
+// already are skipped.
+void merge_into_array(Json::Value &json_object, const std::string &array_name, const std::vector<std::string> &values) {
+  for (const std::string &value : values) {
+    bool contained{false};
+    if (json_object.isMember(array_name)) {
+      for (const Json::Value &item : json_object[array_name]) contained = contained || value == item.asString();
+    }
+    if (!contained) json_object[array_name].append(value);
+  }
+}
+
+// Returns true if both passed items have the same phrase, word class, gender and numerus.
+bool same_phrase(const Json::Value &lft, const Json::Value &rgt) {
+  for (const char *member_name : {"phrase", "word_class", "gender", "numerus"}) {
+    if (lft.get(member_name, Json::Value{}) != rgt.get(member_name, Json::Value{})) return false;
+  }
+  return true;
+}
+
+// Returns the boolean member with the passed name of the passed options or true, as the service does.
+bool get_option(const Json::Value &options, const std::string &member_name) {
+  return !options.isObject() || !options[member_name].isBool() || options[member_name].asBool();
+}
+}  // anonymous namespace
+
+namespace lgeorgieff {
+namespace translate {
+namespace client {
+
+using lgeorgieff::translate::utils::BinaryDictionary;
+using lgeorgieff::translate::utils::DictionaryEntry;
+using lgeorgieff::translate::utils::DictionaryPhrase;
+using lgeorgieff::translate::utils::Exception;
+
+OfflineDictionary::OfflineDictionary(const std::string &folder) : folder_{folder}, dictionaries_{} {}
+
+bool OfflineDictionary::available(const std::string &language_in, const std::string &language_out) const {
+  return !access(this->path(language_in, language_out).c_str(), R_OK);
+}
+
+std::string OfflineDictionary::operator()(const std::string &phrase, const std::string &language_in,
+                                          const std::string &language_out, const Json::Value &options) {
+  const std::string dictionary_path{this->path(language_in, language_out)};
+  if (!this->available(language_in, language_out))
+    throw Exception{"There is no dictionary \"" + dictionary_path + "\" for the offline mode!"};
+  auto dictionary = this->dictionaries_.find(dictionary_path);
+  if (this->dictionaries_.end() == dictionary)
+    dictionary = this->dictionaries_.emplace(dictionary_path, BinaryDictionary{dictionary_path}).first;
+
+  const bool show_phrase{get_option(options, "show_phrase")}, show_word_class{get_option(options, "show_word_class")},
+      show_gender{get_option(options, "show_gender")}, show_numerus{get_option(options, "show_numerus")},
+      show_abbreviation{get_option(options, "show_abbreviation")}, show_comment{get_option(options, "show_comment")};
+
+  // The items are merged like the rows of a data base result by the service, i.e. one item per phrase, word class,
+  // gender and numerus with all their abbreviations and comments.
+  Json::Value result{Json::arrayValue};
+  for (const DictionaryEntry &entry : dictionary->second.lookup(phrase)) {
+    for (const DictionaryPhrase &phrase_out : entry.phrases_out) {
+      Json::Value item{Json::objectValue};
+      if (show_phrase && !phrase_out.phrase.empty()) item["phrase"] = phrase_out.phrase;
+      if (show_word_class && !utils::to_string(phrase_out.word_class).empty())
+        item["word_class"] = utils::to_string(phrase_out.word_class);
+      if (show_gender && !utils::to_string(phrase_out.gender).empty())
+        item["gender"] = utils::to_string(phrase_out.gender);
+      if (show_numerus && !utils::to_string(phrase_out.numerus).empty())
+        item["numerus"] = utils::to_string(phrase_out.numerus);
+
+      Json::Value *basic_item{nullptr};
+      for (Json::Value &result_item : result) {
+        if (same_phrase(item, result_item)) {
+          basic_item = &result_item;
+          break;
+        }
+      }
+      if (!basic_item) {
+        result.append(item);
+        basic_item = &result[result.size() - 1];
+      }
+      if (show_abbreviation) merge_into_array(*basic_item, "abbreviations", phrase_out.abbreviations);
+      if (show_comment) merge_into_array(*basic_item, "comments", phrase_out.comments);
+    }
+  }
+
+  Json::StreamWriterBuilder json_writer;
+  json_writer.settings_["indentation"] = "";
+  return Json::writeString(json_writer, result);
+}
+
+std::string OfflineDictionary::path(const std::string &language_in, const std::string &language_out) const {
+  std::string result{this->folder_};
+  if (!result.empty() && '/' != result[result.size() - 1]) result += '/';
+  return result + language_in + "-" + language_out + ".bin";
+}
+}  // client
+}  // translate
+}  // lgeorgieff
@@ -0,0 +1,67 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares the lookup of translations in the local binary dictionaries if the service is not used.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if/ not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+
+#ifndef OFFLINE_DICTIONARY_HPP_
+#define OFFLINE_DICTIONARY_HPP_
+
+#include "utils/binary_dictionary.hpp"
+
+#include <json/json.h>
+
+#include <map>
+#include <string>
+
+namespace lgeorgieff {
+namespace translate {
+namespace client {
+// Answers translation requests from the binary dictionaries of dict2bin in a local folder. The dictionary of the
+// languages DE and EN is the file <folder>/DE-EN.bin. Each dictionary is mapped into memory once and kept for all
+// further lookups.
+class OfflineDictionary {
+ public:
+  // === Constructors, destructor, operators ==========================================================================
+  // Takes the folder of the dictionary files.
+  explicit OfflineDictionary(const std::string &);
+  OfflineDictionary(const OfflineDictionary &) = delete;
+  OfflineDictionary(OfflineDictionary &&) = default;
+  ~OfflineDictionary() = default;
+  OfflineDictionary &operator=(const OfflineDictionary &) = delete;
+  OfflineDictionary &operator=(OfflineDictionary &&) = default;
+
+  // Returns true if there is a dictionary for the passed language in and language out.
+  bool available(const std::string &, const std::string &) const;
+  // Returns the translations of the passed phrase from the passed language in into the passed language out in the
+  // json format of the service's translation requests. The passed options are the POST data of the translation
+  // request, i.e. show_phrase, show_word_class, etc. An lgeorgieff::translate::utils::Exception is thrown if there is
+  // no valid dictionary for the languages.
+  std::string operator()(const std::string &, const std::string &, const std::string &, const Json::Value &);
+
+ private:
+  // Returns the path of the dictionary file for the passed language in and language out.
+  std::string path(const std::string &, const std::string &) const;
+
+  std::string folder_;
+  // The opened dictionaries by their path
+  std::map<std::string, utils::BinaryDictionary> dictionaries_;
+};  // OfflineDictionary
+}  // client
+}  // translate
+}  // lgeorgieff
+
+#endif  // OFFLINE_DICTIONARY_HPP_
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/04/2015
+// Last modified: 10/19/2026
 // Description: Implements the class ResultWriter which provides functionality that writes the translation results
 //              (json strings) into a stream in a pretty format.
 // ====================================================================================================================
@@ -23,38 +23,236 @@
 
 #include "json/json.h"
 
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <sstream>
+#include <string>
 #include <utility>
-#include <map>
-#include <set>
+#include <vector>
 
 namespace {
-// Returns a json value the is the pared result of the give json string.
-Json::Value from_json_string(const std::string json_string) {
-  Json::Reader reader;
-  Json::Value root;
-  if (!reader.parse(json_string, root))
-    throw lgeorgieff::translate::utils::JsonException{"The json data " + json_string + " cannot be parsed!"};
-  return root;
+using lgeorgieff::translate::utils::JsonException;
+
+// A pull parser that reads the values of a json string in their order of occurrence without building a tree of
+// Json::Value objects. String values are decoded directly into a buffer of the caller.
+class JsonScanner {
+ public:
+  explicit JsonScanner(const std::string &json_string) : json_string_(json_string), pos_{0} {}
+
+  // Returns the next character that is not a whitespace without consuming it, '\0' at the end of the json string.
+  char peek() {
+    while (this->pos_ != this->json_string_.size() && std::isspace(static_cast<unsigned char>(this->current())))
+      ++this->pos_;
+    return this->pos_ == this->json_string_.size() ? '\0' : this->current();
+  }
+
+  // Consumes the passed character and returns true if it is the next one.
+  bool consume(char expected) {
+    if (this->peek() != expected) return false;
+    ++this->pos_;
+    return true;
+  }
+
+  // Consumes the passed character or throws a JsonException.
+  void expect(char expected) {
+    if (!this->consume(expected)) this->fail();
+  }
+
+  // Consumes the literal null and returns true if it is the next value.
+  bool consume_null() {
+    if (this->peek() != 'n' || this->json_string_.compare(this->pos_, 4, "null")) return false;
+    this->pos_ += 4;
+    return true;
+  }
+
+  // Throws a JsonException if anything but whitespaces is left.
+  void expect_end() {
+    if (this->peek() != '\0') this->fail();
+  }
+
+  // Reads a string value and appends it decoded to the passed buffer.
+  void read_string(std::string &destination) {
+    this->expect('"');
+    while (true) {
+      if (this->pos_ == this->json_string_.size()) this->fail();
+      char chr{this->json_string_[this->pos_++]};
+      if ('"' == chr) return;
+      if ('\\' != chr) {
+        destination += chr;
+        continue;
+      }
+      if (this->pos_ == this->json_string_.size()) this->fail();
+      switch (this->json_string_[this->pos_++]) {
+        case '"': destination += '"'; break;
+        case '\\': destination += '\\'; break;
+        case '/': destination += '/'; break;
+        case 'b': destination += '\b'; break;
+        case 'f': destination += '\f'; break;
+        case 'n': destination += '\n'; break;
+        case 'r': destination += '\r'; break;
+        case 't': destination += '\t'; break;
+        case 'u': this->read_code_point(destination); break;
+        default: this->fail();
+      }
+    }
+  }
+
+  // Skips the next value of any type.
+  void skip_value() {
+    char next{this->peek()};
+    if ('"' == next) {
+      this->skip_string();
+    } else if ('[' == next || '{' == next) {
+      // strings are skipped as a whole, so each bracket outside of a string changes the depth
+      size_t depth{0};
+      do {
+        next = this->peek();
+        if ('"' == next) {
+          this->skip_string();
+          continue;
+        }
+        if ('\0' == next) this->fail();
+        if ('[' == next || '{' == next) ++depth;
+        if (']' == next || '}' == next) --depth;
+        ++this->pos_;
+      } while (depth);
+    } else {
+      // numbers, true, false and null
+      size_t start{this->pos_};
+      while (this->pos_ != this->json_string_.size() &&
+             (std::isalnum(static_cast<unsigned char>(this->current())) || '+' == this->current() ||
+              '-' == this->current() || '.' == this->current()))
+        ++this->pos_;
+      if (start == this->pos_) this->fail();
+    }
+  }
+
+  // Throws a JsonException for an unexpected value, the passed type describes the expected one.
+  [[noreturn]] void fail_type(const std::string &expected_type) const {
+    Json::Value root;
+    if (!parse_json(this->json_string_, root)) this->fail();
+    throw JsonException{"Cannot process the json data " + this->json_string_ + ". Expected a json " + expected_type +
+                        "!"};
+  }
+
+  // Throws a JsonException for the unexpected value at the current position. Like fail_type, but the message only
+  // contains the styled value instead of the whole json string.
+  [[noreturn]] void fail_value_type(const std::string &expected_type) {
+    this->peek();
+    const size_t start{this->pos_};
+    this->skip_value();
+    this->fail_value_type(expected_type, this->json_string_.substr(start, this->pos_ - start));
+  }
+
+  // Throws a JsonException for the passed unexpected value, e.g. "null" for a missing member.
+  [[noreturn]] void fail_value_type(const std::string &expected_type, const std::string &value) const {
+    // Like in fail_type, errors in the syntax of the whole json string are reported first
+    Json::Value styled_value;
+    if (!parse_json(this->json_string_, styled_value) || !parse_json(value, styled_value)) this->fail();
+    throw JsonException{"Cannot process the json data " + styled_value.toStyledString() + ". Expected a json " +
+                        expected_type + "!"};
+  }
+
+  // Reads the next value of any type and returns it converted by Json::Value::asString, e.g. "1" for a number.
+  std::string read_as_string() {
+    this->peek();
+    const size_t start{this->pos_};
+    this->skip_value();
+    Json::Value value;
+    if (!parse_json(this->json_string_.substr(start, this->pos_ - start), value)) this->fail();
+    return value.asString();
+  }
+
+ private:
+  char current() const { return this->json_string_[this->pos_]; }
+
+  static bool parse_json(const std::string &json_string, Json::Value &root) {
+    std::unique_ptr<Json::CharReader> reader{Json::CharReaderBuilder{}.newCharReader()};
+    return reader->parse(json_string.data(), json_string.data() + json_string.size(), &root, nullptr);
+  }
+
+  [[noreturn]] void fail() const {
+    throw JsonException{"The json data " + this->json_string_ + " cannot be parsed!"};
+  }
+
+  void skip_string() {
+    this->expect('"');
+    while (this->pos_ != this->json_string_.size() && '"' != this->current())
+      this->pos_ += '\\' == this->current() ? 2 : 1;
+    if (this->pos_ >= this->json_string_.size()) this->fail();
+    ++this->pos_;
+  }
+
+  // Reads the 4 hex digits of a \\u escape sequence, including the low surrogate that may follow, and appends the
+  // code point UTF-8 encoded.
+  void read_code_point(std::string &destination) {
+    char32_t code_point{this->read_hex()};
+    if (0xD800 <= code_point && 0xDBFF >= code_point) {
+      if (this->json_string_.compare(this->pos_, 2, "\\u")) this->fail();
+      this->pos_ += 2;
+      char32_t low_surrogate{this->read_hex()};
+      if (0xDC00 > low_surrogate || 0xDFFF < low_surrogate) this->fail();
+      code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low_surrogate - 0xDC00);
+    }
+    destination += lgeorgieff::translate::utils::u32string_to_utf8(std::u32string(1, code_point));
+  }
+
+  char32_t read_hex() {
+    if (this->pos_ + 4 > this->json_string_.size()) this->fail();
+    char32_t value{0};
+    for (size_t end{this->pos_ + 4}; this->pos_ != end; ++this->pos_) {
+      char chr{this->current()};
+      value <<= 4;
+      if ('0' <= chr && '9' >= chr)
+        value |= chr - '0';
+      else if ('a' <= (chr | 0x20) && 'f' >= (chr | 0x20))
+        value |= (chr | 0x20) - 'a' + 10;
+      else
+        this->fail();
+    }
+    return value;
+  }
+
+  const std::string &json_string_;
+  size_t pos_;
+};  // JsonScanner
+
+// A helper function that reads a string value or null into the passed destination. null results in an empty string.
+void read_string_or_null(JsonScanner &scanner, std::string &destination) {
+  destination.clear();
+  if (scanner.consume_null()) return;
+  if ('"' != scanner.peek()) scanner.fail_value_type("string");
+  scanner.read_string(destination);
+}
+
+// A helper function that reads an array of strings or null into the passed destination, which is sorted and contains
+// each string once. null values in the array are skipped.
+void read_string_set(JsonScanner &scanner, std::vector<std::string> &destination) {
+  destination.clear();
+  if (scanner.consume_null()) return;
+  if ('[' != scanner.peek()) scanner.fail_value_type("array");
+  scanner.expect('[');
+  if (!scanner.consume(']')) {
+    do {
+      if (scanner.consume_null()) continue;
+      if ('"' != scanner.peek()) scanner.fail_value_type("string");
+      destination.emplace_back();
+      scanner.read_string(destination.back());
+    } while (scanner.consume(','));
+    scanner.expect(']');
+  }
+  std::sort(destination.begin(), destination.end());
+  destination.erase(std::unique(destination.begin(), destination.end()), destination.end());
 }
 
 // A helper function that writes the passed item into the ostream target.
 // The written string is checked for length and adapted to the defined max_length.
-void write_item_to_stream(const std::string& data, size_t max_length, size_t tab_space, std::ostream* destination,
-                          bool is_last_item) {
-  size_t local_tab_space;
-  size_t local_max_length;
-  if (is_last_item) {
-    local_tab_space = local_max_length = 0;
-  } else {
-    local_tab_space = tab_space;
-    local_max_length = max_length;
-  }
-  ssize_t padding;
-  if (local_max_length + local_tab_space < data.size())
-    padding = 0;
-  else
-    padding = local_max_length + local_tab_space - data.size();
-  *destination << data << std::string(padding < 0 ? 0 : padding, ' ');
+void write_item_to_stream(const char *data, size_t data_size, size_t max_length, size_t tab_space,
+                          std::ostream *destination, bool is_last_item) {
+  destination->write(data, data_size);
+  if (!is_last_item && max_length + tab_space > data_size)
+    *destination << std::string(max_length + tab_space - data_size, ' ');
 }
 }  // anonymous namespace
 
@@ -90,45 +288,65 @@ bool ResultWriter::operator!=(const ResultWriter& other) { return !(*this == oth
 
 void ResultWriter::write_json_array_string(const std::string& json_string,
                                            const std::vector<std::string>& object_members, bool write_headers) {
-  Json::Value data{from_json_string(json_string)};
-  if (data.isNull()) return;
-  if (!data.isArray()) throw JsonException{"Cannot process the json data " + json_string + ". Expected a json array!"};
-  // We just go through the data and check for completeness, validity and chek the max length of each member type.
+  JsonScanner scanner{json_string};
+  if (scanner.consume_null()) return scanner.expect_end();
+  if (!scanner.consume('[')) scanner.fail_type("array");
+  // All values are decoded into a single buffer in one pass, cells holds the start and end of each value row by row.
   // We don't write into the set ostream here until it is clear that all data is valid.
-  std::map<std::string, size_t> max_lengths;
-  for (const Json::Value& item : data) {
-    if (!item.isObject()) throw JsonException{"Cannot process the json data " + item.toStyledString() + ". Expected a json object!"};
-    for (const std::string member_name : object_members) {
-      if (!item.isMember(member_name) || !item[member_name].isString())
-        throw JsonException{"Cannot process the json data " + item[member_name].toStyledString() + ". Expected a json string!"};
-      if (max_lengths.end() == max_lengths.find(member_name) ||
-          max_lengths[member_name] < item[member_name].asString().size()) {
-        max_lengths[member_name] = item[member_name].asString().size();  // TODO: handle unicode string length
+  const size_t missing{std::string::npos};
+  std::string values, member_name;
+  std::vector<std::pair<size_t, size_t>> cells;
+  std::vector<size_t> max_lengths(object_members.size(), 0);
+  if (!scanner.consume(']')) {
+    do {
+      if ('{' != scanner.peek()) scanner.fail_value_type("object");
+      scanner.expect('{');
+      const size_t row{cells.size()};
+      cells.resize(row + object_members.size(), std::make_pair(missing, missing));
+      if (!scanner.consume('}')) {
+        do {
+          member_name.clear();
+          scanner.read_string(member_name);
+          scanner.expect(':');
+          auto member = std::find(object_members.begin(), object_members.end(), member_name);
+          if (object_members.end() == member) {
+            scanner.skip_value();
+            continue;
+          }
+          if ('"' != scanner.peek()) scanner.fail_value_type("string");
+          const size_t column{static_cast<size_t>(member - object_members.begin())}, start{values.size()};
+          scanner.read_string(values);
+          cells[row + column] = std::make_pair(start, values.size());
+          // TODO: handle unicode string length
+          max_lengths[column] = std::max(max_lengths[column], values.size() - start);
+        } while (scanner.consume(','));
+        scanner.expect('}');
       }
-    }
+      for (size_t column{0}; column != object_members.size(); ++column)
+        if (missing == cells[row + column].first) scanner.fail_value_type("string", "null");
+    } while (scanner.consume(','));
+    scanner.expect(']');
   }
+  scanner.expect_end();
 
   // Write the header line
   if (write_headers) {
-    for (const std::string& member_name : object_members)
-      if (max_lengths[member_name] < member_name.size()) max_lengths[member_name] = member_name.size();
-
     for (size_t member_pos{0}; member_pos != object_members.size(); ++member_pos) {
-      write_item_to_stream(lgeorgieff::translate::utils::to_upper_case(object_members[member_pos]),
-                           max_lengths[object_members[member_pos]], TAB_SPACE, this->destination_,
+      max_lengths[member_pos] = std::max(max_lengths[member_pos], object_members[member_pos].size());
+      std::string header{lgeorgieff::translate::utils::to_upper_case(object_members[member_pos])};
+      write_item_to_stream(header.data(), header.size(), max_lengths[member_pos], TAB_SPACE, this->destination_,
                            member_pos == object_members.size() - 1);
     }
     *(this->destination_) << std::endl;
   }
 
   // Write the data to its destination.
-  for (size_t array_pos{0}; array_pos != data.size(); ++array_pos) {
-    for (size_t member_pos{0}; member_pos != object_members.size(); ++member_pos) {
-      write_item_to_stream(data[static_cast<int>(array_pos)][object_members[member_pos]].asString(),
-                           max_lengths[object_members[member_pos]], TAB_SPACE, this->destination_,
-                           member_pos == object_members.size() - 1);
-    }
-    *(this->destination_) << std::endl;
+  for (size_t cell_pos{0}; cell_pos != cells.size(); ++cell_pos) {
+    const size_t member_pos{cell_pos % object_members.size()};
+    write_item_to_stream(values.data() + cells[cell_pos].first, cells[cell_pos].second - cells[cell_pos].first,
+                         max_lengths[member_pos], TAB_SPACE, this->destination_,
+                         member_pos == object_members.size() - 1);
+    if (member_pos == object_members.size() - 1) *(this->destination_) << std::endl;
   }
 }
 
@@ -145,19 +363,37 @@ void ResultWriter::write_genders(const std::string& genders) {
 }
 
 void ResultWriter::write_numeri(const std::string& numeri) {
-  Json::Value data{from_json_string(numeri)};
-  if (data.isNull()) return;
-  if (!data.isArray()) throw JsonException{"Cannot process the json data " + numeri + ". Expected a json array!"};
+  JsonScanner scanner{numeri};
+  if (scanner.consume_null()) return scanner.expect_end();
+  if (!scanner.consume('[')) scanner.fail_type("array");
+  std::vector<std::string> data;
+  if (!scanner.consume(']')) {
+    do {
+      // Like Json::Value::asString, numbers and booleans are accepted as well
+      const char next{scanner.peek()};
+      if ('"' == next || 'n' == next) {
+        data.emplace_back();
+        read_string_or_null(scanner, data.back());
+      } else {
+        data.push_back(scanner.read_as_string());
+      }
+    } while (scanner.consume(','));
+    scanner.expect(']');
+  }
+  scanner.expect_end();
 
   *(this->destination_) << "NUMERUS" << std::endl;
-  for (const Json::Value numerus : data) *(this->destination_) << numerus.asString() << std::endl;
+  for (const std::string& numerus : data) *(this->destination_) << numerus << std::endl;
 }
 
 void ResultWriter::write_json_string_string(const std::string& json_string) {
-  Json::Value data{from_json_string(json_string)};
-  if (data.isNull()) return;
-  if (!data.isString()) throw JsonException{"Cannot process the json data " + json_string + ". Expected a json string!"};
-  *(this->destination_) << data.asString() << std::endl;
+  JsonScanner scanner{json_string};
+  if (scanner.consume_null()) return scanner.expect_end();
+  if ('"' != scanner.peek()) scanner.fail_type("string");
+  std::string data;
+  scanner.read_string(data);
+  scanner.expect_end();
+  *(this->destination_) << data << std::endl;
 }
 
 void ResultWriter::write_language_id(const std::string& language_id) { this->write_json_string_string(language_id); }
@@ -176,25 +412,45 @@ void ResultWriter::write_word_class_name(const std::string& word_class_name) {
 
 void ResultWriter::write_json_object_string(const std::string& json_string,
                                             const std::vector<std::string>& member_names) {
-  Json::Value data{from_json_string(json_string)};
-  if (data.isNull()) return;
-  if (!data.isObject()) throw JsonException{"Cannot process the json data " + json_string + ". Expected a json object!"};
+  JsonScanner scanner{json_string};
+  if (scanner.consume_null()) return scanner.expect_end();
+  if (!scanner.consume('{')) scanner.fail_type("object");
+  std::vector<std::string> values(member_names.size());
+  std::vector<bool> found(member_names.size(), false);
+  std::string member_name;
+  if (!scanner.consume('}')) {
+    do {
+      member_name.clear();
+      scanner.read_string(member_name);
+      scanner.expect(':');
+      auto member = std::find(member_names.begin(), member_names.end(), member_name);
+      if (member_names.end() == member) {
+        scanner.skip_value();
+        continue;
+      }
+      if ('"' != scanner.peek()) scanner.fail_type("object containing only string members");
+      const size_t pos{static_cast<size_t>(member - member_names.begin())};
+      values[pos].clear();
+      scanner.read_string(values[pos]);
+      found[pos] = true;
+    } while (scanner.consume(','));
+    scanner.expect('}');
+  }
+  scanner.expect_end();
 
-  for(size_t i{0}; member_names.size() != i; ++i) {
-    if (!data.isMember(member_names[i])) {
+  for (size_t i{0}; member_names.size() != i; ++i) {
+    if (!found[i]) {
       throw JsonException{"Cannot process the json data " + json_string + ". Expected a the member \"" +
                           member_names[i] + "\"!"};
     }
-    if (!data[member_names[i]].isString()) {
-      throw JsonException{"Cannot process the json data " + json_string +
-                          ". Expected a json object containing only string members!"};
-    }
-    *(this->destination_) << member_names[i] << ": " << data[member_names[i]].asString();
+  }
+  for (size_t i{0}; member_names.size() != i; ++i) {
+    *(this->destination_) << member_names[i] << ": " << values[i];
     if (member_names.size() - 1 > i) *(this->destination_) << ", ";
     else *(this->destination_) << std::endl;
   }
 }
-  
+
 void ResultWriter::write_gender_id(const std::string& gender_id) {
   this->write_json_object_string(gender_id, {"id", "description"});
 }
@@ -210,96 +466,84 @@ void ResultWriter::write_translation(const std::string& translation) {
   // [<COMMENT-N>]
   // <PHRASE> {<WORD_CLASS>} {<GENDER>} {<NUMERUS>} <<ABREVIATION-1>, <...>, <ABBREVIATION-N>> [<COMMENT-1>] [<...>]
   // [<COMMENT-N>]
-  Json::Value data{from_json_string(translation)};
-  if (data.isNull()) return;
-  if (!data.isArray()) throw JsonException{"Cannot process the json data " + translation + ". Expected a json array!"};
-
-  for (const Json::Value& item : data) {
-    if (item.isNull()) continue;
-    if (!item.isObject())
-      throw JsonException{"Cannot process the json data " + item.toStyledString() + ". Expected a json object!"};
-    std::string phrase;
-    if (item.isMember("phrase") && !item["phrase"].isNull()) {
-      if (!item["phrase"].isString()) {
-        throw JsonException{"Cannot process the json data " + item["phrase"].toStyledString() +
-                            ". Expected a json string!"};
-      }
-      phrase = item["phrase"].asString();
-    }
-    std::string word_class;
-    if (item.isMember("word_class") && !item["word_class"].isNull()) {
-      if (!item["word_class"].isString()) throw JsonException{"Cannot process the json data " + item["word_class"].toStyledString() + ". Expected a json string!"};
-      word_class = item["word_class"].asString();
-    }
-    std::string gender;
-    if (item.isMember("gender") && !item["gender"].isNull()) {
-      if (!item["gender"].isString()) throw JsonException{"Cannot process the json data " + item["gender"].toStyledString() + ". Expected a json string!"};
-      gender = item["gender"].asString();
-    }
-    std::string numerus;
-    if (item.isMember("numerus") && !item["numerus"].isNull()) {
-      if (!item["numerus"].isString()) throw JsonException{"Cannot process the json data " + item["numerus"].toStyledString() + ". Expected a json string!"};
-      numerus = item["numerus"].asString();
-    }
-    std::set<std::string> abbreviations;
-    if (item.isMember("abbreviations") && !item["abbreviations"].isNull()) {
-      if (!item["abbreviations"].isArray()) throw JsonException{"Cannot process the json data " + item["abbreviations"].toStyledString() + ". Expected a json array!"};
-      for (const Json::Value& abbreviation : item["abbreviations"]) {
-        if (abbreviation.isNull()) continue;
-        if (!abbreviation.isString()) throw JsonException{"Cannot process the json data " + abbreviation.toStyledString() + ". Expected a json string!"};
-        abbreviations.insert(abbreviation.asString());
-      }
-    }
-    std::set<std::string> comments;
-    if (item.isMember("comments") && !item["comments"].isNull()) {
-      if (!item["comments"].isArray()) {
-        throw JsonException{"Cannot process the json data " + item["comments"].toStyledString() +
-                            ". Expected a json array!"};
-      }
-      for (const Json::Value& comment : item["comments"]) {
-        if (comment.isNull()) continue;
-        if (!comment.isString()) throw JsonException{"Cannot process the json data " + comment.toStyledString() + ". Expected a json string!"};
-        comments.insert(comment.asString());
-      }
+  // The items are written into a buffer while they are read, the member values are reused for all items. Nothing is
+  // written into the set ostream until it is clear that all data is valid.
+  JsonScanner scanner{translation};
+  if (scanner.consume_null()) return scanner.expect_end();
+  if (!scanner.consume('[')) scanner.fail_type("array");
+  std::string member_name, phrase, word_class, gender, numerus;
+  std::vector<std::string> abbreviations, comments;
+  std::ostringstream output;
+  if (scanner.consume(']')) return scanner.expect_end();
+  do {
+    if (scanner.consume_null()) continue;
+    if ('{' != scanner.peek()) scanner.fail_value_type("object");
+    scanner.expect('{');
+    phrase.clear();
+    word_class.clear();
+    gender.clear();
+    numerus.clear();
+    abbreviations.clear();
+    comments.clear();
+    if (!scanner.consume('}')) {
+      do {
+        member_name.clear();
+        scanner.read_string(member_name);
+        scanner.expect(':');
+        if ("phrase" == member_name)
+          read_string_or_null(scanner, phrase);
+        else if ("word_class" == member_name)
+          read_string_or_null(scanner, word_class);
+        else if ("gender" == member_name)
+          read_string_or_null(scanner, gender);
+        else if ("numerus" == member_name)
+          read_string_or_null(scanner, numerus);
+        else if ("abbreviations" == member_name)
+          read_string_set(scanner, abbreviations);
+        else if ("comments" == member_name)
+          read_string_set(scanner, comments);
+        else
+          scanner.skip_value();
+      } while (scanner.consume(','));
+      scanner.expect('}');
     }
 
     if (!phrase.empty()) {
-      *(this->destination_) << phrase;
+      output << phrase;
       if (!word_class.empty() || !gender.empty() || !numerus.empty() || !abbreviations.empty() || !comments.empty())
-        *(this->destination_) << " ";
+        output << " ";
     }
     if (!word_class.empty()) {
-      *(this->destination_) << "{" << word_class << "}";
+      output << "{" << word_class << "}";
       if (!gender.empty() || !numerus.empty() || !abbreviations.empty() || !comments.empty())
-        *(this->destination_) << " ";
+        output << " ";
     }
     if (!gender.empty()) {
-      *(this->destination_) << "{" << gender << "}";
-      if (!numerus.empty() || !abbreviations.empty() || !comments.empty()) *(this->destination_) << " ";
+      output << "{" << gender << "}";
+      if (!numerus.empty() || !abbreviations.empty() || !comments.empty()) output << " ";
     }
     if (!numerus.empty()) {
-      *(this->destination_) << "{" << numerus << "}";
-      if (!abbreviations.empty() || !comments.empty()) *(this->destination_) << " ";
+      output << "{" << numerus << "}";
+      if (!abbreviations.empty() || !comments.empty()) output << " ";
     }
     if (!abbreviations.empty()) {
-      std::set<std::string>::const_iterator end_iter{abbreviations.cend()};
-      std::set<std::string>::const_iterator before_end_iter{--abbreviations.cend()};
-      for (std::set<std::string>::const_iterator iter{abbreviations.cbegin()}; iter != end_iter; ++iter) {
-        *(this->destination_) << "<" << *iter << ">";
-        if (iter != before_end_iter) *(this->destination_) << " ";
+      for (size_t pos{0}; pos != abbreviations.size(); ++pos) {
+        output << "<" << abbreviations[pos] << ">";
+        if (pos != abbreviations.size() - 1) output << " ";
       }
-      if (!comments.empty()) *(this->destination_) << " ";
+      if (!comments.empty()) output << " ";
     }
     if (!comments.empty()) {
-      std::set<std::string>::const_iterator end_iter{comments.cend()};
-      std::set<std::string>::const_iterator before_end_iter{--comments.cend()};
-      for (std::set<std::string>::const_iterator iter{comments.cbegin()}; iter != end_iter; ++iter) {
-        *(this->destination_) << "[" << *iter << "]";
-        if (iter != before_end_iter) *(this->destination_) << " ";
+      for (size_t pos{0}; pos != comments.size(); ++pos) {
+        output << "[" << comments[pos] << "]";
+        if (pos != comments.size() - 1) output << " ";
       }
     }
-    *(this->destination_) << std::endl;
-  }  // for (const Json::Value& item : data)
+    output << std::endl;
+  } while (scanner.consume(','));
+  scanner.expect(']');
+  scanner.expect_end();
+  *(this->destination_) << output.str() << std::flush;
 }
 }  // client
 }  // translate
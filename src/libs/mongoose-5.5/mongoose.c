@@ -16,6 +16,10 @@
 // license, as set out in <http://cesanta.com/>.
 //
 // $Date: 2014-09-16 06:47:40 UTC $
+//
+// Local changes for trlt: listening addresses may be Unix domain sockets,
+// "unix://PATH". See ns_parse_address, ns_open_listening_socket, ns_bind and
+// ns_sock_to_str, and the sockaddr_un member of union socket_address.
 
 #ifdef NOEMBED_NET_SKELETON
 #include "net_skeleton.h"
@@ -123,6 +127,7 @@ typedef struct _stati64 ns_stat_t;
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <sys/select.h>
+#include <sys/un.h>
 #define closesocket(x) close(x)
 #define __cdecl
 #define INVALID_SOCKET (-1)
@@ -164,6 +169,9 @@ union socket_address {
 #else
   struct sockaddr sin6;
 #endif
+#ifndef _WIN32
+  struct sockaddr_un sun;
+#endif
 };
 
 // Describes chunk of memory
@@ -606,7 +614,7 @@ int ns_resolve(const char *host, char *buf, size_t n) {
   return ns_resolve2(host, &ad) ? snprintf(buf, n, "%s", inet_ntoa(ad)) : 0;
 }
 
-// Address format: [PROTO://][IP_ADDRESS:]PORT[:CERT][:CA_CERT]
+// Address format: [PROTO://][IP_ADDRESS:]PORT[:CERT][:CA_CERT] or unix://PATH
 static int ns_parse_address(const char *str, union socket_address *sa,
                             int *proto, int *use_ssl, char *cert, char *ca) {
   unsigned int a, b, c, d, port;
@@ -626,6 +634,20 @@ static int ns_parse_address(const char *str, union socket_address *sa,
   *use_ssl = 0;
   cert[0] = ca[0] = '\0';
 
+#ifndef _WIN32
+  if (strncmp(str, "unix://", 7) == 0) {
+    // Unix domain socket, e.g. unix:///run/trlt.sock. The path ends at the
+    // next comma, since str may point into a list of listening ports.
+    str += 7;
+    len = (int) strcspn(str, ",");
+    sa->sun.sun_family = AF_UNIX;
+    if (len == 0 || len >= (int) sizeof(sa->sun.sun_path)) return 0;
+    memcpy(sa->sun.sun_path, str, len);
+    sa->sun.sun_path[len] = '\0';
+    return len;
+  }
+#endif
+
   if (memcmp(str, "ssl://", 6) == 0) {
     str += 6;
     *use_ssl = 1;
@@ -667,6 +689,9 @@ static int ns_parse_address(const char *str, union socket_address *sa,
 static sock_t ns_open_listening_socket(union socket_address *sa, int proto) {
   socklen_t sa_len = (sa->sa.sa_family == AF_INET) ?
     sizeof(sa->sin) : sizeof(sa->sin6);
+#ifndef _WIN32
+  if (sa->sa.sa_family == AF_UNIX) sa_len = sizeof(sa->sun);
+#endif
   sock_t sock = INVALID_SOCKET;
 #ifndef _WIN32
   int on = 1;
@@ -733,7 +758,8 @@ struct ns_connection *ns_bind(struct ns_mgr *srv, const char *str,
   char cert[100], ca_cert[100];
   sock_t sock;
 
-  ns_parse_address(str, &sa, &proto, &use_ssl, cert, ca_cert);
+  if (ns_parse_address(str, &sa, &proto, &use_ssl, cert, ca_cert) == 0 &&
+      sa.sa.sa_family != AF_INET) return NULL;
   if (use_ssl && cert[0] == '\0') return NULL;
 
   if ((sock = ns_open_listening_socket(&sa, proto)) == INVALID_SOCKET) {
@@ -817,6 +843,13 @@ void ns_sock_to_str(sock_t sock, char *buf, size_t len, int flags) {
     } else {
       getsockname(sock, &sa.sa, &slen);
     }
+#ifndef _WIN32
+    if (sa.sa.sa_family == AF_UNIX) {
+      // A Unix domain socket has neither an IP address nor a port
+      if (!(flags & 1)) snprintf(buf, len, "unix://%s", sa.sun.sun_path);
+      return;
+    }
+#endif
     if (flags & 1) {
 #if defined(NS_ENABLE_IPV6)
       inet_ntop(sa.sa.sa_family, sa.sa.sa_family == AF_INET ?
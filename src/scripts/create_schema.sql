@@ -1,7 +1,7 @@
 /*
 #######################################################################################################################
 # Copyright (C) 2015  Lukas Georgieff
-# Last modified: 05/11/2015
+# Last modified: 10/19/2026
 # Description: Creates the (postgresql) SQL data base schema for the server side of translate.
 #              Usage: psql --username translate --dbname translate --file create_schema.sql
 #######################################################################################################################
@@ -99,6 +99,65 @@ phrase_id_out integer REFERENCES phrase(id) NOT NULL,
 unique(phrase_id_in, phrase_id_out)
 );
 
+/*
+#######################################################################################################################
+### The denormalized translation lookup table, it holds one row per translation with pre-aggregated comments and
+### abbreviations of both phrases as json arrays. It is filled by the import from the view translation_lookup_source,
+### e.g. by "INSERT INTO translation_lookup SELECT * FROM translation_lookup_source;".
+#######################################################################################################################
+*/
+CREATE VIEW translation_lookup_source AS
+SELECT
+pt.phrase_id_in,
+pt.phrase_id_out,
+ph_in.language AS language_in,
+ph_out.language AS language_out,
+ph_in.phrase AS phrase_in,
+ph_in.word_class,
+ph_in.gender AS gender_in,
+ph_in.numerus AS numerus_in,
+array_to_json(ARRAY(SELECT ab.abbreviation FROM phrase_abbreviation pa
+                    JOIN abbreviation ab ON ab.id = pa.abbreviation_id
+                    WHERE pa.phrase_id = ph_in.id ORDER BY ab.abbreviation)) AS abbreviations_in,
+array_to_json(ARRAY(SELECT co.comment FROM phrase_comment pc JOIN comment co ON co.id = pc.comment_id
+                    WHERE pc.phrase_id = ph_in.id ORDER BY co.comment)) AS comments_in,
+ph_out.phrase AS phrase_out,
+ph_out.word_class AS word_class_out,
+ph_out.gender AS gender_out,
+ph_out.numerus AS numerus_out,
+array_to_json(ARRAY(SELECT ab.abbreviation FROM phrase_abbreviation pa
+                    JOIN abbreviation ab ON ab.id = pa.abbreviation_id
+                    WHERE pa.phrase_id = ph_out.id ORDER BY ab.abbreviation)) AS abbreviations_out,
+array_to_json(ARRAY(SELECT co.comment FROM phrase_comment pc JOIN comment co ON co.id = pc.comment_id
+                    WHERE pc.phrase_id = ph_out.id ORDER BY co.comment)) AS comments_out
+FROM phrase_translation pt
+JOIN phrase ph_in ON ph_in.id = pt.phrase_id_in
+JOIN phrase ph_out ON ph_out.id = pt.phrase_id_out;
+
+CREATE TABLE translation_lookup
+(
+phrase_id_in integer NOT NULL,
+phrase_id_out integer NOT NULL,
+language_in char(2) NOT NULL,
+language_out char(2) NOT NULL,
+phrase_in varchar(256) NOT NULL,
+word_class varchar(8),
+gender_in char(1),
+numerus_in numerus,
+abbreviations_in json NOT NULL,
+comments_in json NOT NULL,
+phrase_out varchar(256) NOT NULL,
+word_class_out varchar(8),
+gender_out char(1),
+numerus_out numerus,
+abbreviations_out json NOT NULL,
+comments_out json NOT NULL
+);
+
+CREATE INDEX translation_lookup_phrase_index ON translation_lookup (language_in, language_out, phrase_in, word_class);
+CREATE INDEX translation_lookup_phrase_id_in_index ON translation_lookup (phrase_id_in);
+CREATE INDEX translation_lookup_phrase_id_out_index ON translation_lookup (phrase_id_out);
+
 /*
 #######################################################################################################################
 ### Insert the basic values into all tables
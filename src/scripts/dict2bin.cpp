@@ -0,0 +1,125 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Compiles a language resource from dict.cc into the binary dictionary format, so it can be queried
+//              without a data base, e.g. by dictq.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "dict_parser.hpp"
+#include "utils/binary_dictionary.hpp"
+#include "utils/exception.hpp"
+#include "utils/word_class.hpp"
+
+#include <cstring>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::strcmp;
+
+using lgeorgieff::translate::scripts::LangItem;
+using lgeorgieff::translate::scripts::process_line;
+using lgeorgieff::translate::scripts::unescape_apostrophe;
+using lgeorgieff::translate::utils::BinaryDictionaryWriter;
+using lgeorgieff::translate::utils::DictionaryPhrase;
+using lgeorgieff::translate::utils::Exception;
+using lgeorgieff::translate::utils::WordClass;
+using lgeorgieff::translate::utils::from_string;
+
+bool STRICT_MODE = false;
+
+void print_usage(string self_name, std::ostream &destination) {
+  destination << endl;
+  destination << "usage: " << self_name << " --in lang_1 --out lang_2 [--strict-mode] < lang_1-lang_2.txt > "
+                                          "lang_1-lang_2.bin" << endl;
+  destination << endl;
+  destination << "--in | -i <language id 1>    Set the language identifier of the" << endl;
+  destination << "                             source language, e.g. EN, DE" << endl;
+  destination << "--out | -o <language id 2>   Set the language identifier of the" << endl;
+  destination << "                             target language, e.g. EN, DE" << endl;
+  destination << "--strict-mode | -s           Set the parser to strict mode, i.e." << endl;
+  destination << "                             every parser error causes a run" << endl;
+  destination << "                             to abort" << endl;
+  destination << "--help | -h                  Shows this dialog and exits this programme" << endl;
+}
+
+// Converts a parsed language item with the passed word class into a phrase of a binary dictionary.
+DictionaryPhrase to_dictionary_phrase(const LangItem &lang, WordClass word_class) {
+  DictionaryPhrase phrase{unescape_apostrophe(lang.phrase), lang.gender, lang.numerus, word_class, {}, {}};
+  for (const string &comment : lang.comments) phrase.comments.push_back(unescape_apostrophe(comment));
+  for (const string &abbreviation : lang.abbreviations)
+    phrase.abbreviations.push_back(unescape_apostrophe(abbreviation));
+  return phrase;
+}
+
+// The entry point for this programme
+int main(const int argc, const char **argv) {
+  string lang_id_1;
+  string lang_id_2;
+  try {
+    for (int pos{1}; argc > pos; ++pos) {
+      if ((!strcmp("--in", argv[pos]) || !strcmp("-i", argv[pos]))) {
+        if (argc - 1 != pos) lang_id_1 = argv[++pos];
+      } else if ((!strcmp("--out", argv[pos]) || !strcmp("-o", argv[pos]))) {
+        if (argc - 1 != pos) lang_id_2 = argv[++pos];
+      } else if (!strcmp("--strict-mode", argv[pos]) || !strcmp("-s", argv[pos])) {
+        STRICT_MODE = true;
+      } else if (!strcmp("--help", argv[pos]) || !strcmp("-h", argv[pos])) {
+        print_usage(argv[0], cout);
+        return 0;
+      } else {
+        cerr << "The option \"" << argv[pos] << "\" is unknown!" << endl;
+        cerr << "For more help run \"" << argv[0] << " -h\"" << endl;
+        return 2;
+      }
+    }
+    if (lang_id_1.empty() || lang_id_2.empty()) {
+      cerr << "The value for \"--in\" | \"-i\" and \"--out\" | \"-o\" must not be empty!" << endl;
+      cerr << "For more help run \"" << argv[0] << " -h\"" << endl;
+      return 1;
+    }
+
+    BinaryDictionaryWriter writer{lang_id_1, lang_id_2};
+    string line;
+    size_t line_counter{0};
+    LangItem lang_item_1, lang_item_2;
+    while (std::getline(std::cin, line)) {
+      if (!process_line(line, lang_id_1, lang_id_2, ++line_counter, STRICT_MODE, lang_item_1, lang_item_2)) continue;
+      // Each word class of a line results in a separate translation, equal to the rows dict2sql creates.
+      std::vector<WordClass> word_classes;
+      for (const string &word_class : lang_item_1.word_classes)
+        word_classes.push_back(from_string<WordClass>(word_class));
+      if (word_classes.empty()) word_classes.push_back(WordClass::none);
+      for (const WordClass &word_class : word_classes)
+        writer.add(to_dictionary_phrase(lang_item_1, word_class), to_dictionary_phrase(lang_item_2, word_class));
+    }
+
+    if (!std::cin.eof() || std::cin.bad()) {
+      cerr << "Failed to read from stdin!" << endl;
+      return 1;
+    }
+    writer.write(cout);
+  } catch (const Exception &err) {
+    cerr << "Encountered an exception \"" << err.what() << "\"" << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,384 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements the parser for language resource files from dict.cc and the SQL statement generators that
+//              are shared by dict2sql and trlt-import.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "dict_parser.hpp"
+#include "utils/word_class.hpp"
+#include "utils/helper.hpp"
+#include "utils/phrase_key.hpp"
+#include "utils/exception.hpp"
+
+#include <cctype>
+#include <cstddef>
+#include <iostream>
+#include <regex>
+#include <stack>
+#include <utility>
+
+namespace {
+using std::string;
+using std::cerr;
+using std::endl;
+using std::regex;
+using std::smatch;
+using std::regex_search;
+
+using lgeorgieff::translate::scripts::LangItem;
+using lgeorgieff::translate::scripts::strings;
+using lgeorgieff::translate::utils::Gender;
+using lgeorgieff::translate::utils::Numerus;
+using lgeorgieff::translate::utils::is_word_class;
+using lgeorgieff::translate::utils::trim;
+using lgeorgieff::translate::utils::normalize_whitespace;
+using lgeorgieff::translate::utils::to_phrase_key;
+using lgeorgieff::translate::utils::Exception;
+
+// Regular expressions for gender.
+const regex REGEX_GENDER_M{"\\{ *m *\\}"};
+const regex REGEX_GENDER_F{"\\{ *f *\\}"};
+const regex REGEX_GENDER_N{"\\{ *n *\\}"};
+
+// Regular expressions for numerus.
+const regex REGEX_NUMERUS_PL{"\\{ *pl\\.? *\\}"};
+const regex REGEX_NUMERUS_SG{"\\{ *sg\\.? *\\}"};
+
+// Regular expressions for abbreviations and comments
+const regex REGEX_ABBREVIATION{"\\<.*\\>"};
+const regex REGEX_COMMENT{"\\[.*\\]"};
+
+// Find and replace a regular epxression in string by another string.
+bool find_and_replace(string &str, const regex &find, const string &replacement) {
+  smatch m;
+  if (!regex_search(str, m, find)) return false;
+
+  for (const string &matched_part : m) str.replace(str.find(matched_part), matched_part.size(), replacement);
+  return true;
+}
+
+// Search for a gender part in a language entry. If one is found, the corresponding gender instance is returned and
+// the matched gender string is removed from the original string.
+Gender process_gender(string &entry) {
+  if (find_and_replace(entry, REGEX_GENDER_M, ""))
+    return Gender::m;
+  else if (find_and_replace(entry, REGEX_GENDER_F, ""))
+    return Gender::f;
+  else if (find_and_replace(entry, REGEX_GENDER_N, ""))
+    return Gender::n;
+  else
+    return Gender::none;
+}
+
+// Search for a numerus part in a language entry. If one is found, the corresponding numerus instance is returned and
+// the matched numerus string is removed from the original string.
+Numerus process_numerus(string &entry) {
+  if (find_and_replace(entry, REGEX_NUMERUS_PL, ""))
+    return Numerus::pl;
+  else if (find_and_replace(entry, REGEX_NUMERUS_SG, ""))
+    return Numerus::sg;
+  else
+    return Numerus::none;
+}
+
+// A compare function for a filtered comment string
+bool compare_match_items(const std::pair<size_t, string> &lft, const std::pair<size_t, string> &rgt) {
+  return lft.first <= rgt.first;
+}
+
+// Search for a closed substring in between a start and an end tag. The substring is found by the passed regular
+// expression. If one substring is found, the corresponding string value is returned and the matched substring is
+// removed from the original string.
+strings process_closed_substring(string &entry, const regex &main_rex, char opening_tag, char closing_tag,
+                                 size_t line_number, bool strict_mode) {
+  strings result;
+  smatch rex_match;
+  if (!regex_search(entry, rex_match, main_rex)) return result;
+  for (const string &comment : rex_match) {
+    entry.replace(entry.find(comment), comment.size(), "");
+    std::list<std::pair<size_t, string>> current_match_results;
+    std::stack<std::pair<size_t, string>> collector;
+    for (size_t pos{0}; pos != comment.size(); ++pos) {
+      if (closing_tag == comment[pos] && collector.empty()) {
+        // handle bad entry, one enclosing tag too much, e.g. ']'
+        if (strict_mode)
+          throw Exception{string{"Bad comment syntax, found a \"" + string{closing_tag} + "\" too much in line " +
+                                 std::to_string(line_number) + "!"}};
+        continue;
+      } else if (closing_tag == comment[pos]) {
+        normalize_whitespace(collector.top().second);
+        if (!collector.top().second.empty()) current_match_results.push_back(collector.top());
+        collector.pop();
+      } else if (opening_tag == comment[pos]) {
+        collector.push(std::pair<size_t, string>{pos, ""});
+      } else if (!collector.empty()) {
+        collector.top().second += comment[pos];
+      }
+    }
+    // handle bad entries, too less enclosing tags, e.g. "]"
+    if (!collector.empty() && strict_mode)
+      throw Exception{string{"Bad comment syntax, found a \"" + string{closing_tag} + "\" too few in line " +
+                             std::to_string(line_number) + "!"}};
+    while (!collector.empty()) {
+      normalize_whitespace(collector.top().second);
+      if (!collector.top().second.empty()) current_match_results.push_back(collector.top());
+      collector.pop();
+    }
+    current_match_results.sort(compare_match_items);
+    for (const std::pair<size_t, string> &item : current_match_results) result.push_back(item.second);
+  }
+  return result;
+}
+
+// Search for an abbreviation part in a language entry. If one is found, the corresponding string value is returned and
+// the matched abbreviation string is removed from the original string.
+strings process_abbreviations(string &entry, size_t line_number, bool strict_mode) {
+  return process_closed_substring(entry, REGEX_ABBREVIATION, '<', '>', line_number, strict_mode);
+}
+
+// Search for an comment part in a language entry. If one is found, the corresponding string value is returned and
+// the matched comment string is removed from the original string.
+strings process_comments(string &entry, size_t line_number, bool strict_mode) {
+  return process_closed_substring(entry, REGEX_COMMENT, '[', ']', line_number, strict_mode);
+}
+
+// Process a phrase entry, i.e. normalize whitespace.
+string process_phrase(string &entry) {
+  normalize_whitespace(entry);
+  return entry;
+}
+
+// Escapes the sinple apostrophe (') to ('').
+void escape_apostrophe(string &str) {
+  for (size_t pos{0}; pos < str.size(); ++pos) {
+    if (str[pos] == '\'') str.insert(pos++, "'");
+  }
+}
+
+// Process a lang item, i.e. all charactersitics of a language item.
+LangItem process_lang(string &entry, const strings &word_classes, const string &language, size_t line_number,
+                      bool strict_mode) {
+  LangItem item;
+  item.language = language;
+  item.word_classes = word_classes;
+  item.gender = process_gender(entry);
+  item.numerus = process_numerus(entry);
+  item.abbreviations = process_abbreviations(entry, line_number, strict_mode);
+  for (string &abbr : item.abbreviations) escape_apostrophe(abbr);
+  item.comments = process_comments(entry, line_number, strict_mode);
+  for (string &comment : item.comments) escape_apostrophe(comment);
+  item.phrase = process_phrase(entry);
+  escape_apostrophe(item.phrase);
+  return item;
+}
+
+// Normalize the passed word_class value and check if it is a valid word_class value.
+// If so, push it to the passed container.
+// If not and strict mode is set to false, print a warning and do not push it to the passed container.
+// If not and strict mode is set to true, throw an Exception.
+void insert_potential_word_class(string &word_class, strings &container, size_t line_number, bool strict_mode) {
+  trim(word_class);
+  if (!word_class.empty() && !is_word_class(word_class) && strict_mode) {
+    throw Exception{string{"Found a bad word class identifier \"" + word_class + "\" in line " +
+                           std::to_string(line_number) + "!"}};
+  } else if (!word_class.empty() && !is_word_class(word_class)) {
+    cerr << "Warning: The word class \"" << word_class << "\" in line " << std::to_string(line_number)
+         << " is unknown!" << endl;
+  } else if (!word_class.empty()) {
+    container.push_back(word_class);
+  }
+}
+
+// Process all word classes from the passed string and return a list with an item for each word class
+strings get_word_classes(string word_classes_string, size_t line_number, bool strict_mode) {
+  strings result;
+  string current_word_class;
+  for (const char &c : word_classes_string) {
+    if (c != '-' && !isalpha(c)) {
+      insert_potential_word_class(current_word_class, result, line_number, strict_mode);
+      current_word_class.clear();
+    } else {
+      current_word_class.insert(current_word_class.end(), std::tolower(c));
+    }
+  }
+  insert_potential_word_class(current_word_class, result, line_number, strict_mode);
+
+  return result;
+}
+}  // anonymous namespace
+
+namespace lgeorgieff {
+namespace translate {
+namespace scripts {
+
+using std::string;
+using std::endl;
+
+using lgeorgieff::translate::utils::Gender;
+using lgeorgieff::translate::utils::Numerus;
+using lgeorgieff::translate::utils::Exception;
+
+// Return the passed string with every escaped apostrophe ('') replaced by a single apostrophe (').
+string unescape_apostrophe(const string &str) {
+  string result;
+  for (size_t pos{0}; pos < str.size(); ++pos) {
+    result += str[pos];
+    if (str[pos] == '\'' && pos + 1 < str.size() && str[pos + 1] == '\'') ++pos;
+  }
+  return result;
+}
+
+// Return a string representing gender that can be directly passed into an SQL query string.
+string gender_to_sql_string(const Gender &gender, bool is_where) {
+  string gender_str{to_db_string(gender)};
+  if (is_where && Gender::none == gender)
+    gender_str.insert(0, "is ");
+  else if (is_where)
+    gender_str.insert(0, "=");
+  return gender_str;
+}
+
+// Return a string representing numerus that can be directly passed into an SQL query string.
+string numerus_to_sql_string(const Numerus &numerus, bool is_where) {
+  string numerus_str{to_db_string(numerus)};
+  if (is_where && Numerus::none == numerus)
+    numerus_str.insert(0, "is ");
+  else if (is_where)
+    numerus_str.insert(0, "=");
+  return numerus_str;
+}
+
+// Create all required SQL statements for representing an entry of a language resource for a particular language.
+void language_to_sql_statement(const LangItem &lang, std::ostream &dest) {
+  string gender_str{gender_to_sql_string(lang.gender)};
+  string numerus_str{numerus_to_sql_string(lang.numerus)};
+  string gender_where_str{gender_to_sql_string(lang.gender, true)};
+  string numerus_where_str{numerus_to_sql_string(lang.numerus, true)};
+
+  // Insert comment entry into the table "comment".
+  for (const string &comment : lang.comments) {
+    dest << "INSERT INTO comment (comment) SELECT '" << comment
+         << "' WHERE NOT EXISTS (SELECT 1 FROM comment WHERE comment='" << comment << "');" << endl;
+  }
+
+  // Insert abbreviation entry into the table "abbreviation".
+  for (const string &abbreviation : lang.abbreviations) {
+    dest << "INSERT INTO abbreviation (abbreviation) SELECT '" << abbreviation
+         << "' WHERE NOT EXISTS (SELECT 1 FROM abbreviation WHERE abbreviation='" << abbreviation << "');" << endl;
+  }
+
+  // Insert entry into the table "phrase". The phrase is already escaped and folding keeps all apostrophes, so the
+  // key is escaped as well.
+  const string phrase_key{to_phrase_key(lang.phrase)};
+  strings::const_iterator word_class_iter{lang.word_classes.cbegin()};
+  strings::const_iterator word_class_end{lang.word_classes.cend()};
+  do  {
+    string word_class_str{"null"};
+    string word_class_where_str{"is null"};
+    if (word_class_iter != word_class_end) {
+      word_class_str = "'" + *word_class_iter + "'";
+      word_class_where_str = "= '" + *word_class_iter++ + "'";
+    }
+    dest << "INSERT INTO phrase (phrase, language, gender, numerus, word_class, phrase_key) SELECT '" << lang.phrase
+         << "', '" << lang.language << "', " << gender_str << ", " << numerus_str << ", " << word_class_str << ", '"
+         << phrase_key << "' WHERE NOT EXISTS (SELECT 1 FROM phrase WHERE phrase='" << lang.phrase << "' and language='"
+         << lang.language << "' and gender " << gender_where_str << " and numerus " << numerus_where_str
+         << " and word_class " << word_class_where_str << ");" << endl;
+
+    // Insert phrase_id and comment_id into the table "phrase_comment".
+    for (const string &comment : lang.comments) {
+      dest << "INSERT INTO phrase_comment (phrase_id, comment_id) SELECT (SELECT id FROM phrase WHERE phrase='"
+           << lang.phrase << "' and language='" << lang.language << "' and gender " << gender_where_str
+           << " and numerus " << numerus_where_str << " and word_class " << word_class_where_str
+           << "), (SELECT id FROM comment WHERE comment='" << comment
+           << "') WHERE NOT EXISTS (SELECT 1 FROM phrase_comment WHERE phrase_id=(SELECT id FROM phrase WHERE phrase='"
+           << lang.phrase << "' and language='" << lang.language << "' and gender " << gender_where_str
+           << " and numerus " << numerus_where_str << " and word_class " << word_class_where_str
+           << ") and comment_id=(SELECT id FROM comment WHERE comment='" << comment << "'));" << endl;
+    }
+
+    // Insert phrase_id and abbreviation_id into the table "phrase_abbreviation".
+    for (const string &abbreviation : lang.abbreviations) {
+      dest << "INSERT INTO phrase_abbreviation (phrase_id, abbreviation_id) SELECT (SELECT id FROM phrase WHERE "
+              "phrase='" << lang.phrase << "' and language='" << lang.language << "' and gender " << gender_where_str
+           << " and numerus " << numerus_where_str << " and word_class " << word_class_where_str
+           << "), (SELECT id FROM abbreviation WHERE abbreviation='" << abbreviation
+           << "') WHERE NOT EXISTS (SELECT 1 FROM phrase_abbreviation WHERE phrase_id=(SELECT id FROM phrase WHERE "
+              "phrase='" << lang.phrase << "' and language='" << lang.language << "' and gender " << gender_where_str
+           << " and numerus " << numerus_where_str << " and word_class " << word_class_where_str
+           << ") and abbreviation_id=(SELECT id FROM abbreviation WHERE abbreviation='" << abbreviation << "'));"
+           << endl;
+    }
+  } while (word_class_iter != word_class_end);
+}
+
+// Transform a language item to an SQL statement, so that it can be inserted into a DB.
+void line_to_sql_statement(const LangItem &l_1, const LangItem &l_2, std::ostream &dest) {
+  language_to_sql_statement(l_1, dest);
+  language_to_sql_statement(l_2, dest);
+  string gender_str_1{gender_to_sql_string(l_1.gender, true)};
+  string numerus_str_1{numerus_to_sql_string(l_1.numerus, true)};
+  string gender_str_2{gender_to_sql_string(l_2.gender, true)};
+  string numerus_str_2{numerus_to_sql_string(l_2.numerus, true)};
+
+  strings::const_iterator word_class_iter{l_1.word_classes.cbegin()};
+  strings::const_iterator word_class_end{l_1.word_classes.cend()};
+  do {
+    string word_class_where_str{"is null"};
+    if (word_class_iter != word_class_end) word_class_where_str = "= '" + *word_class_iter++ + "'";
+
+    dest << "INSERT INTO phrase_translation (phrase_id_in, phrase_id_out) SELECT (SELECT id FROM phrase WHERE(phrase='"
+         << l_1.phrase << "' and language='" << l_1.language << "' and gender " << gender_str_1 << " and numerus "
+         << numerus_str_1 << " and word_class " << word_class_where_str << ")), (SELECT id FROM phrase WHERE(phrase='"
+         << l_2.phrase << "' and language='" << l_2.language << "' and gender " << gender_str_2 << " and numerus "
+         << numerus_str_2 << " and word_class " << word_class_where_str
+         << ")) WHERE NOT EXISTS (SELECT 1 FROM phrase_translation WHERE phrase_id_in=(SELECT id FROM phrase "
+            "WHERE(phrase='" << l_1.phrase << "' and language='" << l_1.language << "' and gender " << gender_str_1
+         << " and numerus " << numerus_str_1 << " and word_class " << word_class_where_str
+         << ")) and phrase_id_out=(SELECT id FROM phrase WHERE(phrase='" << l_2.phrase << "' and language='"
+         << l_2.language << "' and gender " << gender_str_2 << " and numerus " << numerus_str_2 << " and word_class "
+         << word_class_where_str << ")));" << endl;
+  } while (word_class_iter != word_class_end);
+
+  dest << endl;
+}
+
+bool process_line(const string &line, const string &lang_id_1, const string &lang_id_2, size_t line_number,
+                  bool strict_mode, LangItem &lang_item_1, LangItem &lang_item_2) {
+  size_t delimiter_lang{line.find('\t')};
+  if ((string::npos == delimiter_lang || delimiter_lang + 1 == line.size()) && strict_mode) {
+    throw Exception{"Line " + std::to_string(line_number) +
+                    " in language resource does not contain a tab representing a delimiter between two" +
+                    " languages!"};
+  }
+  size_t delimiter_class{line.find('\t', delimiter_lang + 1)};
+  string lang_entry_1{line.substr(0, delimiter_lang)};
+  string lang_entry_2{line.substr(delimiter_lang + 1, delimiter_class - delimiter_lang - 1)};
+  strings word_classes;
+  if (string::npos != delimiter_class)
+    word_classes = get_word_classes(line.substr(delimiter_class + 1, string::npos), line_number, strict_mode);
+
+  lang_item_1 = process_lang(lang_entry_1, word_classes, lang_id_1, line_number, strict_mode);
+  lang_item_2 = process_lang(lang_entry_2, word_classes, lang_id_2, line_number, strict_mode);
+
+  if ((lang_item_1.phrase.empty() || lang_item_2.phrase.empty()) && strict_mode)
+    throw Exception{string{"No translation found in line " + std::to_string(line_number) + "!"}};
+  return !lang_item_1.phrase.empty() && !lang_item_2.phrase.empty();
+}
+
+}  // scripts
+}  // translate
+}  // lgeorgieff
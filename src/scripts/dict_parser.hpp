@@ -0,0 +1,80 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares the parser for language resource files from dict.cc and the SQL statement generators that
+//              are shared by dict2sql and trlt-import.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#ifndef DICT_PARSER_HPP_
+#define DICT_PARSER_HPP_
+
+#include "utils/gender.hpp"
+#include "utils/numerus.hpp"
+
+#include <cstddef>
+#include <list>
+#include <ostream>
+#include <string>
+
+namespace lgeorgieff {
+namespace translate {
+namespace scripts {
+
+typedef std::list<std::string> strings;
+
+// A struct that helds all data for a language item
+struct LangItem {
+  LangItem() = default;
+  LangItem(const LangItem &) = default;
+  LangItem(LangItem &&) = default;
+  ~LangItem() = default;
+  LangItem &operator=(const LangItem &) = default;
+  LangItem &operator=(LangItem &&) = default;
+
+  std::string language;
+  std::string phrase;
+  strings word_classes;
+  strings comments;
+  strings abbreviations;
+  utils::Gender gender;
+  utils::Numerus numerus;
+};
+
+// Process a line from a language resource, i.e. parse both languages in the passed line and write the results into
+// the passed language items. Returns true if the line contains a complete translation.
+// If strict mode is set, every parser error causes an lgeorgieff::translate::utils::Exception to be thrown.
+bool process_line(const std::string &, const std::string &, const std::string &, size_t, bool, LangItem &,
+                  LangItem &);
+
+// Return the passed string with every escaped apostrophe ('') replaced by a single apostrophe (').
+std::string unescape_apostrophe(const std::string &);
+
+// Return a string representing gender that can be directly passed into an SQL query string.
+std::string gender_to_sql_string(const utils::Gender &, bool = false);
+
+// Return a string representing numerus that can be directly passed into an SQL query string.
+std::string numerus_to_sql_string(const utils::Numerus &, bool = false);
+
+// Create all required SQL statements for representing an entry of a language resource for a particular language.
+void language_to_sql_statement(const LangItem &, std::ostream &);
+
+// Transform a language item to an SQL statement, so that it can be inserted into a DB.
+void line_to_sql_statement(const LangItem &, const LangItem &, std::ostream &);
+
+}  // scripts
+}  // translate
+}  // lgeorgieff
+
+#endif  // DICT_PARSER_HPP_
@@ -0,0 +1,129 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Looks up phrases in a binary dictionary that was compiled by dict2bin.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "utils/binary_dictionary.hpp"
+#include "utils/exception.hpp"
+#include "utils/gender.hpp"
+#include "utils/numerus.hpp"
+#include "utils/word_class.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::strcmp;
+
+using lgeorgieff::translate::utils::BinaryDictionary;
+using lgeorgieff::translate::utils::DictionaryEntry;
+using lgeorgieff::translate::utils::DictionaryPhrase;
+using lgeorgieff::translate::utils::Exception;
+using lgeorgieff::translate::utils::Gender;
+using lgeorgieff::translate::utils::Numerus;
+using lgeorgieff::translate::utils::WordClass;
+using lgeorgieff::translate::utils::to_string;
+
+void print_usage(string self_name, std::ostream &destination) {
+  destination << endl;
+  destination << "usage: " << self_name << " --file <dictionary> [--timing] [phrase...]" << endl;
+  destination << endl;
+  destination << "Looks up each passed phrase in the binary dictionary. If no" << endl;
+  destination << "phrase is passed, one phrase per line is read from stdin." << endl;
+  destination << endl;
+  destination << "--file | -f <dictionary>     The binary dictionary created by dict2bin" << endl;
+  destination << "--timing | -t                Prints the lookup time of each phrase" << endl;
+  destination << "--help | -h                  Shows this dialog and exits this programme" << endl;
+}
+
+// Writes the passed phrase in the notation of the dict.cc language resources, e.g. "Haus {n} [Gebäude]".
+void write_phrase(const DictionaryPhrase &phrase, std::ostream &destination) {
+  destination << phrase.phrase;
+  if (Gender::none != phrase.gender) destination << " {" << to_string(phrase.gender) << "}";
+  if (Numerus::none != phrase.numerus) destination << " {" << to_string(phrase.numerus) << "}";
+  for (const string &comment : phrase.comments) destination << " [" << comment << "]";
+  for (const string &abbreviation : phrase.abbreviations) destination << " <" << abbreviation << ">";
+}
+
+// Looks up the passed phrase and writes one line per translation.
+void lookup(const BinaryDictionary &dictionary, const string &phrase, bool timing) {
+  std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  std::vector<DictionaryEntry> entries{dictionary.lookup(phrase)};
+  std::chrono::steady_clock::duration duration{std::chrono::steady_clock::now() - start};
+
+  for (const DictionaryEntry &entry : entries) {
+    for (const DictionaryPhrase &phrase_out : entry.phrases_out) {
+      write_phrase(entry.phrase_in, cout);
+      cout << "\t";
+      write_phrase(phrase_out, cout);
+      cout << "\t" << to_string(entry.phrase_in.word_class) << endl;
+    }
+  }
+  if (entries.empty()) cerr << "No translation found for \"" << phrase << "\"" << endl;
+  if (timing)
+    cerr << "Lookup of \"" << phrase << "\" took "
+         << std::chrono::duration_cast<std::chrono::microseconds>(duration).count() << " us" << endl;
+}
+
+// The entry point for this programme
+int main(const int argc, const char **argv) {
+  string dictionary_path;
+  bool timing{false};
+  std::vector<string> phrases;
+  try {
+    for (int pos{1}; argc > pos; ++pos) {
+      if ((!strcmp("--file", argv[pos]) || !strcmp("-f", argv[pos]))) {
+        if (argc - 1 != pos) dictionary_path = argv[++pos];
+      } else if (!strcmp("--timing", argv[pos]) || !strcmp("-t", argv[pos])) {
+        timing = true;
+      } else if (!strcmp("--help", argv[pos]) || !strcmp("-h", argv[pos])) {
+        print_usage(argv[0], cout);
+        return 0;
+      } else if ('-' == argv[pos][0]) {
+        cerr << "The option \"" << argv[pos] << "\" is unknown!" << endl;
+        cerr << "For more help run \"" << argv[0] << " -h\"" << endl;
+        return 2;
+      } else {
+        phrases.push_back(argv[pos]);
+      }
+    }
+    if (dictionary_path.empty()) {
+      cerr << "The value for \"--file\" | \"-f\" must not be empty!" << endl;
+      cerr << "For more help run \"" << argv[0] << " -h\"" << endl;
+      return 1;
+    }
+
+    BinaryDictionary dictionary{dictionary_path};
+    if (phrases.empty()) {
+      string line;
+      while (std::getline(std::cin, line)) lookup(dictionary, line, timing);
+    } else {
+      for (const string &phrase : phrases) lookup(dictionary, phrase, timing);
+    }
+  } catch (const Exception &err) {
+    cerr << "Encountered an exception \"" << err.what() << "\"" << endl;
+    return 1;
+  }
+
+  return 0;
+}
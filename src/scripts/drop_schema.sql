@@ -1,7 +1,7 @@
 /*
 #######################################################################################################################
 # Copyright (C) 2015  Lukas Georgieff
-# Last modified: 04/04/2015
+# Last modified: 10/19/2026
 # Description: Drops the (postgresql) SQL data base schema for the server side of translate.
 #              Usage: psql --username translate --dbname translate --file drop_schema.sql
 #######################################################################################################################
@@ -21,6 +21,8 @@
 #######################################################################################################################
 */
 
+DROP VIEW IF EXISTS translation_lookup_source CASCADE;
+DROP TABLE IF EXISTS translation_lookup CASCADE;
 DROP TABLE phrase_translation CASCADE;
 DROP TABLE phrase_comment CASCADE;
 DROP TABLE phrase CASCADE;
@@ -31,3 +33,4 @@ DROP TABLE comment CASCADE;
 DROP TABLE abbreviation CASCADE;
 DROP TABLE phrase_abbreviation CASCADE;
 DROP TABLE gender_description CASCADE;
+DROP TABLE IF EXISTS schema_migration CASCADE;
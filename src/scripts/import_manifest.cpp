@@ -0,0 +1,146 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements the manifest of a language resource that is used by trlt-import for incremental imports.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "import_manifest.hpp"
+#include "dict_parser.hpp"
+#include "utils/exception.hpp"
+
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+using lgeorgieff::translate::utils::Exception;
+
+const uint64_t FNV_OFFSET_BASIS{14695981039346656037ULL};
+const uint64_t FNV_PRIME{1099511628211ULL};
+
+// Parses the hexadecimal hash in the passed range of the passed string.
+uint64_t parse_hash(const std::string &str, size_t begin, size_t end, const std::string &path) {
+  if (begin == end) throw Exception{"The manifest \"" + path + "\" contains an empty hash!"};
+  char *parse_end{nullptr};
+  uint64_t result{std::strtoull(str.c_str() + begin, &parse_end, 16)};
+  if (parse_end != str.c_str() + end) throw Exception{"The manifest \"" + path + "\" contains a bad hash!"};
+  return result;
+}
+
+// Parses the comma separated fact hashes in the passed range of the passed string and calls the passed function for
+// each of them.
+void parse_facts(const std::string &str, size_t begin, size_t end, const std::string &path,
+                 const std::function<void(uint64_t)> &fun) {
+  while (begin < end) {
+    size_t separator{str.find(',', begin)};
+    if (std::string::npos == separator || separator > end) separator = end;
+    fun(parse_hash(str, begin, separator, path));
+    begin = separator + 1;
+  }
+}
+}  // anonymous namespace
+
+namespace lgeorgieff {
+namespace translate {
+namespace scripts {
+
+uint64_t hash_string(const std::string &str) {
+  uint64_t result{FNV_OFFSET_BASIS};
+  for (const char &c : str) {
+    result ^= static_cast<unsigned char>(c);
+    result *= FNV_PRIME;
+  }
+  return result;
+}
+
+uint64_t hash_row(const StagingRow &row) {
+  return hash_string(std::to_string(static_cast<unsigned>(row.table)) + row.values);
+}
+
+void ImportManifest::load(const std::string &path) {
+  this->entries_.clear();
+  this->seen_lines_.clear();
+  std::ifstream in{path, std::ifstream::in};
+  if (!in) return;
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t first_tab{line.find('\t')};
+    size_t second_tab{std::string::npos == first_tab ? first_tab : line.find('\t', first_tab + 1)};
+    if (std::string::npos == second_tab) throw Exception{"The manifest \"" + path + "\" is corrupt!"};
+    ManifestEntry &entry(this->entries_[parse_hash(line, 0, first_tab, path)]);
+    parse_facts(line, first_tab + 1, second_tab, path, [&entry](uint64_t fact) { entry.facts.push_back(fact); });
+    entry.line = line.substr(second_tab + 1);
+  }
+  if (in.bad()) throw Exception{"Failed to read from \"" + path + "\"!"};
+}
+
+ImportManifest::entries_type &ImportManifest::entries() noexcept { return this->entries_; }
+
+bool ImportManifest::take_line(uint64_t line_hash, std::ostream &new_manifest) {
+  if (!this->seen_lines_.insert(line_hash).second) return false;
+  entries_type::iterator entry{this->entries_.find(line_hash)};
+  if (this->entries_.end() == entry) return true;
+  // the line is unchanged since the last run
+  write_entry(new_manifest, line_hash, entry->second);
+  this->entries_.erase(entry);
+  return false;
+}
+
+size_t ImportManifest::collect_removed_rows(const std::string &language_in, const std::string &language_out,
+                                            removed_rows_type &removed_rows) const {
+  size_t result{0};
+  LangItem lang_item_1, lang_item_2;
+  staging_rows rows;
+  for (const entries_type::value_type &entry : this->entries_) {
+    if (!process_line(entry.second.line, language_in, language_out, 0, false, lang_item_1, lang_item_2)) continue;
+    ++result;
+    rows.clear();
+    StagingWriter::to_rows(lang_item_1, lang_item_2, rows);
+    for (StagingRow &row : rows) {
+      uint64_t fact{hash_row(row)};
+      removed_rows.emplace(fact, std::move(row));
+    }
+  }
+  return result;
+}
+
+void ImportManifest::write_entry(std::ostream &out, uint64_t line_hash, const ManifestEntry &entry) {
+  out << std::hex << line_hash << '\t';
+  for (size_t pos{0}; pos != entry.facts.size(); ++pos) {
+    if (pos) out << ',';
+    out << entry.facts[pos];
+  }
+  out << std::dec << '\t' << entry.line << '\n';
+}
+
+void ImportManifest::for_each_fact(const std::string &path, const std::function<void(uint64_t)> &fun) {
+  std::ifstream in{path, std::ifstream::in};
+  if (!in) throw Exception{"Cannot read the manifest \"" + path + "\"!"};
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t first_tab{line.find('\t')};
+    size_t second_tab{std::string::npos == first_tab ? first_tab : line.find('\t', first_tab + 1)};
+    if (std::string::npos == second_tab) throw Exception{"The manifest \"" + path + "\" is corrupt!"};
+    parse_facts(line, first_tab + 1, second_tab, path, fun);
+  }
+  if (in.bad()) throw Exception{"Failed to read from \"" + path + "\"!"};
+}
+
+void ImportManifest::keep_facts(const std::string &path, removed_rows_type &removed_rows) {
+  for_each_fact(path, [&removed_rows](uint64_t fact) { removed_rows.erase(fact); });
+}
+
+}  // scripts
+}  // translate
+}  // lgeorgieff
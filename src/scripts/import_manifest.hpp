@@ -0,0 +1,105 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares the manifest of a language resource that is used by trlt-import for incremental imports.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// Manifest format
+// ===============
+//
+// A manifest holds one line for every distinct line of a language resource that was imported by the last run:
+//   <line hash>\t<fact hash>,<fact hash>,...\t<line>
+// All hashes are hexadecimal FNV-1a values. A fact is a single staging row, e.g. a phrase or a translation, that
+// results from parsing the line. Lines that are not part of the resource anymore are parsed again from the manifest
+// to find out which rows must be deleted. The fact hashes of all other lines tell whether a row of a removed line is
+// still produced by any remaining line, in which case it must not be deleted.
+// ====================================================================================================================
+
+#ifndef IMPORT_MANIFEST_HPP_
+#define IMPORT_MANIFEST_HPP_
+
+#include "import_staging.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace lgeorgieff {
+namespace translate {
+namespace scripts {
+
+// Returns the 64 bit FNV-1a hash of the passed string. In contrast to std::hash the value is stable between different
+// builds and platforms, so it can be stored in a manifest.
+uint64_t hash_string(const std::string &);
+
+// Returns the fact hash of the passed staging row.
+uint64_t hash_row(const StagingRow &);
+
+// An entry of a manifest, i.e. a line of a language resource and the fact hashes of this line.
+struct ManifestEntry {
+  std::vector<uint64_t> facts;
+  std::string line;
+};
+
+// The manifest of a language resource from the last run of trlt-import.
+class ImportManifest {
+ public:
+  typedef std::unordered_map<uint64_t, ManifestEntry> entries_type;
+  // The staging rows of removed lines mapped by their fact hash.
+  typedef std::unordered_map<uint64_t, StagingRow> removed_rows_type;
+
+  ImportManifest() = default;
+  ImportManifest(const ImportManifest &) = delete;
+  ImportManifest(ImportManifest &&) = default;
+  ImportManifest &operator=(const ImportManifest &) = delete;
+  ImportManifest &operator=(ImportManifest &&) = default;
+  ~ImportManifest() = default;
+
+  // Reads all entries of the passed manifest file. A missing file results in an empty manifest.
+  // If the file is corrupt an lgeorgieff::translate::utils::Exception is thrown.
+  void load(const std::string &);
+  // Returns all entries of this manifest mapped by their line hash.
+  entries_type &entries() noexcept;
+  // Returns true if the line with the passed hash must be parsed and imported. Duplicates of a line that was already
+  // passed are skipped. A line of the last run is skipped as well, its entry is moved from this manifest to the passed
+  // new manifest. So finally this manifest only contains the entries of removed lines.
+  bool take_line(uint64_t, std::ostream &);
+  // Parses the lines of all entries of this manifest with the passed language ids and adds their staging rows to the
+  // passed map. Returns the number of entries that contain a translation.
+  size_t collect_removed_rows(const std::string &, const std::string &, removed_rows_type &) const;
+
+  // Writes a single entry with the passed line hash in the manifest format to the passed stream.
+  static void write_entry(std::ostream &, uint64_t, const ManifestEntry &);
+  // Reads only the fact hashes of the passed manifest file and calls the passed function for each of them.
+  static void for_each_fact(const std::string &, const std::function<void(uint64_t)> &);
+  // Removes all rows from the passed map whose fact hash is listed in the passed manifest file, i.e. the rows that are
+  // still produced by a remaining line.
+  static void keep_facts(const std::string &, removed_rows_type &);
+
+ private:
+  entries_type entries_;
+  std::unordered_set<uint64_t> seen_lines_;
+};  // ImportManifest
+
+}  // scripts
+}  // translate
+}  // lgeorgieff
+
+#endif  // IMPORT_MANIFEST_HPP_
@@ -0,0 +1,325 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements the staging tables that are used by trlt-import for loading language resources in
+//              parallel and for applying the deltas of an incremental import.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "import_staging.hpp"
+#include "utils/phrase_key.hpp"
+
+#include <sstream>
+
+namespace {
+using lgeorgieff::translate::scripts::StagingTable;
+using lgeorgieff::translate::utils::to_phrase_key;
+
+// The number of phrase keys that are updated by a single statement.
+const size_t PHRASE_KEY_BATCH_SIZE{1000};
+
+// The key columns of a phrase row without the word class, which is shared by both sides of a translation.
+const std::string PHRASE_KEY_COLUMNS{"phrase varchar(256), language char(2), gender char(1), numerus numerus"};
+
+// Returns the join condition between a row of the table phrase and the phrase key columns of a staging table.
+// The columns gender, numerus and word_class are nullable, so they are compared by "IS NOT DISTINCT FROM" which
+// corresponds to the "= '...'" or "is null" conditions dict2sql creates.
+std::string phrase_join_condition(const std::string &phrase_alias, const std::string &staging_alias,
+                                  const std::string &suffix = "") {
+  return phrase_alias + ".phrase = " + staging_alias + ".phrase" + suffix + " AND " + phrase_alias + ".language = " +
+         staging_alias + ".language" + suffix + " AND " + phrase_alias + ".gender IS NOT DISTINCT FROM " +
+         staging_alias + ".gender" + suffix + " AND " + phrase_alias + ".numerus IS NOT DISTINCT FROM " +
+         staging_alias + ".numerus" + suffix + " AND " + phrase_alias + ".word_class IS NOT DISTINCT FROM " +
+         staging_alias + ".word_class";
+}
+
+// Returns the name of the passed staging table without its prefix.
+std::string table_name(StagingTable table) {
+  switch (table) {
+    case StagingTable::phrase:
+      return "phrase";
+    case StagingTable::phrase_comment:
+      return "phrase_comment";
+    case StagingTable::phrase_abbreviation:
+      return "phrase_abbreviation";
+    default:
+      return "translation";
+  }
+}
+
+// Creates the staging tables with the passed name prefix.
+void create_prefixed_tables(pqxx::transaction_base &transaction, const std::string &prefix) {
+  transaction.exec("CREATE UNLOGGED TABLE " + prefix + "phrase (" + PHRASE_KEY_COLUMNS + ", word_class varchar(8));");
+  transaction.exec("CREATE UNLOGGED TABLE " + prefix + "phrase_comment (" + PHRASE_KEY_COLUMNS +
+                   ", word_class varchar(8), comment varchar(256));");
+  transaction.exec("CREATE UNLOGGED TABLE " + prefix + "phrase_abbreviation (" + PHRASE_KEY_COLUMNS +
+                   ", word_class varchar(8), abbreviation varchar(256));");
+  transaction.exec("CREATE UNLOGGED TABLE " + prefix +
+                   "translation (phrase_in varchar(256), language_in char(2), gender_in char(1), numerus_in numerus, "
+                   "phrase_out varchar(256), language_out char(2), gender_out char(1), numerus_out numerus, "
+                   "word_class varchar(8));");
+}
+
+// Writes an "INSERT ... VALUES" statement for all passed rows into the passed transaction and clears the rows.
+void insert_rows(pqxx::transaction_base &transaction, const std::string &table, std::vector<std::string> &rows) {
+  if (rows.empty()) return;
+  std::stringstream ss;
+  ss << "INSERT INTO " << table << " VALUES ";
+  for (size_t pos{0}; pos != rows.size(); ++pos) {
+    if (pos) ss << ", ";
+    ss << rows[pos];
+  }
+  ss << ";";
+  transaction.exec(ss.str());
+  rows.clear();
+}
+}  // anonymous namespace
+
+namespace lgeorgieff {
+namespace translate {
+namespace scripts {
+
+const size_t StagingWriter::DEFAULT_BATCH_SIZE{500};
+const std::string ImportStaging::INSERTED{"import_"};
+const std::string ImportStaging::REMOVED{"import_removed_"};
+const std::string ImportStaging::DATA_CHANGED_CHANNEL{"trlt_data_changed"};
+
+void ImportStaging::create_tables(pqxx::connection_base &connection) {
+  drop_tables(connection);
+  pqxx::work query(connection);
+  create_prefixed_tables(query, INSERTED);
+  create_prefixed_tables(query, REMOVED);
+  query.commit();
+}
+
+void ImportStaging::drop_tables(pqxx::connection_base &connection) {
+  pqxx::work query(connection);
+  query.exec(
+      "DROP TABLE IF EXISTS import_phrase, import_phrase_comment, import_phrase_abbreviation, import_translation, "
+      "import_removed_phrase, import_removed_phrase_comment, import_removed_phrase_abbreviation, "
+      "import_removed_translation;");
+  query.commit();
+}
+
+void ImportStaging::apply_tables(pqxx::transaction_base &transaction) {
+  transaction.exec("CREATE TEMPORARY TABLE import_affected_phrase (id integer PRIMARY KEY) ON COMMIT DROP;");
+  // The ids of removed phrases are only available before they are deleted.
+  collect_affected_phrases(transaction, REMOVED);
+  remove_tables(transaction);
+  merge_tables(transaction);
+  fill_phrase_keys(transaction);
+  collect_affected_phrases(transaction, INSERTED);
+  refresh_translation_lookup(transaction);
+  notify_changes(transaction);
+}
+
+void ImportStaging::collect_affected_phrases(pqxx::transaction_base &transaction, const std::string &prefix) {
+  // A phrase is referenced by several staging rows, but it is recorded only once.
+  const std::string not_recorded{" WHERE NOT EXISTS (SELECT 1 FROM import_affected_phrase a WHERE a.id = p.id);"};
+  for (const char *table : {"phrase", "phrase_comment", "phrase_abbreviation"}) {
+    transaction.exec("INSERT INTO import_affected_phrase (id) SELECT DISTINCT p.id FROM phrase p JOIN " + prefix +
+                     table + " s ON " + phrase_join_condition("p", "s") + not_recorded);
+  }
+  for (const char *suffix : {"_in", "_out"}) {
+    transaction.exec("INSERT INTO import_affected_phrase (id) SELECT DISTINCT p.id FROM phrase p JOIN " + prefix +
+                     "translation s ON " + phrase_join_condition("p", "s", suffix) + not_recorded);
+  }
+}
+
+void ImportStaging::fill_phrase_keys(pqxx::transaction_base &transaction) {
+  // The keys are computed by the client, since the data base has no equivalent of utils::to_phrase_key.
+  const pqxx::result phrases{transaction.exec("SELECT id, phrase FROM phrase WHERE phrase_key IS NULL;")};
+  std::stringstream values;
+  size_t batch_size{0};
+  auto update = [&transaction, &values, &batch_size]() {
+    if (!batch_size) return;
+    transaction.exec("UPDATE phrase p SET phrase_key = k.phrase_key FROM (VALUES " + values.str() +
+                     ") k (id, phrase_key) WHERE p.id = k.id;");
+    values.str("");
+    batch_size = 0;
+  };
+  for (const pqxx::tuple &row : phrases) {
+    if (batch_size) values << ", ";
+    values << "(" << row[0].c_str() << ", " << transaction.quote(to_phrase_key(row[1].c_str())) << ")";
+    if (++batch_size == PHRASE_KEY_BATCH_SIZE) update();
+  }
+  update();
+  transaction.exec(
+      "UPDATE translation_lookup tl SET phrase_key_in = p.phrase_key FROM phrase p WHERE tl.phrase_id_in = p.id AND "
+      "tl.phrase_key_in IS NULL;");
+}
+
+void ImportStaging::refresh_translation_lookup(pqxx::transaction_base &transaction) {
+  transaction.exec("ANALYZE import_affected_phrase;");
+  transaction.exec(
+      "DELETE FROM translation_lookup tl USING import_affected_phrase a WHERE tl.phrase_id_in = a.id;");
+  transaction.exec(
+      "DELETE FROM translation_lookup tl USING import_affected_phrase a WHERE tl.phrase_id_out = a.id;");
+  // The json columns do not support UNION, so the second part only adds the rows that are not part of the first one.
+  // NOT EXISTS is used instead of NOT IN, which is rescanned for every row if the ids do not fit into work_mem.
+  transaction.exec(
+      "INSERT INTO translation_lookup SELECT * FROM translation_lookup_source WHERE phrase_id_in IN (SELECT id FROM "
+      "import_affected_phrase) UNION ALL SELECT * FROM translation_lookup_source t WHERE phrase_id_out IN (SELECT id "
+      "FROM import_affected_phrase) AND NOT EXISTS (SELECT 1 FROM import_affected_phrase a WHERE a.id = "
+      "t.phrase_id_in);");
+  transaction.exec("ANALYZE translation_lookup;");
+}
+
+void ImportStaging::notify_changes(pqxx::transaction_base &transaction) {
+  // Each line stages the phrases of both of its languages, so the phrase tables contain all affected languages.
+  const pqxx::result languages{transaction.exec(
+      "SELECT language FROM import_phrase UNION SELECT language FROM import_removed_phrase ORDER BY language;")};
+  std::string payload;
+  for (const pqxx::tuple &row : languages) {
+    if (!payload.empty()) payload += ' ';
+    payload += row[0].c_str();
+  }
+  if (payload.empty()) return;
+  transaction.exec("SELECT pg_notify(" + transaction.quote(DATA_CHANGED_CHANNEL) + ", " + transaction.quote(payload) +
+                   ");");
+}
+
+void ImportStaging::merge_tables(pqxx::transaction_base &transaction) {
+  transaction.exec("ANALYZE import_phrase;");
+  transaction.exec("ANALYZE import_phrase_comment;");
+  transaction.exec("ANALYZE import_phrase_abbreviation;");
+  transaction.exec("ANALYZE import_translation;");
+
+  transaction.exec(
+      "INSERT INTO comment (comment) SELECT DISTINCT s.comment FROM import_phrase_comment s WHERE NOT EXISTS "
+      "(SELECT 1 FROM comment c WHERE c.comment = s.comment);");
+  transaction.exec(
+      "INSERT INTO abbreviation (abbreviation) SELECT DISTINCT s.abbreviation FROM import_phrase_abbreviation s "
+      "WHERE NOT EXISTS (SELECT 1 FROM abbreviation a WHERE a.abbreviation = s.abbreviation);");
+  transaction.exec(
+      "INSERT INTO phrase (phrase, language, gender, numerus, word_class) SELECT DISTINCT s.phrase, s.language, "
+      "s.gender, s.numerus, s.word_class FROM import_phrase s WHERE NOT EXISTS (SELECT 1 FROM phrase p WHERE " +
+      phrase_join_condition("p", "s") + ");");
+  transaction.exec(
+      "INSERT INTO phrase_comment (phrase_id, comment_id) SELECT DISTINCT p.id, c.id FROM import_phrase_comment s "
+      "JOIN phrase p ON " +
+      phrase_join_condition("p", "s") +
+      " JOIN comment c ON c.comment = s.comment WHERE NOT EXISTS (SELECT 1 FROM phrase_comment pc WHERE "
+      "pc.phrase_id = p.id AND pc.comment_id = c.id);");
+  transaction.exec(
+      "INSERT INTO phrase_abbreviation (phrase_id, abbreviation_id) SELECT DISTINCT p.id, a.id FROM "
+      "import_phrase_abbreviation s JOIN phrase p ON " +
+      phrase_join_condition("p", "s") +
+      " JOIN abbreviation a ON a.abbreviation = s.abbreviation WHERE NOT EXISTS (SELECT 1 FROM phrase_abbreviation "
+      "pa WHERE pa.phrase_id = p.id AND pa.abbreviation_id = a.id);");
+  transaction.exec(
+      "INSERT INTO phrase_translation (phrase_id_in, phrase_id_out) SELECT DISTINCT p_in.id, p_out.id FROM "
+      "import_translation s JOIN phrase p_in ON " +
+      phrase_join_condition("p_in", "s", "_in") + " JOIN phrase p_out ON " +
+      phrase_join_condition("p_out", "s", "_out") +
+      " WHERE NOT EXISTS (SELECT 1 FROM phrase_translation pt WHERE pt.phrase_id_in = p_in.id AND "
+      "pt.phrase_id_out = p_out.id);");
+}
+
+void ImportStaging::remove_tables(pqxx::transaction_base &transaction) {
+  transaction.exec("ANALYZE import_removed_phrase;");
+  transaction.exec("ANALYZE import_removed_phrase_comment;");
+  transaction.exec("ANALYZE import_removed_phrase_abbreviation;");
+  transaction.exec("ANALYZE import_removed_translation;");
+
+  transaction.exec(
+      "DELETE FROM phrase_translation pt USING import_removed_translation s, phrase p_in, phrase p_out WHERE "
+      "pt.phrase_id_in = p_in.id AND pt.phrase_id_out = p_out.id AND " +
+      phrase_join_condition("p_in", "s", "_in") + " AND " + phrase_join_condition("p_out", "s", "_out") + ";");
+  transaction.exec(
+      "DELETE FROM phrase_comment pc USING import_removed_phrase_comment s, phrase p, comment c WHERE pc.phrase_id = "
+      "p.id AND pc.comment_id = c.id AND c.comment = s.comment AND " +
+      phrase_join_condition("p", "s") + ";");
+  transaction.exec(
+      "DELETE FROM phrase_abbreviation pa USING import_removed_phrase_abbreviation s, phrase p, abbreviation a WHERE "
+      "pa.phrase_id = p.id AND pa.abbreviation_id = a.id AND a.abbreviation = s.abbreviation AND " +
+      phrase_join_condition("p", "s") + ";");
+
+  // Removed phrases are only deleted if no translation refers to them anymore, e.g. a German phrase of DE-EN.txt may
+  // still be used by DE-FR.txt.
+  const std::string unreferenced_phrase{
+      "NOT EXISTS (SELECT 1 FROM phrase_translation pt WHERE pt.phrase_id_in = p.id OR pt.phrase_id_out = p.id)"};
+  transaction.exec("DELETE FROM phrase_comment pc USING import_removed_phrase s, phrase p WHERE pc.phrase_id = p.id "
+                   "AND " + phrase_join_condition("p", "s") + " AND " + unreferenced_phrase + ";");
+  transaction.exec("DELETE FROM phrase_abbreviation pa USING import_removed_phrase s, phrase p WHERE pa.phrase_id = "
+                   "p.id AND " + phrase_join_condition("p", "s") + " AND " + unreferenced_phrase + ";");
+  transaction.exec("DELETE FROM phrase p USING import_removed_phrase s WHERE " + phrase_join_condition("p", "s") +
+                   " AND " + unreferenced_phrase + ";");
+  transaction.exec(
+      "DELETE FROM comment c USING import_removed_phrase_comment s WHERE c.comment = s.comment AND NOT EXISTS "
+      "(SELECT 1 FROM phrase_comment pc WHERE pc.comment_id = c.id);");
+  transaction.exec(
+      "DELETE FROM abbreviation a USING import_removed_phrase_abbreviation s WHERE a.abbreviation = s.abbreviation "
+      "AND NOT EXISTS (SELECT 1 FROM phrase_abbreviation pa WHERE pa.abbreviation_id = a.id);");
+}
+
+StagingWriter::StagingWriter(pqxx::connection_base &connection, const std::string &table_prefix, size_t batch_size)
+    : connection_{&connection},
+      table_prefix_{table_prefix},
+      batch_size_{batch_size},
+      buffered_lines_{0},
+      line_rows_{},
+      rows_{} {}
+
+void StagingWriter::to_rows(const LangItem &l_1, const LangItem &l_2, staging_rows &rows) {
+  strings::const_iterator word_class_iter{l_1.word_classes.cbegin()};
+  strings::const_iterator word_class_end{l_1.word_classes.cend()};
+  do {
+    std::string word_class_str{"null"};
+    if (word_class_iter != word_class_end) word_class_str = "'" + *word_class_iter++ + "'";
+    add_language_item(l_1, word_class_str, rows);
+    add_language_item(l_2, word_class_str, rows);
+    rows.push_back(StagingRow{StagingTable::translation,
+                              "('" + l_1.phrase + "', '" + l_1.language + "', " + gender_to_sql_string(l_1.gender) +
+                                  ", " + numerus_to_sql_string(l_1.numerus) + ", '" + l_2.phrase + "', '" +
+                                  l_2.language + "', " + gender_to_sql_string(l_2.gender) + ", " +
+                                  numerus_to_sql_string(l_2.numerus) + ", " + word_class_str + ")"});
+  } while (word_class_iter != word_class_end);
+}
+
+void StagingWriter::add(const LangItem &l_1, const LangItem &l_2) {
+  this->line_rows_.clear();
+  to_rows(l_1, l_2, this->line_rows_);
+  this->add(this->line_rows_);
+}
+
+void StagingWriter::add(const staging_rows &rows) {
+  for (const StagingRow &row : rows) this->rows_[static_cast<size_t>(row.table)].push_back(row.values);
+  if (++this->buffered_lines_ >= this->batch_size_) this->flush();
+}
+
+void StagingWriter::add_language_item(const LangItem &lang, const std::string &word_class_str, staging_rows &rows) {
+  std::string key{"('" + lang.phrase + "', '" + lang.language + "', " + gender_to_sql_string(lang.gender) + ", " +
+                  numerus_to_sql_string(lang.numerus) + ", " + word_class_str};
+  rows.push_back(StagingRow{StagingTable::phrase, key + ")"});
+  for (const std::string &comment : lang.comments)
+    rows.push_back(StagingRow{StagingTable::phrase_comment, key + ", '" + comment + "')"});
+  for (const std::string &abbreviation : lang.abbreviations)
+    rows.push_back(StagingRow{StagingTable::phrase_abbreviation, key + ", '" + abbreviation + "')"});
+}
+
+void StagingWriter::flush() {
+  if (!this->buffered_lines_) return;
+  pqxx::work query(*this->connection_);
+  for (size_t pos{0}; pos != this->rows_.size(); ++pos)
+    insert_rows(query, this->table_prefix_ + table_name(static_cast<StagingTable>(pos)), this->rows_[pos]);
+  query.commit();
+  this->buffered_lines_ = 0;
+}
+
+size_t StagingWriter::size() const noexcept { return this->buffered_lines_; }
+
+}  // scripts
+}  // translate
+}  // lgeorgieff
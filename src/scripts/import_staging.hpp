@@ -0,0 +1,164 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares the staging tables that are used by trlt-import for loading language resources in parallel
+//              and for applying the deltas of an incremental import.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// Loading design
+// ==============
+//
+// The tables phrase, comment and abbreviation are shared by all language resources, e.g. a German phrase is inserted
+// by DE-EN.txt as well as by DE-FR.txt. Inserting them concurrently from several connections with "INSERT ... WHERE
+// NOT EXISTS" races on the unique constraints of these tables. Therefore an import is split into two phases:
+//  1. All language resources are parsed in parallel and each worker writes its rows over its own connection into the
+//     unlogged staging tables import_phrase, import_phrase_comment, import_phrase_abbreviation and
+//     import_translation. These tables have no constraints, i.e. there is nothing to conflict on.
+//  2. A single transaction merges the staging tables into the actual tables with one set based statement per table.
+//     Since only one writer touches the shared tables, no unique constraint can be violated and the new data becomes
+//     visible atomically.
+//
+// An incremental import additionally writes all rows of removed lines into the staging tables
+// import_removed_phrase, import_removed_phrase_comment, import_removed_phrase_abbreviation and
+// import_removed_translation. The same transaction that merges the new rows first deletes these rows from the actual
+// tables. Readers keep seeing the old data until this transaction is committed.
+//
+// Finally, the same transaction fills the search key phrase_key of all new phrases and replaces the rows of the
+// denormalized table translation_lookup for every phrase that is referenced by a staging table, so the lookup table
+// never diverges from the normalized tables.
+//
+// The same transaction also sends a notification on the channel trlt_data_changed with all affected languages, so a
+// running trlt.service evicts the cached responses of these languages right when the transaction is committed.
+// ====================================================================================================================
+
+#ifndef IMPORT_STAGING_HPP_
+#define IMPORT_STAGING_HPP_
+
+#include "dict_parser.hpp"
+
+#include <pqxx/pqxx>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lgeorgieff {
+namespace translate {
+namespace scripts {
+
+// The kinds of staging tables, i.e. the kinds of rows a line of a language resource is split into.
+enum class StagingTable : unsigned char { phrase = 0, phrase_comment, phrase_abbreviation, translation };
+
+// A row of a staging table, the values are an SQL value list, e.g. "('Haus', 'DE', 'n', null, 'noun')".
+struct StagingRow {
+  StagingTable table;
+  std::string values;
+};
+
+typedef std::vector<StagingRow> staging_rows;
+
+// A static class that creates, merges and drops the staging tables of an import.
+class ImportStaging {
+ public:
+  // The name prefix of the staging tables that hold new rows.
+  static const std::string INSERTED;
+  // The name prefix of the staging tables that hold rows of removed lines.
+  static const std::string REMOVED;
+  // The notification channel that trlt.service listens on, see Server::DATA_CHANGED_CHANNEL.
+  static const std::string DATA_CHANGED_CHANNEL;
+
+  // Creates all staging tables. Existing staging tables of an aborted import are dropped before.
+  static void create_tables(pqxx::connection_base &);
+  // Drops all staging tables.
+  static void drop_tables(pqxx::connection_base &);
+  // Applies the content of all staging tables to the actual tables of the data base within the passed transaction,
+  // i.e. removes the rows of removed lines, merges the new rows, fills missing phrase keys and refreshes the affected
+  // rows of the table translation_lookup. Finally, the affected languages are notified.
+  static void apply_tables(pqxx::transaction_base &);
+
+ private:
+  // Deletes the content of all removal staging tables from the actual tables of the data base within the passed
+  // transaction. Phrases, comments and abbreviations are only deleted if they are not referenced anymore.
+  static void remove_tables(pqxx::transaction_base &);
+  // Merges the content of all staging tables into the actual tables of the data base within the passed transaction.
+  static void merge_tables(pqxx::transaction_base &);
+  // Computes the column phrase_key of all phrases without a key, e.g. of new phrases or of phrases that were imported
+  // before the column existed, and copies the keys into the table translation_lookup.
+  static void fill_phrase_keys(pqxx::transaction_base &);
+  // Records the ids of all phrases that are referenced by the staging tables with the passed prefix in the temporary
+  // table import_affected_phrase, each id once.
+  static void collect_affected_phrases(pqxx::transaction_base &, const std::string &);
+  // Replaces all rows of the table translation_lookup that belong to an affected phrase.
+  static void refresh_translation_lookup(pqxx::transaction_base &);
+  // Sends the ids of all languages of the staging tables, separated by spaces, on DATA_CHANGED_CHANNEL. The
+  // notification is delivered when the passed transaction is committed, nothing is sent if there are no languages.
+  static void notify_changes(pqxx::transaction_base &);
+
+  ImportStaging() = delete;
+  ImportStaging(const ImportStaging &) = delete;
+  ImportStaging &operator=(const ImportStaging &) = delete;
+  ImportStaging(ImportStaging &&) = delete;
+  ImportStaging &operator=(ImportStaging &&) = delete;
+  ~ImportStaging() = delete;
+};  // ImportStaging
+
+// Buffers parsed language items and writes them in batches into the staging tables.
+class StagingWriter {
+ public:
+  // The number of buffered lines that causes an automatic flush.
+  static const size_t DEFAULT_BATCH_SIZE;
+
+  // Instantiates a writer that uses the passed connection and writes into the staging tables with the passed name
+  // prefix. The connection must outlive this instance.
+  explicit StagingWriter(pqxx::connection_base &, const std::string & = ImportStaging::INSERTED,
+                         size_t = DEFAULT_BATCH_SIZE);
+  StagingWriter(const StagingWriter &) = delete;
+  StagingWriter(StagingWriter &&) = default;
+  StagingWriter &operator=(const StagingWriter &) = delete;
+  StagingWriter &operator=(StagingWriter &&) = default;
+  ~StagingWriter() = default;
+
+  // Appends the staging rows of the passed translation pair to the passed container.
+  static void to_rows(const LangItem &, const LangItem &, staging_rows &);
+
+  // Buffers the rows for the passed translation pair and flushes the buffer if the batch size is reached.
+  void add(const LangItem &, const LangItem &);
+  // Buffers the passed rows of a single line and flushes the buffer if the batch size is reached.
+  void add(const staging_rows &);
+  // Writes all buffered rows into the staging tables.
+  void flush();
+  // Returns the number of lines that are currently buffered.
+  size_t size() const noexcept;
+
+ private:
+  // Appends the rows of the tables phrase, phrase_comment and phrase_abbreviation to the passed container.
+  static void add_language_item(const LangItem &, const std::string &, staging_rows &);
+
+  pqxx::connection_base *connection_;
+  std::string table_prefix_;
+  size_t batch_size_;
+  size_t buffered_lines_;
+  staging_rows line_rows_;
+  // The buffered values of each staging table, indexed by StagingTable.
+  std::array<std::vector<std::string>, 4> rows_;
+};  // StagingWriter
+
+}  // scripts
+}  // translate
+}  // lgeorgieff
+
+#endif  // IMPORT_STAGING_HPP_
@@ -0,0 +1,123 @@
+#! /bin/sh
+
+#######################################################################################################################
+# Copyright (C) 2015  Lukas Georgieff
+# Last modified: 10/19/2026
+# Description: Applies all pending schema migrations from the migrations folder to the specified data base. Each
+#              migration is applied in its own transaction and recorded in the table schema_migration, so every
+#              migration is applied exactly once.
+#######################################################################################################################
+
+
+#######################################################################################################################
+# This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+# License as published by the Free Software Foundation in version 2.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+# warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+# Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#######################################################################################################################
+
+
+### Definition of all used variables
+SCRIPT_NAME=$(basename ${0})
+MIGRATION_PATTERN="[0-9][0-9][0-9]_*.sql"
+MIGRATION_DIRECTORY=$(realpath $(dirname ${0})/migrations)
+PGSQL_OPTIONS="--dbname translate --username translate"
+
+### Print the specified error message ($1) on stderr and exits with the
+### specified error code ($2).
+function error_exit {
+    echo "${1}" 1>&2
+    exit ${2}
+}
+
+
+### Print the usage of this script.
+function print_usage {
+    echo "This script applies all pending schema migrations to your data base."
+    echo ""
+    echo "Usage: ${0} [OPTION...]"
+    echo ""
+    echo "-h | --help                        Shows this help"
+    echo "-m | --migration-directory <dir>   The directory that contains the migration"
+    echo "                                   files. The default value is"
+    echo "                                   \"${MIGRATION_DIRECTORY}\""
+    echo "-p | --pgsql-options <options>     Options for the data base to which the"
+    echo "                                   migrations are applied. The default"
+    echo "                                   value is"
+    echo "                                   --dbname translate --username translate"
+    echo ""
+}
+
+
+### Process all command line arguments and set the corresponding variables.
+function process_arguments {
+    while [[ $# > 0 ]]
+    do
+        key="$1"
+        case "${key}" in
+            "--migration-directory"|"-m")
+                shift
+                MIGRATION_DIRECTORY="$1"
+                ;;
+            "--pgsql-options"|"-p")
+                shift
+                PGSQL_OPTIONS="$1"
+                ;;
+            "--help"|"-h")
+                print_usage
+                exit 0
+                ;;
+            *)
+                echo "Unknown argument ${key}"
+                echo "For more information run \"${SCRIPT_NAME} --help\""
+                error_exit "" 1
+                ;;
+        esac
+        shift
+    done
+}
+
+### Create the table that records all applied migrations if it does not exist yet.
+function init_migration_table {
+    error_message="$(psql $PGSQL_OPTIONS -q -c "SET client_min_messages TO WARNING; CREATE TABLE IF NOT EXISTS schema_migration (version char(3) NOT NULL PRIMARY KEY, applied_at timestamp NOT NULL DEFAULT now());" 2>&1)"
+    if [ "0" != "$(echo $?)" ] || [ "" != "${error_message}" ]
+    then
+        echo "${error_message}"
+        error_exit "Could not create the table schema_migration" 1
+    fi
+}
+
+### Apply all migrations in the migration directory that are not recorded in the table schema_migration.
+### The migrations are applied in the order of their version, i.e. the first three digits of the file name.
+function apply_migrations {
+    if [ ! -d "${MIGRATION_DIRECTORY}" ]
+    then
+        error_exit "The migration directory ${MIGRATION_DIRECTORY} does not exist!" 1
+    fi
+    for file in $(find "${MIGRATION_DIRECTORY}" -maxdepth 1 -name "${MIGRATION_PATTERN}" | sort)
+    do
+        version=$(echo $(basename "${file}") | grep -o "^...")
+        applied="$(psql $PGSQL_OPTIONS -q -t -A -c "SELECT count(*) FROM schema_migration WHERE version = '${version}';" 2>&1)"
+        if [ "0" != "${applied}" ]
+        then
+            continue
+        fi
+        echo "Applying migration $(basename ${file}) ..."
+        error_message="$( (cat "${file}"; echo "INSERT INTO schema_migration (version) VALUES ('${version}');") | psql $PGSQL_OPTIONS --single-transaction -v ON_ERROR_STOP=1 -q 2>&1)"
+        if [ "0" != "$(echo $?)" ] || [ "" != "${error_message}" ]
+        then
+            echo "${error_message}"
+            error_exit "Could not apply migration ${file}" 1
+        fi
+    done
+}
+
+
+### The actual calls
+process_arguments "$@"
+init_migration_table
+apply_migrations
@@ -0,0 +1,40 @@
+/*
+#######################################################################################################################
+# Copyright (C) 2015  Lukas Georgieff
+# Last modified: 10/19/2026
+# Description: Adds the indexes required by the access paths of DbQuery and of the incremental import.
+#              Usage: ./migrate_db.sh (applies all pending migrations)
+#######################################################################################################################
+
+
+#######################################################################################################################
+# This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+# License as published by the Free Software Foundation in version 2.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+# warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+# Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#######################################################################################################################
+*/
+
+/*
+#######################################################################################################################
+### The lookups by phrase_id_in, by phrase_id of phrase_comment and phrase_abbreviation and by (phrase, language) of
+### phrase are already served by the unique constraints, since these columns are their leading columns. Only the
+### reverse directions that are used for deleting and refreshing rows have no index yet.
+#######################################################################################################################
+*/
+CREATE INDEX phrase_translation_phrase_id_out_index ON phrase_translation (phrase_id_out);
+CREATE INDEX phrase_comment_comment_id_index ON phrase_comment (comment_id);
+CREATE INDEX phrase_abbreviation_abbreviation_id_index ON phrase_abbreviation (abbreviation_id);
+
+/*
+#######################################################################################################################
+### Case insensitive lookups by name compare lower(name), see DbQuery::request_*_by_name.
+#######################################################################################################################
+*/
+CREATE INDEX language_lower_name_index ON language (lower(name));
+CREATE INDEX word_class_description_lower_name_index ON word_class_description (lower(name));
+CREATE INDEX gender_description_lower_name_index ON gender_description (lower(name));
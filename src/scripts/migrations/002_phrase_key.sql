@@ -0,0 +1,70 @@
+/*
+#######################################################################################################################
+# Copyright (C) 2015  Lukas Georgieff
+# Last modified: 10/19/2026
+# Description: Adds the case and diacritic insensitive search key phrase_key to the phrases and to translation_lookup.
+#              Usage: ./migrate_db.sh (applies all pending migrations)
+#######################################################################################################################
+
+
+#######################################################################################################################
+# This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+# License as published by the Free Software Foundation in version 2.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+# warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+# Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#######################################################################################################################
+*/
+
+/*
+#######################################################################################################################
+### The key is computed by utils::to_phrase_key at import time, i.e. by dict2sql and by trlt-import, since SQL has no
+### equivalent of this function. Existing phrases keep a NULL key until the next run of trlt-import, which fills all
+### missing keys. Until then trlt.service matches phrases without key literally, i.e. as before this migration, so
+### lookups keep working but are not yet case and diacritic insensitive for these phrases.
+#######################################################################################################################
+*/
+ALTER TABLE phrase ADD COLUMN phrase_key varchar(256);
+CREATE INDEX phrase_phrase_key_index ON phrase (language, phrase_key);
+CREATE INDEX phrase_missing_phrase_key_index ON phrase (id) WHERE phrase_key IS NULL;
+
+/*
+#######################################################################################################################
+### New columns of a view must be appended, so phrase_key_in is the last column of translation_lookup_source and of
+### translation_lookup.
+#######################################################################################################################
+*/
+CREATE OR REPLACE VIEW translation_lookup_source AS
+SELECT
+pt.phrase_id_in,
+pt.phrase_id_out,
+ph_in.language AS language_in,
+ph_out.language AS language_out,
+ph_in.phrase AS phrase_in,
+ph_in.word_class,
+ph_in.gender AS gender_in,
+ph_in.numerus AS numerus_in,
+array_to_json(ARRAY(SELECT ab.abbreviation FROM phrase_abbreviation pa
+                    JOIN abbreviation ab ON ab.id = pa.abbreviation_id
+                    WHERE pa.phrase_id = ph_in.id ORDER BY ab.abbreviation)) AS abbreviations_in,
+array_to_json(ARRAY(SELECT co.comment FROM phrase_comment pc JOIN comment co ON co.id = pc.comment_id
+                    WHERE pc.phrase_id = ph_in.id ORDER BY co.comment)) AS comments_in,
+ph_out.phrase AS phrase_out,
+ph_out.word_class AS word_class_out,
+ph_out.gender AS gender_out,
+ph_out.numerus AS numerus_out,
+array_to_json(ARRAY(SELECT ab.abbreviation FROM phrase_abbreviation pa
+                    JOIN abbreviation ab ON ab.id = pa.abbreviation_id
+                    WHERE pa.phrase_id = ph_out.id ORDER BY ab.abbreviation)) AS abbreviations_out,
+array_to_json(ARRAY(SELECT co.comment FROM phrase_comment pc JOIN comment co ON co.id = pc.comment_id
+                    WHERE pc.phrase_id = ph_out.id ORDER BY co.comment)) AS comments_out,
+ph_in.phrase_key AS phrase_key_in
+FROM phrase_translation pt
+JOIN phrase ph_in ON ph_in.id = pt.phrase_id_in
+JOIN phrase ph_out ON ph_out.id = pt.phrase_id_out;
+
+ALTER TABLE translation_lookup ADD COLUMN phrase_key_in varchar(256);
+CREATE INDEX translation_lookup_phrase_key_index ON translation_lookup (language_in, language_out, phrase_key_in);
@@ -2,10 +2,12 @@
 
 #######################################################################################################################
 # Copyright (C) 2015  Lukas Georgieff
-# Last modified: 04/05/2015
+# Last modified: 10/19/2026
 # Description: Calls the programme dict2sql for all language resources to dump them into SQL files. Finally, these
 #              files are written into the specified data base.
 #              Be carefull when runnig this script, since your data base will be set to an initial (= empty) state.
+#              Finally, a notification on the channel trlt_data_changed with an empty payload tells a running
+#              trlt.service that all languages changed, so it evicts its cached responses and rebuilds its indexes.
 #######################################################################################################################
 
 
@@ -32,6 +34,8 @@ STRICT_MODE="false"
 DUMPER_SCRIPT=$(realpath ./dict2sql)
 SQL_INIT_SCRIPT=$(realpath ./create_schema.sql)
 SQL_CLEANUP_SCRIPT=$(realpath ./drop_schema.sql)
+MIGRATION_SCRIPT=$(realpath ./migrate_db.sh)
+DATA_CHANGED_CHANNEL="trlt_data_changed"
 
 ### Delete all temporary files and folders.
 function clean_up {
@@ -176,6 +180,14 @@ function check_dependencies {
         clean_up
         exit 1       
     fi
+    if [ ! -x "${MIGRATION_SCRIPT}" ]
+    then
+        echo "The file ${MIGRATION_SCRIPT} does not exist or is not set as executable!" 1>&2
+        echo "To continue checkout this file from the git repository\"." 1>&2
+        echo "Finally, run this script again." 1>&2
+        clean_up
+        exit 1
+    fi
     if [ ! -f "${SQL_CLEANUP_SCRIPT}" ]
     then
         echo "The file ${SQL_CLEANUP_SCRIPT} does not exist!" 1>&2
@@ -250,11 +262,47 @@ function init_db {
     fi
 }
 
+### Apply all schema migrations, e.g. additional indexes and columns. They are applied before the import, since the
+### SQL files of dict2sql already fill the column phrase_key.
+function migrate_db {
+    echo "Migrating data base ..."
+    if ! ${MIGRATION_SCRIPT} --pgsql-options "${PGSQL_OPTIONS}"
+    then
+        error_exit "Could not migrate data base" 1
+    fi
+}
+
+### Fill the denormalized table translation_lookup from all imported translations.
+function build_translation_lookup {
+    echo "Building translation lookup table ..."
+    error_message="$(psql $PGSQL_OPTIONS -q -c "TRUNCATE translation_lookup; INSERT INTO translation_lookup SELECT * FROM translation_lookup_source; ANALYZE translation_lookup;" 2>&1)"
+    if [ "0" != "$(echo $?)" ] || [ "" != "${error_message}" ]
+    then
+        echo "${error_message}"
+        error_exit "Could not build the translation lookup table" 1
+    fi
+}
+
+### Notify a running trlt.service that the data of all languages changed, see Server::DATA_CHANGED_CHANNEL. An empty
+### payload denotes all languages.
+function notify_data_changed {
+    echo "Notifying ${DATA_CHANGED_CHANNEL} ..."
+    error_message="$(psql $PGSQL_OPTIONS -q -c "NOTIFY ${DATA_CHANGED_CHANNEL};" 2>&1)"
+    if [ "0" != "$(echo $?)" ] || [ "" != "${error_message}" ]
+    then
+        echo "${error_message}"
+        error_exit "Could not notify ${DATA_CHANGED_CHANNEL}" 1
+    fi
+}
+
 
 ### The actual calls
 process_arguments "$@"
 check_tmp_folder
 check_dependencies
 init_db
+migrate_db
 dump_files_to_sql
+build_translation_lookup
+notify_data_changed
 clean_up
@@ -0,0 +1,490 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements the programme trlt-import that finds all language resources in a directory, parses them on
+//              a thread pool and loads them over several data base connections at once into the data base. In
+//              incremental mode only lines that changed since the last run are applied.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "dict_parser.hpp"
+#include "import_manifest.hpp"
+#include "import_staging.hpp"
+#include "server/connection_string.hpp"
+#include "utils/command_line_exception.hpp"
+#include "utils/exception.hpp"
+#include "utils/helper.hpp"
+
+#include <pqxx/pqxx>
+
+#include <dirent.h>
+#include <fnmatch.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using lgeorgieff::translate::scripts::ImportManifest;
+using lgeorgieff::translate::scripts::ImportStaging;
+using lgeorgieff::translate::scripts::LangItem;
+using lgeorgieff::translate::scripts::ManifestEntry;
+using lgeorgieff::translate::scripts::StagingRow;
+using lgeorgieff::translate::scripts::StagingWriter;
+using lgeorgieff::translate::scripts::hash_row;
+using lgeorgieff::translate::scripts::hash_string;
+using lgeorgieff::translate::scripts::process_line;
+using lgeorgieff::translate::scripts::staging_rows;
+using lgeorgieff::translate::server::ConnectionString;
+using lgeorgieff::translate::utils::CommandLineException;
+using lgeorgieff::translate::utils::Exception;
+using lgeorgieff::translate::utils::get_exe_path;
+using lgeorgieff::translate::utils::string_to_size_t;
+
+// A language resource file, e.g. ".../DE-EN.txt".
+struct LanguageResource {
+  std::string path;
+  std::string name;
+  std::string language_in;
+  std::string language_out;
+  size_t size;
+};
+
+ConnectionString connection_string;
+std::string resource_directory{"."};
+std::string resource_pattern{"[A-Z][A-Z]-[A-Z][A-Z].txt"};
+size_t jobs{std::max(1U, std::thread::hardware_concurrency())};
+bool strict_mode{false};
+bool init_schema{false};
+bool incremental{false};
+std::string manifest_directory;
+
+const std::string MANIFEST_SUFFIX{".manifest"};
+// The suffix of manifests that are written by the current run. They replace the old ones after a successful import.
+const std::string NEW_MANIFEST_SUFFIX{".new"};
+
+// Serializes the progress messages of all worker threads.
+std::mutex output_mutex;
+
+// The staging rows of all removed lines mapped by their fact hash.
+ImportManifest::removed_rows_type removed_rows;
+std::mutex removed_rows_mutex;
+
+// Returns the usage instructions for this programme.
+std::string get_usage(const std::string &programme_name) {
+  return programme_name +
+         " populates the data base with values from dict.cc resources.\n"
+         "All resources are parsed in parallel and loaded over several data base\n"
+         "connections at once.\n\n"
+         "synopsis:\n"
+         "-h | --help                        Prints this dialogue\n"
+         "-d | --resource-directory <dir>    The directory that is searched for the\n"
+         "                                   language resource files, default: \".\"\n"
+         "-r | --resource-pattern <pattern>  The file name pattern of the language\n"
+         "                                   resources, default:\n"
+         "                                   \"[A-Z][A-Z]-[A-Z][A-Z].txt\"\n"
+         "-j | --jobs <number>               The number of worker threads and data\n"
+         "                                   base connections, default: the number\n"
+         "                                   of available cores\n"
+         "-s | --strict-mode                 Every error in the language resource\n"
+         "                                   files aborts the import\n"
+         "-i | --init-schema                 Drops and recreates the data base\n"
+         "                                   schema before the import.\n"
+         "                                   WARNING: all data will be deleted\n"
+         "-I | --incremental                 Only imports lines that were added or\n"
+         "                                   removed since the last run\n"
+         "-m | --manifest-directory <dir>    The directory that holds the manifests\n"
+         "                                   of the last run, default:\n"
+         "                                   \"<resource directory>/manifest\"\n"
+         "-u | --db-username <username>      Sets the DB user name\n"
+         "-c | --db-password <password>      Sets the DB password\n"
+         "--db <name>                        Sets the data base name\n"
+         "--db-host <host name>              Sets the host name (DNS) of the data\n"
+         "                                   base server\n"
+         "--db-address <address>             Sets the host address (IP) of the data\n"
+         "                                   base server\n"
+         "--db-port <port>                   Sets the port of the data base server\n";
+}
+
+// Processes all command line arguments and sets the corresponding configuration values.
+bool process_cmd_arguments(const int argc, const char **argv) {
+  bool db_host_set{false};
+  bool db_addr_set{false};
+  for (int pos{1}; pos < argc; ++pos) {
+    if (!strcmp("-h", argv[pos]) || !strcmp("--help", argv[pos])) {
+      std::cout << get_usage(argv[0]) << std::endl;
+      return true;
+    } else if ((!strcmp("-d", argv[pos]) || !strcmp("--resource-directory", argv[pos])) && pos != argc - 1) {
+      resource_directory = argv[++pos];
+    } else if ((!strcmp("-r", argv[pos]) || !strcmp("--resource-pattern", argv[pos])) && pos != argc - 1) {
+      resource_pattern = argv[++pos];
+    } else if ((!strcmp("-j", argv[pos]) || !strcmp("--jobs", argv[pos])) && pos != argc - 1) {
+      try {
+        jobs = string_to_size_t(argv[++pos]);
+      } catch (const std::invalid_argument &) {
+        throw CommandLineException(std::string("The value \"") + argv[pos] + "\" is not a valid number of jobs!");
+      }
+      if (!jobs) throw CommandLineException("The number of jobs must be greater than 0!");
+    } else if (!strcmp("-s", argv[pos]) || !strcmp("--strict-mode", argv[pos])) {
+      strict_mode = true;
+    } else if (!strcmp("-i", argv[pos]) || !strcmp("--init-schema", argv[pos])) {
+      init_schema = true;
+    } else if (!strcmp("-I", argv[pos]) || !strcmp("--incremental", argv[pos])) {
+      incremental = true;
+    } else if ((!strcmp("-m", argv[pos]) || !strcmp("--manifest-directory", argv[pos])) && pos != argc - 1) {
+      manifest_directory = argv[++pos];
+    } else if ((!strcmp("-u", argv[pos]) || !strcmp("--db-username", argv[pos])) && pos != argc - 1) {
+      connection_string.user(argv[++pos]);
+    } else if ((!strcmp("-c", argv[pos]) || !strcmp("--db-password", argv[pos])) && pos != argc - 1) {
+      connection_string.password(argv[++pos]);
+    } else if (!strcmp("--db-host", argv[pos]) && pos != argc - 1) {
+      if (db_addr_set)
+        throw CommandLineException(
+            "The option \"--db-host\" cannot be used together with the option \"--db-address\"!");
+      connection_string.hostaddr("");
+      connection_string.host(argv[++pos]);
+      db_host_set = true;
+    } else if (!strcmp("--db-address", argv[pos]) && pos != argc - 1) {
+      if (db_host_set)
+        throw CommandLineException(
+            "The option \"--db-address\" cannot be used together with the option \"--db-host\"!");
+      connection_string.hostaddr(argv[++pos]);
+      db_addr_set = true;
+    } else if (!strcmp("--db", argv[pos]) && pos != argc - 1) {
+      connection_string.dbname(argv[++pos]);
+    } else if (!strcmp("--db-port", argv[pos]) && pos != argc - 1) {
+      try {
+        connection_string.port(string_to_size_t(argv[++pos]));
+      } catch (const std::invalid_argument &) {
+        throw CommandLineException(std::string("The value \"") + argv[pos] + "\" is not a valid port value!");
+      }
+    } else {
+      throw CommandLineException(std::string("The option \"") + argv[pos] + "\" is not supported!");
+    }
+  }  // for(int pos{1}; pos < argc; ++pos)
+  return false;
+}
+
+// Searches the passed directory recursively for files matching the passed pattern and appends them to resources.
+void find_language_resources(const std::string &directory, const std::string &pattern,
+                             std::vector<LanguageResource> &resources) {
+  DIR *dir{opendir(directory.c_str())};
+  if (!dir) throw Exception{"Cannot open the directory \"" + directory + "\"!"};
+  for (dirent *entry{readdir(dir)}; entry; entry = readdir(dir)) {
+    if (!strcmp(".", entry->d_name) || !strcmp("..", entry->d_name)) continue;
+    std::string path{directory + "/" + entry->d_name};
+    struct stat file_status;
+    if (stat(path.c_str(), &file_status)) continue;
+    if (S_ISDIR(file_status.st_mode)) {
+      find_language_resources(path, pattern, resources);
+    } else if (S_ISREG(file_status.st_mode) && !fnmatch(pattern.c_str(), entry->d_name, 0)) {
+      std::string name{entry->d_name};
+      if (name.size() < 5 || '-' != name[2]) {
+        closedir(dir);
+        throw Exception{"The file name \"" + name + "\" does not start with \"<language id>-<language id>\"!"};
+      }
+      resources.push_back(LanguageResource{path, name, name.substr(0, 2), name.substr(3, 2),
+                                           static_cast<size_t>(file_status.st_size)});
+    }
+  }
+  closedir(dir);
+}
+
+// Returns the content of the passed file.
+std::string read_file(const std::string &path) {
+  std::ifstream in{path, std::ifstream::in};
+  if (!in) throw Exception{"Cannot read the file \"" + path + "\"!"};
+  return std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+// Drops and recreates the data base schema by using the SQL scripts next to this programme.
+void initialize_schema() {
+  std::string drop_script{read_file(get_exe_path() + "drop_schema.sql")};
+  std::string create_script{read_file(get_exe_path() + "create_schema.sql")};
+  pqxx::connection connection{connection_string.to_string()};
+  try {
+    pqxx::work query(connection);
+    query.exec(drop_script);
+    query.commit();
+  } catch (const pqxx::sql_error &) {
+    // the schema does not exist yet
+  }
+  pqxx::work query(connection);
+  query.exec(create_script);
+  query.commit();
+}
+
+// Applies all schema migrations from the folder migrations next to this programme that are not recorded in the table
+// schema_migration yet, equal to migrate_db.sh. Each migration is applied in its own transaction.
+void apply_migrations() {
+  const std::string directory{get_exe_path() + "migrations"};
+  std::vector<std::string> migrations;
+  DIR *dir{opendir(directory.c_str())};
+  if (!dir) throw Exception{"Cannot open the directory \"" + directory + "\"!"};
+  for (dirent *entry{readdir(dir)}; entry; entry = readdir(dir))
+    if (!fnmatch("[0-9][0-9][0-9]_*.sql", entry->d_name, 0)) migrations.push_back(entry->d_name);
+  closedir(dir);
+  std::sort(migrations.begin(), migrations.end());
+
+  pqxx::connection connection{connection_string.to_string()};
+  pqxx::nontransaction init(connection);
+  init.exec(
+      "CREATE TABLE IF NOT EXISTS schema_migration "
+      "(version char(3) NOT NULL PRIMARY KEY, applied_at timestamp NOT NULL DEFAULT now());");
+  init.commit();
+  for (const std::string &migration : migrations) {
+    const std::string version{migration.substr(0, 3)};
+    pqxx::work query(connection);
+    if (!query.exec("SELECT version FROM schema_migration WHERE version = " + query.quote(version) + ";").empty())
+      continue;
+    std::cout << "Applying migration " << migration << " ..." << std::endl;
+    query.exec(read_file(directory + "/" + migration));
+    query.exec("INSERT INTO schema_migration (version) VALUES (" + query.quote(version) + ");");
+    query.commit();
+  }
+}
+
+// Returns the path of the manifest of the passed language resource.
+std::string manifest_path(const LanguageResource &resource) {
+  return manifest_directory + "/" + resource.name + MANIFEST_SUFFIX;
+}
+
+// Parses the passed language resource and writes all new entries via the passed writer into the staging tables. All
+// lines are recorded in a new manifest. In incremental mode, lines that are already listed in the manifest of the last
+// run are skipped and the rows of lines that are not part of the resource anymore are collected in removed_rows.
+void load_language_resource(const LanguageResource &resource, StagingWriter &writer) {
+  std::ifstream in{resource.path, std::ifstream::in};
+  if (!in) throw Exception{"Cannot read the file \"" + resource.path + "\"!"};
+  ImportManifest old_manifest;
+  if (incremental) old_manifest.load(manifest_path(resource));
+  std::string new_manifest_path{manifest_path(resource) + NEW_MANIFEST_SUFFIX};
+  std::ofstream new_manifest{new_manifest_path, std::ofstream::out | std::ofstream::trunc};
+  if (!new_manifest) throw Exception{"Cannot write the manifest \"" + new_manifest_path + "\"!"};
+
+  typedef std::chrono::steady_clock clock;
+  clock::duration load_time{};
+  clock::time_point start{clock::now()};
+  std::string line;
+  size_t line_counter{0};
+  size_t entry_counter{0};
+  LangItem lang_item_1, lang_item_2;
+  staging_rows rows;
+  ManifestEntry entry;
+  while (std::getline(in, line)) {
+    ++line_counter;
+    uint64_t line_hash{hash_string(line)};
+    if (!old_manifest.take_line(line_hash, new_manifest)) continue;
+    entry.facts.clear();
+    entry.line = line;
+    if (process_line(line, resource.language_in, resource.language_out, line_counter, strict_mode, lang_item_1,
+                     lang_item_2)) {
+      ++entry_counter;
+      rows.clear();
+      StagingWriter::to_rows(lang_item_1, lang_item_2, rows);
+      for (const StagingRow &row : rows) entry.facts.push_back(hash_row(row));
+      clock::time_point load_start{clock::now()};
+      writer.add(rows);
+      load_time += clock::now() - load_start;
+    }
+    ImportManifest::write_entry(new_manifest, line_hash, entry);
+  }
+  if (in.bad()) throw Exception{"Failed to read from \"" + resource.path + "\"!"};
+  new_manifest.close();
+  if (!new_manifest) throw Exception{"Failed to write the manifest \"" + new_manifest_path + "\"!"};
+  clock::time_point load_start{clock::now()};
+  writer.flush();
+  load_time += clock::now() - load_start;
+
+  // All entries of the old manifest that were not found in the resource belong to removed lines.
+  ImportManifest::removed_rows_type resource_removed_rows;
+  size_t removed_counter{
+      old_manifest.collect_removed_rows(resource.language_in, resource.language_out, resource_removed_rows)};
+  {
+    std::lock_guard<std::mutex> lock{removed_rows_mutex};
+    removed_rows.insert(std::make_move_iterator(resource_removed_rows.begin()),
+                        std::make_move_iterator(resource_removed_rows.end()));
+  }
+
+  double total_seconds{std::chrono::duration<double>(clock::now() - start).count()};
+  double load_seconds{std::chrono::duration<double>(load_time).count()};
+  double megabytes{resource.size / (1024.0 * 1024.0)};
+  std::lock_guard<std::mutex> lock{output_mutex};
+  std::cout << std::fixed << std::setprecision(1) << resource.name << ": " << line_counter << " lines, +"
+            << entry_counter << "/-" << removed_counter << " entries, " << megabytes << " MB in " << total_seconds
+            << " s (parse " << total_seconds - load_seconds << " s, load " << load_seconds << " s) => "
+            << std::setprecision(0) << (total_seconds > 0 ? line_counter / total_seconds : 0) << " lines/s, "
+            << std::setprecision(2) << (total_seconds > 0 ? megabytes / total_seconds : 0) << " MB/s" << std::endl;
+}
+
+// The function that is run by each worker thread. Each worker owns a data base connection and takes the next
+// unprocessed language resource until all resources are processed or another worker failed.
+void run_worker(const std::vector<LanguageResource> &resources, std::atomic<size_t> &next_resource,
+                std::atomic<bool> &failed) {
+  try {
+    pqxx::connection connection{connection_string.to_string()};
+    StagingWriter writer{connection};
+    for (size_t pos{next_resource++}; pos < resources.size() && !failed; pos = next_resource++)
+      load_language_resource(resources[pos], writer);
+  } catch (const std::exception &err) {
+    failed = true;
+    std::lock_guard<std::mutex> lock{output_mutex};
+    std::cerr << "Import failed: " << err.what() << std::endl;
+  }
+}
+
+// Returns the paths of all files in the manifest directory that end with the passed suffix.
+std::vector<std::string> find_manifests(const std::string &suffix) {
+  std::vector<std::string> result;
+  DIR *dir{opendir(manifest_directory.c_str())};
+  if (!dir) throw Exception{"Cannot open the directory \"" + manifest_directory + "\"!"};
+  for (dirent *entry{readdir(dir)}; entry; entry = readdir(dir)) {
+    std::string name{entry->d_name};
+    if (name.size() > suffix.size() && !name.compare(name.size() - suffix.size(), suffix.size(), suffix))
+      result.push_back(manifest_directory + "/" + name);
+  }
+  closedir(dir);
+  return result;
+}
+
+// Writes all collected rows of removed lines into the removal staging tables. A row is skipped if any line of any
+// language resource still produces it, e.g. a translation of a line whose comment was changed.
+size_t stage_removed_rows(pqxx::connection_base &connection) {
+  if (removed_rows.empty()) return 0;
+  for (const std::string &path : find_manifests(MANIFEST_SUFFIX + NEW_MANIFEST_SUFFIX))
+    ImportManifest::keep_facts(path, removed_rows);
+  // manifests of resources that are not part of this run are still valid
+  for (const std::string &path : find_manifests(MANIFEST_SUFFIX)) {
+    struct stat file_status;
+    if (stat((path + NEW_MANIFEST_SUFFIX).c_str(), &file_status)) ImportManifest::keep_facts(path, removed_rows);
+  }
+
+  StagingWriter writer{connection, ImportStaging::REMOVED};
+  staging_rows rows(1);
+  for (std::pair<const uint64_t, StagingRow> &removed_row : removed_rows) {
+    rows[0] = std::move(removed_row.second);
+    writer.add(rows);
+  }
+  writer.flush();
+  return removed_rows.size();
+}
+
+// Replaces the manifests of the last run by the manifests of this run. If the schema was initialized, the manifests
+// of all resources that are not part of this run are deleted, since their content is not in the data base anymore.
+void publish_manifests() {
+  if (init_schema) {
+    for (const std::string &path : find_manifests(MANIFEST_SUFFIX)) std::remove(path.c_str());
+  }
+  for (const std::string &path : find_manifests(MANIFEST_SUFFIX + NEW_MANIFEST_SUFFIX)) {
+    std::string target{path.substr(0, path.size() - NEW_MANIFEST_SUFFIX.size())};
+    if (std::rename(path.c_str(), target.c_str()))
+      throw Exception{"Cannot rename the manifest \"" + path + "\" to \"" + target + "\"!"};
+  }
+}
+
+// Deletes all manifests that were written by this run.
+void discard_manifests() {
+  for (const std::string &path : find_manifests(MANIFEST_SUFFIX + NEW_MANIFEST_SUFFIX)) std::remove(path.c_str());
+}
+
+// The entry point for this programme.
+int main(const int argc, const char **argv) {
+  try {
+    if (process_cmd_arguments(argc, argv)) return 0;
+  } catch (const CommandLineException &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << "Use \"" << argv[0] << " -h\" to see the usage instructions for " << argv[0] << std::endl;
+    return 1;
+  }
+  if (incremental && init_schema) {
+    std::cerr << "The option \"--incremental\" cannot be used together with the option \"--init-schema\"!"
+              << std::endl;
+    return 1;
+  }
+  if (manifest_directory.empty()) manifest_directory = resource_directory + "/manifest";
+
+  try {
+    std::vector<LanguageResource> resources;
+    find_language_resources(resource_directory, resource_pattern, resources);
+    if (resources.empty()) {
+      std::cerr << "No language resources matching \"" << resource_pattern << "\" found in \"" << resource_directory
+                << "\"!" << std::endl;
+      return 1;
+    }
+    // The biggest resources are scheduled first, so no worker starts a huge file when all others are done.
+    std::sort(resources.begin(), resources.end(),
+              [](const LanguageResource &lft, const LanguageResource &rgt) { return lft.size > rgt.size; });
+    if (mkdir(manifest_directory.c_str(), 0755) && EEXIST != errno)
+      throw Exception{"Cannot create the directory \"" + manifest_directory + "\"!"};
+    discard_manifests();
+
+    if (init_schema) {
+      std::cout << "Initializing data base ..." << std::endl;
+      initialize_schema();
+    }
+    apply_migrations();
+
+    pqxx::connection connection{connection_string.to_string()};
+    ImportStaging::create_tables(connection);
+
+    typedef std::chrono::steady_clock clock;
+    clock::time_point start{clock::now()};
+    std::cout << "Loading " << resources.size() << " language resources with " << jobs << " jobs ..." << std::endl;
+    std::atomic<size_t> next_resource{0};
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> workers;
+    for (size_t i{0}; i != std::min(jobs, resources.size()); ++i)
+      workers.emplace_back(run_worker, std::cref(resources), std::ref(next_resource), std::ref(failed));
+    for (std::thread &worker : workers) worker.join();
+    if (failed) {
+      ImportStaging::drop_tables(connection);
+      discard_manifests();
+      return 1;
+    }
+    size_t removed_row_counter{stage_removed_rows(connection)};
+    if (incremental) std::cout << removed_row_counter << " rows of removed entries staged for deletion" << std::endl;
+
+    std::cout << "Merging staging tables ..." << std::endl;
+    clock::time_point merge_start{clock::now()};
+    pqxx::work query(connection);
+    ImportStaging::apply_tables(query);
+    query.commit();
+    publish_manifests();
+    ImportStaging::drop_tables(connection);
+    std::cout << std::fixed << std::setprecision(1) << "Merged in "
+              << std::chrono::duration<double>(clock::now() - merge_start).count() << " s, import finished in "
+              << std::chrono::duration<double>(clock::now() - start).count() << " s" << std::endl;
+  } catch (const std::exception &err) {
+    std::cerr << "Import failed: " << err.what() << std::endl;
+    discard_manifests();
+    return 1;
+  }
+  return 0;
+}
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 04/28/2015
+// Last modified: 10/19/2026
 // Description: Implements the DbQuery class that allows to query the data base for language information.
 // ====================================================================================================================
 
@@ -19,6 +19,7 @@
 #include "db_query.hpp"
 #include "connection_string.hpp"
 #include "db_exception.hpp"
+#include "utils/phrase_key.hpp"
 
 #include <pqxx/pqxx>
 #include <string>
@@ -42,31 +43,80 @@ bool DbQuery::empty() const { return this->query_result_.empty(); }
 
 void DbQuery::clear() { this->query_result_.clear(); }
 
-DbQuery::DbQuery(const ConnectionString& connection_string) : db_connection_{nullptr} {
+DbQuery::DbQuery(const ConnectionString& connection_string)
+    : db_connection_{nullptr}, translation_lookup_{false}, explain_{false}, stream_batch_size_{0} {
   this->db_connection_ = new pqxx::connection(connection_string.to_string());
   this->connection_self_created_ = true;
 }
 
 DbQuery::DbQuery(pqxx::connection* db_connection)
-    : db_connection_{db_connection}, query_result_{}, connection_self_created_{false} {
+    : db_connection_{db_connection}, query_result_{}, connection_self_created_{false}, translation_lookup_{false},
+      explain_{false}, stream_batch_size_{0} {
   if (!this->db_connection_) throw DbException("db_connection must not be a nullptr!");
 }
 
 DbQuery::~DbQuery() {
+  // an open stream must be closed before its connection
+  this->stream_transaction_.reset();
   if (this->connection_self_created_) {
     delete this->db_connection_;
     this->db_connection_ = nullptr;
   }
 }
 
-DbQuery& DbQuery::request_phrase(const string& phrase_in, const string& language_in, const string& language_out) {
-  std::string phrase_in_where_str{"is null"};
-  if ("null" != phrase_in) phrase_in_where_str = "= '" + this->db_connection_->esc(phrase_in) + "'";
+DbQuery& DbQuery::request_phrase(const string& phrase_in, const string& language_in, const string& language_out,
+                                 const PhrasePage& page) {
+  this->request_translation(phrase_in, language_in, language_out, "", page);
+  return *this;
+}
+
+DbQuery& DbQuery::request_phrase(const string& phrase_in, const string& language_in, const string& language_out,
+                                 const string& word_class, const PhrasePage& page) {
+  std::string word_class_where_str{"is null"};
+  if ("null" != word_class) word_class_where_str = "= '" + this->db_connection_->esc(word_class) + "'";
+  this->request_translation(phrase_in, language_in, language_out, word_class_where_str, page);
+  return *this;
+}
+
+void DbQuery::request_translation(const string& phrase_in, const string& language_in, const string& language_out,
+                                  const string& word_class_where_str, const PhrasePage& page) {
   std::string language_in_where_str{"is null"};
   if ("null" != language_in) language_in_where_str = "= '" + this->db_connection_->esc(language_in) + "'";
   std::string language_out_where_str{"is null"};
   if ("null" != language_out) language_out_where_str = "= '" + this->db_connection_->esc(language_out) + "'";
-  std::string word_class_where_str{"is null"};
+  const string after_str{std::to_string(page.after)};
+  const string limit_str{std::to_string(page.limit)};
+
+  if (this->translation_lookup_) {
+    string where_str{this->phrase_condition("phrase_in", "phrase_key_in", phrase_in, language_in_where_str) +
+                     " AND language_in " + language_in_where_str + " AND language_out " + language_out_where_str};
+    if (!word_class_where_str.empty())
+      where_str += " AND word_class " + word_class_where_str + " AND word_class_out " + word_class_where_str;
+    if (page.after) where_str += " AND phrase_id_out > " + after_str;
+    // A page is limited by the number of target phrases, not by the number of rows.
+    if (page.limit) {
+      where_str += " AND phrase_id_out IN (SELECT phrase_id_out FROM translation_lookup WHERE " + where_str +
+                   " GROUP BY phrase_id_out ORDER BY phrase_id_out LIMIT " + limit_str + ")";
+    }
+    this->request_translation_lookup(where_str);
+    return;
+  }
+
+  std::stringstream where_ss;
+  where_ss << this->phrase_condition("ph_in.phrase", "ph_in.phrase_key", phrase_in, language_in_where_str)
+           << " AND ph_in.language " << language_in_where_str << " AND ph_out.language " << language_out_where_str;
+  if (!word_class_where_str.empty())
+    where_ss << " AND ph_in.word_class " << word_class_where_str << " AND ph_out.word_class " << word_class_where_str;
+  if (page.after) where_ss << " AND ph_out.id > " << after_str;
+  string where_str{where_ss.str()};
+  // The subquery uses the same aliases, so it can share the where clause.
+  if (page.limit) {
+    where_str += " AND ph_out.id IN (SELECT ph_out.id FROM phrase ph_in"
+                 " JOIN phrase_translation pt ON pt.phrase_id_in = ph_in.id"
+                 " JOIN phrase ph_out ON ph_out.id = pt.phrase_id_out WHERE " +
+                 where_str + " GROUP BY ph_out.id ORDER BY ph_out.id LIMIT " + limit_str + ")";
+  }
+
   std::stringstream ss;
   ss << "SELECT"
         " ph_in.language AS language_in,"
@@ -82,8 +132,9 @@ DbQuery& DbQuery::request_phrase(const string& phrase_in, const string& language
         " ph_out.gender AS gender_out,"
         " ph_out.numerus AS numerus_out,"
         " ab_out.abbreviation AS abbriviation_out,"
-        " co_out.comment AS comment_out "
-        "from phrase ph_in"
+        " co_out.comment AS comment_out,"
+        " ph_out.id AS phrase_id_out "
+        "FROM phrase ph_in"
         " LEFT OUTER JOIN phrase_abbreviation pa_in ON ph_in.id = pa_in.phrase_id"
         " LEFT OUTER JOIN abbreviation ab_in ON ab_in.id = pa_in.abbreviation_id"
         " LEFT OUTER JOIN phrase_comment pc_in ON pc_in.phrase_id = ph_in.id"
@@ -94,153 +145,249 @@ DbQuery& DbQuery::request_phrase(const string& phrase_in, const string& language
         " LEFT OUTER JOIN abbreviation ab_out ON ab_out.id = pa_out.abbreviation_id"
         " LEFT OUTER JOIN phrase_comment pc_out ON pc_out.phrase_id = ph_out.id"
         " LEFT OUTER JOIN comment co_out ON co_out.id = pc_out.comment_id "
-        "WHERE ph_in.phrase " << phrase_in_where_str << " AND ph_in.language " << language_in_where_str
-     << " AND ph_out.language " << language_out_where_str << ";";
-  pqxx::work query(*this->db_connection_);
-  this->query_result_ = query.exec(ss.str());
-  query.commit();
+        "WHERE " << where_str << " ORDER BY ph_out.id;";
+  this->exec(ss.str());
+}
+
+DbQuery& DbQuery::request_pivot_phrase(const string& phrase_in, const string& language_in, const string& language_hub,
+                                       const string& language_out) {
+  this->request_pivot_translation(phrase_in, language_in, language_hub, language_out, "");
   return *this;
 }
 
-DbQuery& DbQuery::request_phrase(const string& phrase_in, const string& language_in, const string& language_out,
-                                   const string& word_class) {
-  std::string phrase_in_where_str{"is null"};
-  if ("null" != phrase_in) phrase_in_where_str = "= '" + this->db_connection_->esc(phrase_in) + "'";
+DbQuery& DbQuery::request_pivot_phrase(const string& phrase_in, const string& language_in, const string& language_hub,
+                                       const string& language_out, const string& word_class) {
+  std::string word_class_where_str{"is null"};
+  if ("null" != word_class) word_class_where_str = "= '" + this->db_connection_->esc(word_class) + "'";
+  this->request_pivot_translation(phrase_in, language_in, language_hub, language_out, word_class_where_str);
+  return *this;
+}
+
+void DbQuery::request_pivot_translation(const string& phrase_in, const string& language_in, const string& language_hub,
+                                        const string& language_out, const string& word_class_where_str) {
   std::string language_in_where_str{"is null"};
   if ("null" != language_in) language_in_where_str = "= '" + this->db_connection_->esc(language_in) + "'";
+  std::string language_hub_where_str{"is null"};
+  if ("null" != language_hub) language_hub_where_str = "= '" + this->db_connection_->esc(language_hub) + "'";
   std::string language_out_where_str{"is null"};
   if ("null" != language_out) language_out_where_str = "= '" + this->db_connection_->esc(language_out) + "'";
-  std::string word_class_where_str{"is null"};
-  if ("null" != word_class) word_class_where_str = "= '" + this->db_connection_->esc(word_class) + "'";
+  auto word_class_condition = [&word_class_where_str](const string& alias) {
+    return word_class_where_str.empty() ? string{} : " AND " + alias + ".word_class " + word_class_where_str;
+  };
+
+  // Both the direct translations and the translations of all hub phrases are reached by joins, so the whole chain is
+  // resolved by a single statement. Each target phrase is returned once, direct marks whether it is a direct
+  // translation and pivot_phrases contains all hub phrases it was reached by.
   std::stringstream ss;
-  ss << "SELECT"
-        " ph_in.language AS language_in,"
-        " ph_in.phrase AS phrase_in,"
-        " ph_in.word_class AS word_class_in,"
-        " ph_in.gender AS gender_in,"
-        " ph_in.numerus AS numerus_in,"
-        " ab_in.abbreviation AS abbreviation_in,"
-        " co_in.comment AS comment_in,"
-        " ph_out.language AS language_out,"
+  ss << "WITH origin AS (SELECT ph_in.id FROM phrase ph_in WHERE "
+     << this->phrase_condition("ph_in.phrase", "ph_in.phrase_key", phrase_in, language_in_where_str)
+     << " AND ph_in.language " << language_in_where_str << word_class_condition("ph_in")
+     << "), "
+        "reached AS ("
+        "SELECT pt.phrase_id_out AS id, NULL::varchar AS pivot_phrase FROM origin o"
+        " JOIN phrase_translation pt ON pt.phrase_id_in = o.id "
+        "UNION ALL "
+        "SELECT pt_out.phrase_id_out, ph_hub.phrase FROM origin o"
+        " JOIN phrase_translation pt_in ON pt_in.phrase_id_in = o.id"
+        " JOIN phrase ph_hub ON ph_hub.id = pt_in.phrase_id_out"
+        " JOIN phrase_translation pt_out ON pt_out.phrase_id_in = ph_hub.id "
+        "WHERE ph_hub.language " << language_hub_where_str << word_class_condition("ph_hub")
+     << ") "
+        "SELECT"
         " ph_out.phrase AS phrase_out,"
         " ph_out.word_class AS word_class_out,"
         " ph_out.gender AS gender_out,"
         " ph_out.numerus AS numerus_out,"
-        " ab_out.abbreviation AS abbriviation_out,"
-        " co_out.comment AS comment_out "
-        "FROM phrase ph_in"
-        " LEFT OUTER JOIN phrase_abbreviation pa_in ON ph_in.id = pa_in.phrase_id"
-        " LEFT OUTER JOIN abbreviation ab_in ON ab_in.id = pa_in.abbreviation_id"
-        " LEFT OUTER JOIN phrase_comment pc_in ON pc_in.phrase_id = ph_in.id"
-        " LEFT OUTER JOIN comment co_in ON co_in.id = pc_in.comment_id"
-        " LEFT OUTER JOIN phrase_translation pt ON pt.phrase_id_in = ph_in.id"
-        " LEFT OUTER JOIN phrase ph_out ON ph_out.id = pt.phrase_id_out"
-        " LEFT OUTER JOIN phrase_abbreviation pa_out ON pa_out.phrase_id = ph_out.id"
-        " LEFT OUTER JOIN abbreviation ab_out ON ab_out.id = pa_out.abbreviation_id"
-        " LEFT OUTER JOIN phrase_comment pc_out ON pc_out.phrase_id = ph_out.id"
-        " LEFT OUTER JOIN comment co_out ON co_out.id = pc_out.comment_id "
-        "WHERE ph_in.phrase " << phrase_in_where_str << " AND ph_in.language " << language_in_where_str
-     << " AND ph_out.language " << language_out_where_str << " AND ph_in.word_class " << word_class_where_str
-     << " AND ph_out.word_class " << word_class_where_str << ";";
-  pqxx::work query(*this->db_connection_);
-  this->query_result_ = query.exec(ss.str());
-  query.commit();
-  return *this;
+        " array_to_json(ARRAY(SELECT ab.abbreviation FROM phrase_abbreviation pa"
+        " JOIN abbreviation ab ON ab.id = pa.abbreviation_id"
+        " WHERE pa.phrase_id = ph_out.id ORDER BY ab.abbreviation)) AS abbreviations_out,"
+        " array_to_json(ARRAY(SELECT co.comment FROM phrase_comment pc JOIN comment co ON co.id = pc.comment_id"
+        " WHERE pc.phrase_id = ph_out.id ORDER BY co.comment)) AS comments_out,"
+        " bool_or(r.pivot_phrase IS NULL) AS direct,"
+        " array_to_json(array_remove(array_agg(DISTINCT r.pivot_phrase), NULL)) AS pivot_phrases "
+        "FROM reached r"
+        " JOIN phrase ph_out ON ph_out.id = r.id "
+        "WHERE ph_out.language " << language_out_where_str << word_class_condition("ph_out")
+     << " GROUP BY ph_out.id"
+        " ORDER BY direct DESC, ph_out.phrase;";
+  this->exec(ss.str());
+}
+
+string DbQuery::phrase_condition(const string& phrase_column, const string& phrase_key_column, const string& phrase_in,
+                                 const string& language_in_where_str) const {
+  if ("null" == phrase_in) return phrase_column + " is null";
+  const string phrase{this->db_connection_->esc(phrase_in)};
+  // A phrase always has the same key as itself, so the index on the key column serves both cases. Phrases of a data
+  // base migrated by 002_phrase_key.sql have no key until trlt-import fills it, they are matched literally meanwhile.
+  return "((" + phrase_key_column + " = '" + this->db_connection_->esc(utils::to_phrase_key(phrase_in)) + "' AND (" +
+         phrase_column + " = '" + phrase + "' OR NOT EXISTS (SELECT 1 FROM phrase ph_exact WHERE ph_exact.phrase = '" +
+         phrase + "' AND ph_exact.language " + language_in_where_str + "))) OR (" + phrase_key_column +
+         " IS NULL AND " + phrase_column + " = '" + phrase + "'))";
+}
+
+void DbQuery::request_translation_lookup(const string& where_str) {
+  this->exec(
+      "SELECT"
+      " language_in,"
+      " phrase_in,"
+      " word_class AS word_class_in,"
+      " gender_in,"
+      " numerus_in,"
+      " abbreviations_in,"
+      " comments_in,"
+      " language_out,"
+      " phrase_out,"
+      " word_class_out,"
+      " gender_out,"
+      " numerus_out,"
+      " abbreviations_out,"
+      " comments_out,"
+      " phrase_id_out "
+      "FROM translation_lookup "
+      "WHERE " + where_str + " ORDER BY phrase_id_out;");
 }
 
 DbQuery& DbQuery::request_language_by_name(const string& language_name) {
-  pqxx::work query(*this->db_connection_);
   std::stringstream ss;
-  string language_name_where_str{"is null"};
-  if ("null" != language_name) language_name_where_str = "ILIKE '" + this->db_connection_->esc(language_name) + "'";
-  ss << "SELECT id FROM language WHERE name " << language_name_where_str << ";";
-  this->query_result_ = query.exec(ss.str());
-  query.commit();
+  string language_name_where_str{"name is null"};
+  if ("null" != language_name)
+    language_name_where_str = "lower(name) = lower('" + this->db_connection_->esc(language_name) + "')";
+  ss << "SELECT id FROM language WHERE " << language_name_where_str << ";";
+  this->exec(ss.str());
   return *this;
 }
 
 DbQuery& DbQuery::request_language_by_id(const string& language_id) {
-  pqxx::work query(*this->db_connection_);
   std::stringstream ss;
   string language_id_where_str{"is null"};
   if ("null" != language_id) language_id_where_str = "= '" + this->db_connection_->esc(language_id) + "'";
   ss << "SELECT name FROM language WHERE id " << language_id_where_str << ";";
-  this->query_result_ = query.exec(ss.str());
-  query.commit();
+  this->exec(ss.str());
   return *this;
 }
 
 DbQuery& DbQuery::request_all_languages() {
-  pqxx::work query(*this->db_connection_);
-  this->query_result_ = query.exec("SELECT * FROM language;");
-  query.commit();
+  this->exec("SELECT * FROM language;");
   return *this;
 }
 
 DbQuery& DbQuery::request_word_class_by_name(const string& word_class_name) {
-  pqxx::work query(*this->db_connection_);
   std::stringstream ss;
-  string word_class_name_where_str{"is null"};
+  string word_class_name_where_str{"name is null"};
   if ("null" != word_class_name)
-    word_class_name_where_str = "ILIKE '" + this->db_connection_->esc(word_class_name) + "'";
-  ss << "SELECT id FROM word_class_description WHERE name " << word_class_name_where_str << ";";
-  this->query_result_ = query.exec(ss.str());
-  query.commit();
+    word_class_name_where_str = "lower(name) = lower('" + this->db_connection_->esc(word_class_name) + "')";
+  ss << "SELECT id FROM word_class_description WHERE " << word_class_name_where_str << ";";
+  this->exec(ss.str());
   return *this;
 }
 
 DbQuery& DbQuery::request_word_class_by_id(const string& word_class_id) {
-  pqxx::work query(*this->db_connection_);
   std::stringstream ss;
   string word_class_id_where_str{"is null"};
   if ("null" != word_class_id)
     word_class_id_where_str = "= '" + this->db_connection_->esc(word_class_id) + "'";
   ss << "SELECT name FROM word_class_description WHERE id " << word_class_id_where_str << ";";
-  this->query_result_ = query.exec(ss.str());
-  query.commit();
+  this->exec(ss.str());
   return *this;
 }
 
 DbQuery& DbQuery::request_all_word_classes() {
-  pqxx::work query(*this->db_connection_);
-  this->query_result_ = query.exec("SELECT * FROM word_class_description;");
-  query.commit();
+  this->exec("SELECT * FROM word_class_description;");
   return *this;
 }
 
 DbQuery& DbQuery::request_gender_by_name(const string& gender_name) {
-  pqxx::work query(*this->db_connection_);
   std::stringstream ss;
-  string gender_name_where_str{"is null"};
-  if ("null" != gender_name) gender_name_where_str = "ILIKE '" + this->db_connection_->esc(gender_name) + "'";
-  ss << "SELECT id, description FROM gender_description WHERE name " << gender_name_where_str << ";";
-  this->query_result_ = query.exec(ss.str());
-  query.commit();
+  string gender_name_where_str{"name is null"};
+  if ("null" != gender_name)
+    gender_name_where_str = "lower(name) = lower('" + this->db_connection_->esc(gender_name) + "')";
+  ss << "SELECT id, description FROM gender_description WHERE " << gender_name_where_str << ";";
+  this->exec(ss.str());
   return *this;
 }
 
 DbQuery& DbQuery::request_gender_by_id(const string& gender_id) {
-  pqxx::work query(*this->db_connection_);
   std::stringstream ss;
   string gender_id_where_str{"is null"};
   if ("null" != gender_id) gender_id_where_str = "= '" + this->db_connection_->esc(gender_id) + "'";
   ss << "SELECT name, description FROM gender_description WHERE id " << gender_id_where_str << ";";
-  this->query_result_ = query.exec(ss.str());
-  query.commit();
+  this->exec(ss.str());
   return *this;
 }
 
 DbQuery& DbQuery::request_all_genders() {
-  pqxx::work query(*this->db_connection_);
-  this->query_result_ = query.exec("SELECT * FROM gender_description;");
-  query.commit();
+  this->exec("SELECT * FROM gender_description;");
   return *this;
 }
 DbQuery& DbQuery::request_all_numeri() {
+  this->exec("SELECT * from unnest(enum_range(NULL::numerus));");
+  return *this;
+}
+
+DbQuery& DbQuery::request_phrase_popularity() {
+  this->exec(
+      "SELECT ph.language, ph.phrase, count(*) AS popularity FROM phrase ph"
+      " JOIN phrase_translation pt ON pt.phrase_id_in = ph.id "
+      "GROUP BY ph.language, ph.phrase;");
+  return *this;
+}
+
+DbQuery& DbQuery::request_phrase_annotations() {
+  this->exec(
+      "SELECT ph.id, ph.language, ph.phrase, co.comment AS annotation FROM phrase ph"
+      " JOIN phrase_comment pc ON pc.phrase_id = ph.id"
+      " JOIN comment co ON co.id = pc.comment_id "
+      "UNION ALL "
+      "SELECT ph.id, ph.language, ph.phrase, ab.abbreviation AS annotation FROM phrase ph"
+      " JOIN phrase_abbreviation pa ON pa.phrase_id = ph.id"
+      " JOIN abbreviation ab ON ab.id = pa.abbreviation_id;");
+  return *this;
+}
+
+DbQuery& DbQuery::use_translation_lookup(bool translation_lookup) {
+  this->translation_lookup_ = translation_lookup;
+  return *this;
+}
+
+bool DbQuery::uses_translation_lookup() const { return this->translation_lookup_; }
+
+DbQuery& DbQuery::explain(bool explain) {
+  this->explain_ = explain;
+  return *this;
+}
+
+bool DbQuery::explains() const { return this->explain_; }
+
+DbQuery& DbQuery::stream(size_t batch_size) {
+  this->stream_batch_size_ = batch_size;
+  return *this;
+}
+
+bool DbQuery::fetch() {
+  if (!this->stream_transaction_) {
+    this->query_result_.clear();
+    return false;
+  }
+  this->query_result_ =
+      this->stream_transaction_->exec("FETCH " + std::to_string(this->stream_batch_size_) + " FROM trlt_stream;");
+  if (!this->query_result_.empty()) return true;
+  this->stream_transaction_->commit();
+  this->stream_transaction_.reset();
+  return false;
+}
+
+void DbQuery::exec(const string& statement) {
+  if (this->stream_batch_size_ && !this->explain_) {
+    // A previous stream is aborted, since a connection can only hold one transaction at once.
+    this->stream_transaction_.reset();
+    this->stream_transaction_.reset(new pqxx::work(*this->db_connection_));
+    this->stream_transaction_->exec("DECLARE trlt_stream NO SCROLL CURSOR FOR " + statement);
+    this->fetch();
+    return;
+  }
   pqxx::work query(*this->db_connection_);
-  this->query_result_ = query.exec("SELECT * from unnest(enum_range(NULL::numerus));");
+  this->query_result_ = query.exec(this->explain_ ? "EXPLAIN " + statement : statement);
   query.commit();
-  return *this;
 }
 
 }  // server
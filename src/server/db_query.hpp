@@ -1,7 +1,7 @@
 
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 04/28/2015
+// Last modified: 10/19/2026
 // Description: Defines the DbQuery class that allows to query the data base for language information.
 // ====================================================================================================================
 
@@ -23,12 +23,22 @@
 #include "connection_string.hpp"
 
 #include <pqxx/pqxx>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 
 namespace lgeorgieff {
 namespace translate {
 namespace server {
 
+// A page of a phrase request, i.e. at most limit target phrases whose id is greater than after. A limit of 0 requests
+// all target phrases.
+struct PhrasePage {
+  size_t limit;
+  uint32_t after;
+};
+
 // Encapsulates the functionality to query the translation data base for predefined queries.
 class DbQuery {
  public:
@@ -45,10 +55,23 @@ class DbQuery {
   DbQuery& operator=(DbQuery&&) = default;
   ~DbQuery();
 
+  // Phrases are matched case and diacritic insensitively by their search key phrase_key, e.g. "strasse" finds
+  // "Straße". If the requested phrase exists literally in the requested language, only the literal phrase is matched,
+  // e.g. "weg" does not return the translations of "Weg". Phrases without a key are only matched literally.
+  // The rows of a phrase request are ordered by the id of the target phrase, i.e. the last column phrase_id_out, so
+  // all rows of a target phrase are adjacent.
   // Requests all data for a phrase translation without taking care on the word classes.
-  DbQuery& request_phrase(const string&, const string&, const string&);
+  DbQuery& request_phrase(const string&, const string&, const string&, const PhrasePage& = PhrasePage{0, 0});
   // Requests all data for a phrase translation with taking care on the word classes.
-  DbQuery& request_phrase(const string&, const string&, const string&, const string&);
+  DbQuery& request_phrase(const string&, const string&, const string&, const string&,
+                          const PhrasePage& = PhrasePage{0, 0});
+  // Requests the translations of a phrase into the last passed language and additionally the translations of its
+  // translations into the hub language, i.e. the third argument. This covers language pairs without a language
+  // resource, e.g. BG => FR through EN. Each row contains a target phrase with all its abbreviations and comments as
+  // json arrays, whether it is a direct translation and the hub phrases it was reached by.
+  DbQuery& request_pivot_phrase(const string&, const string&, const string&, const string&);
+  // Requests the pivot translations of a phrase like above, but only of the passed word class.
+  DbQuery& request_pivot_phrase(const string&, const string&, const string&, const string&, const string&);
   // Request an identifier for the given language name (case insensitive).
   DbQuery& request_language_by_name(const string&);
   // Request the language name for the given language id.
@@ -69,6 +92,30 @@ class DbQuery {
   DbQuery& request_all_genders();
   // Request all numerus identifiers.
   DbQuery& request_all_numeri();
+  // Request the language, the phrase and the number of translations as popularity of all translated phrases. This
+  // reads the whole phrase table and is only meant to be used once at startup.
+  DbQuery& request_phrase_popularity();
+  // Request the id, the language and the phrase of all phrases with comments or abbreviations together with each of
+  // their comments and abbreviations. This reads the whole comment and abbreviation relations and is only meant to be
+  // used once at startup.
+  DbQuery& request_phrase_annotations();
+
+  // If set to true, phrase requests are answered from the denormalized table translation_lookup, which contains one
+  // row per translation with all comments and abbreviations as json arrays, instead of joining the normalized tables.
+  DbQuery& use_translation_lookup(bool);
+  // Returns true if phrase requests are answered from the table translation_lookup.
+  bool uses_translation_lookup() const;
+  // If set to true, all requests return the query plan of their statement instead of its result, i.e. each statement
+  // is prefixed by EXPLAIN.
+  DbQuery& explain(bool);
+  // Returns true if requests return the query plan of their statement.
+  bool explains() const;
+  // If set to a number greater than 0, the statement of each further request is opened as server-side cursor and only
+  // the passed number of rows is fetched at once. The result contains the first rows, fetch() replaces it with the
+  // next ones. The cursor keeps a transaction open, so a streaming instance should own its connection.
+  DbQuery& stream(size_t);
+  // Replaces the result by the next rows of the open cursor. Returns false and closes the cursor if no rows are left.
+  bool fetch();
 
   // Returns a start const_iterator pointing to the result data structure of the last request.
   pqxx::result::const_iterator begin() const;
@@ -86,10 +133,27 @@ class DbQuery {
   void clear();
 
  private:
-  //
+  // Returns the where condition that matches the passed phrase in the passed phrase and phrase key columns, see
+  // request_phrase. The last argument is the condition for the requested language.
+  string phrase_condition(const string&, const string&, const string&, const string&) const;
+  // Requests the pivot translations of a phrase, see request_pivot_phrase. The last argument is the condition for the
+  // word class of all involved phrases or empty for any word class.
+  void request_pivot_translation(const string&, const string&, const string&, const string&, const string&);
+  // Requests the translations of a phrase, see request_phrase. The fourth argument is the condition for the word class
+  // of both phrases or empty for any word class.
+  void request_translation(const string&, const string&, const string&, const string&, const PhrasePage&);
+  // Requests all translations from the table translation_lookup that match the passed where clause.
+  void request_translation_lookup(const string&);
+  // Executes the passed statement in a new transaction and stores its result.
+  void exec(const string&);
+
   pqxx::connection* db_connection_;
   pqxx::result query_result_;
   bool connection_self_created_;
+  bool translation_lookup_;
+  bool explain_;
+  size_t stream_batch_size_;
+  std::unique_ptr<pqxx::work> stream_transaction_;
 };  // DbQuery
 
 }  // server
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 05/05/2015
+// Last modified: 10/19/2026
 // Description: Defines a class with several static methods for transforming DB query results into JSON string.
 // ====================================================================================================================
 
@@ -17,6 +17,7 @@
 // ====================================================================================================================
 
 #include "json.hpp"
+#include "utils/cbor.hpp"
 #include "utils/json_exception.hpp"
 
 #include <pqxx/pqxx>
@@ -69,6 +70,26 @@ void append_value_to_array_in_json_object(Json::Value &json_object, const std::s
     json_object[array_name] = array;
   }
 }
+
+// A helper function that parses a json array column of the table translation_lookup.
+Json::Value json_array_from_field(const pqxx::field &field) {
+  Json::Value array{Json::arrayValue};
+  if (field.is_null()) return array;
+  Json::Reader reader;
+  if (!reader.parse(field.c_str(), array) || !array.isArray())
+    throw lgeorgieff::translate::utils::JsonException{"The json data " + std::string{field.c_str()} +
+                                                      " cannot be parsed!"};
+  return array;
+}
+
+// A helper function that appends all string values of the passed json array to the array referenced by array_name
+// inside the given json object, values that are already contained are skipped.
+void merge_array_into_json_object(Json::Value &json_object, const std::string &array_name, const Json::Value &array) {
+  for (const Json::Value &array_iter : array) {
+    if (array_iter.isString() && !json_object_contains_value_in_array(json_object, array_name, array_iter.asString()))
+      append_value_to_array_in_json_object(json_object, array_name, array_iter.asString());
+  }
+}
 }  // anonymous namespace
 
 namespace lgeorgieff {
@@ -79,46 +100,46 @@ using lgeorgieff::translate::utils::JsonException;
 
 const std::string JSON::JSON_INDENTATION_STRING{""};
 
-std::string JSON::all_languages_to_json(const DbQuery &db_query) {
-  return generic_multiple_result_to_json(db_query, {"id", "name"}, {{"id", "id"}, {"name", "language"}});
+std::string JSON::all_languages_to_json(const DbQuery &db_query, Encoding encoding) {
+  return generic_multiple_result_to_json(db_query, {"id", "name"}, {{"id", "id"}, {"name", "language"}}, encoding);
 }
 
-std::string JSON::language_id_to_json(const DbQuery &db_query) {
-  return generic_single_result_to_json(db_query, "id");
+std::string JSON::language_id_to_json(const DbQuery &db_query, Encoding encoding) {
+  return generic_single_result_to_json(db_query, "id", encoding);
 }
 
-std::string JSON::language_name_to_json(const DbQuery &db_query) {
-  return generic_single_result_to_json(db_query, "name");
+std::string JSON::language_name_to_json(const DbQuery &db_query, Encoding encoding) {
+  return generic_single_result_to_json(db_query, "name", encoding);
 }
 
-std::string JSON::all_word_classes_to_json(const DbQuery &db_query) {
-  return generic_multiple_result_to_json(db_query, {"id", "name"}, {{"id", "id"}, {"name", "word_class"}});
+std::string JSON::all_word_classes_to_json(const DbQuery &db_query, Encoding encoding) {
+  return generic_multiple_result_to_json(db_query, {"id", "name"}, {{"id", "id"}, {"name", "word_class"}}, encoding);
 }
 
-std::string JSON::word_class_id_to_json(const DbQuery &db_query) {
-  return generic_single_result_to_json(db_query, "id");
+std::string JSON::word_class_id_to_json(const DbQuery &db_query, Encoding encoding) {
+  return generic_single_result_to_json(db_query, "id", encoding);
 }
 
-std::string JSON::word_class_name_to_json(const DbQuery &db_query) {
-  return generic_single_result_to_json(db_query, "name");
+std::string JSON::word_class_name_to_json(const DbQuery &db_query, Encoding encoding) {
+  return generic_single_result_to_json(db_query, "name", encoding);
 }
 
-std::string JSON::all_genders_to_json(const DbQuery &db_query) {
+std::string JSON::all_genders_to_json(const DbQuery &db_query, Encoding encoding) {
   return generic_multiple_result_to_json(db_query, {"id", "description", "name"},
-                                         {{"id", "id"}, {"name", "gender"}, {"description", "description"}});
+                                         {{"id", "id"}, {"name", "gender"}, {"description", "description"}}, encoding);
 }
 
-std::string JSON::gender_name_to_json(const DbQuery &db_query) {
+std::string JSON::gender_name_to_json(const DbQuery &db_query, Encoding encoding) {
   return generic_single_complex_result_to_json(db_query, {"name", "description"},
-                                               {{"name", "gender"}, {"description", "description"}});
+                                               {{"name", "gender"}, {"description", "description"}}, encoding);
 }
 
-std::string JSON::gender_id_to_json(const DbQuery &db_query) {
+std::string JSON::gender_id_to_json(const DbQuery &db_query, Encoding encoding) {
   return generic_single_complex_result_to_json(db_query, {"id", "description"},
-                                               {{"id", "id"}, {"description", "description"}});
+                                               {{"id", "id"}, {"description", "description"}}, encoding);
 }
 
-std::string JSON::all_numeri_to_json(const DbQuery &db_query) {
+std::string JSON::all_numeri_to_json(const DbQuery &db_query, Encoding encoding) {
   Json::Value result;
   for (const pqxx::tuple &row : db_query) {
     if (row.size() != 1) {
@@ -131,7 +152,7 @@ std::string JSON::all_numeri_to_json(const DbQuery &db_query) {
     row[0].to(str_container);
     result.append(str_container);
   }
-  return json_value_to_string(result);
+  return encode(result, encoding);
 }
 
 // Returns the following JSON string:
@@ -146,7 +167,7 @@ std::string JSON::all_numeri_to_json(const DbQuery &db_query) {
 //   },
 //   {...}
 //  ]
-std::string JSON::phrase_to_json(const DbQuery &db_query, const Json::Value &user_options) {
+std::string JSON::phrase_to_json(const DbQuery &db_query, const Json::Value &user_options, Encoding encoding) {
   bool show_phrase{true}, show_word_class{true}, show_gender{true}, show_numerus{true}, show_abbreviation{true},
       show_comment{true};
   if (user_options.isObject()) {
@@ -158,9 +179,14 @@ std::string JSON::phrase_to_json(const DbQuery &db_query, const Json::Value &use
     show_comment = get_bool_from_json_object(user_options, "show_comment", show_comment);
   }
 
+  if (db_query.uses_translation_lookup())
+    return translation_lookup_to_json(db_query, show_phrase, show_word_class, show_gender, show_numerus,
+                                      show_abbreviation, show_comment, encoding);
+
   static std::vector<std::string> column_names{
       "language_in",  "phrase_in",  "word_class_in",  "gender_in",  "numerus_in",  "abbreviation_in",  "comment_in",
-      "language_out", "phrase_out", "word_class_out", "gender_out", "numerus_out", "abbriviation_out", "comment_out"};
+      "language_out", "phrase_out", "word_class_out", "gender_out", "numerus_out", "abbriviation_out", "comment_out",
+      "phrase_id_out"};
 
   Json::Value result{Json::arrayValue};
   for (const pqxx::tuple &row : db_query) {
@@ -170,8 +196,8 @@ std::string JSON::phrase_to_json(const DbQuery &db_query, const Json::Value &use
     }
     std::string current_phrase, current_word_class, current_gender, current_numerus, current_abbreviation,
         current_comment;
-    // 8 => start at phrase_out
-    for (size_t field_pos{8}; field_pos < column_names.size(); ++field_pos) {
+    // 8 => start at phrase_out, the last column phrase_id_out only orders the rows
+    for (size_t field_pos{8}; field_pos < column_names.size() - 1; ++field_pos) {
       if (column_names[field_pos] != row[static_cast<int>(field_pos)].name())
         throw JsonException("Cannot transform DB result to JSON, column names do not match!");
       if (!strcmp(row[static_cast<int>(field_pos)].name(), "phrase_out") && show_phrase)
@@ -186,7 +212,7 @@ std::string JSON::phrase_to_json(const DbQuery &db_query, const Json::Value &use
         row[static_cast<int>(field_pos)].to(current_abbreviation);
       else if (show_comment)
         row[static_cast<int>(field_pos)].to(current_comment);
-    }  // for(size_t field_pos{8}; field_pos < column_names.size(); ++field_pos)
+    }  // for(size_t field_pos{8}; field_pos < column_names.size() - 1; ++field_pos)
 
     Json::Value *basic_item{nullptr};
     for (Json::Value &result_object : result) {
@@ -224,12 +250,155 @@ std::string JSON::phrase_to_json(const DbQuery &db_query, const Json::Value &use
     }
 
   }  // for(const pqxx::tuple &row : db_query)
-  return json_value_to_string(result);
+  return encode(result, encoding);
 }  // JSON::phrase_to_json
 
+// Returns the same JSON string as phrase_to_json, but for a result of the table translation_lookup, i.e. each row is
+// a single translation and contains all abbreviations and comments as json arrays.
+std::string JSON::translation_lookup_to_json(const DbQuery &db_query, bool show_phrase, bool show_word_class,
+                                             bool show_gender, bool show_numerus, bool show_abbreviation,
+                                             bool show_comment, Encoding encoding) {
+  static std::vector<std::string> column_names{
+      "language_in",      "phrase_in",   "word_class_in", "gender_in",      "numerus_in",
+      "abbreviations_in", "comments_in", "language_out",  "phrase_out",     "word_class_out",
+      "gender_out",       "numerus_out", "abbreviations_out", "comments_out", "phrase_id_out"};
+
+  Json::Value result{Json::arrayValue};
+  for (const pqxx::tuple &row : db_query) {
+    if (row.size() != column_names.size()) {
+      throw JsonException("Cannot transform DB result to JSON, expected " + std::to_string(column_names.size()) +
+                          " column but found " + std::to_string(row.size()) + "!");
+    }
+    // 8 => start at phrase_out
+    for (size_t field_pos{8}; field_pos < column_names.size(); ++field_pos) {
+      if (column_names[field_pos] != row[static_cast<int>(field_pos)].name())
+        throw JsonException("Cannot transform DB result to JSON, column names do not match!");
+    }
+    std::string current_phrase, current_word_class, current_gender, current_numerus;
+    if (show_phrase) row["phrase_out"].to(current_phrase);
+    if (show_word_class) row["word_class_out"].to(current_word_class);
+    if (show_gender) row["gender_out"].to(current_gender);
+    if (show_numerus) row["numerus_out"].to(current_numerus);
+    Json::Value current_abbreviations{Json::arrayValue}, current_comments{Json::arrayValue};
+    if (show_abbreviation) current_abbreviations = json_array_from_field(row["abbreviations_out"]);
+    if (show_comment) current_comments = json_array_from_field(row["comments_out"]);
+
+    Json::Value *basic_item{nullptr};
+    for (Json::Value &result_object : result) {
+      if (json_object_contains_string_member(result_object, "phrase", current_phrase) &&
+          json_object_contains_string_member(result_object, "word_class", current_word_class) &&
+          json_object_contains_string_member(result_object, "gender", current_gender) &&
+          json_object_contains_string_member(result_object, "numerus", current_numerus)) {
+        basic_item = &result_object;
+        break;
+      }
+    }
+    if (!basic_item) {
+      Json::Value new_item;
+      if (!current_phrase.empty()) new_item["phrase"] = current_phrase;
+      if (!current_word_class.empty()) new_item["word_class"] = current_word_class;
+      if (!current_gender.empty()) new_item["gender"] = current_gender;
+      if (!current_numerus.empty()) new_item["numerus"] = current_numerus;
+      if (new_item.isNull() && current_abbreviations.empty() && current_comments.empty()) continue;
+      result.append(new_item);
+      basic_item = &result[result.size() - 1];
+    }
+    merge_array_into_json_object(*basic_item, "abbreviations", current_abbreviations);
+    merge_array_into_json_object(*basic_item, "comments", current_comments);
+  }  // for(const pqxx::tuple &row : db_query)
+  return encode(result, encoding);
+}  // JSON::translation_lookup_to_json
+
+// Returns the same JSON string as phrase_to_json, but for a result of DbQuery::request_pivot_phrase. Additionally,
+// each object contains its provenance, i.e. "direct" or "pivot", and the hub phrases it was translated by:
+//
+//  [{
+//    ...
+//    "provenance": "pivot",
+//    "pivot_phrases": [ "<hub phrase 1>", "<hub phrase 2>" ]
+//   },
+//   {...}
+//  ]
+std::string JSON::pivot_phrase_to_json(const DbQuery &db_query, const Json::Value &user_options, Encoding encoding) {
+  bool show_phrase{true}, show_word_class{true}, show_gender{true}, show_numerus{true}, show_abbreviation{true},
+      show_comment{true};
+  if (user_options.isObject()) {
+    show_phrase = get_bool_from_json_object(user_options, "show_phrase", show_phrase);
+    show_word_class = get_bool_from_json_object(user_options, "show_word_class", show_word_class);
+    show_gender = get_bool_from_json_object(user_options, "show_gender", show_gender);
+    show_numerus = get_bool_from_json_object(user_options, "show_numerus", show_numerus);
+    show_abbreviation = get_bool_from_json_object(user_options, "show_abbreviation", show_abbreviation);
+    show_comment = get_bool_from_json_object(user_options, "show_comment", show_comment);
+  }
+
+  static std::vector<std::string> column_names{"phrase_out",        "word_class_out", "gender_out", "numerus_out",
+                                               "abbreviations_out", "comments_out",   "direct",     "pivot_phrases"};
+
+  Json::Value result{Json::arrayValue};
+  for (const pqxx::tuple &row : db_query) {
+    if (row.size() != column_names.size()) {
+      throw JsonException("Cannot transform DB result to JSON, expected " + std::to_string(column_names.size()) +
+                          " column but found " + std::to_string(row.size()) + "!");
+    }
+    for (size_t field_pos{0}; field_pos < column_names.size(); ++field_pos) {
+      if (column_names[field_pos] != row[static_cast<int>(field_pos)].name())
+        throw JsonException("Cannot transform DB result to JSON, column names do not match!");
+    }
+    std::string current_phrase, current_word_class, current_gender, current_numerus;
+    if (show_phrase) row["phrase_out"].to(current_phrase);
+    if (show_word_class) row["word_class_out"].to(current_word_class);
+    if (show_gender) row["gender_out"].to(current_gender);
+    if (show_numerus) row["numerus_out"].to(current_numerus);
+    Json::Value current_abbreviations{Json::arrayValue}, current_comments{Json::arrayValue};
+    if (show_abbreviation) current_abbreviations = json_array_from_field(row["abbreviations_out"]);
+    if (show_comment) current_comments = json_array_from_field(row["comments_out"]);
+    bool current_direct{false};
+    row["direct"].to(current_direct);
+
+    // The rows are ordered by provenance, so an object that is merged with a direct translation is already direct.
+    Json::Value *basic_item{nullptr};
+    for (Json::Value &result_object : result) {
+      if (json_object_contains_string_member(result_object, "phrase", current_phrase) &&
+          json_object_contains_string_member(result_object, "word_class", current_word_class) &&
+          json_object_contains_string_member(result_object, "gender", current_gender) &&
+          json_object_contains_string_member(result_object, "numerus", current_numerus)) {
+        basic_item = &result_object;
+        break;
+      }
+    }
+    if (!basic_item) {
+      Json::Value new_item;
+      if (!current_phrase.empty()) new_item["phrase"] = current_phrase;
+      if (!current_word_class.empty()) new_item["word_class"] = current_word_class;
+      if (!current_gender.empty()) new_item["gender"] = current_gender;
+      if (!current_numerus.empty()) new_item["numerus"] = current_numerus;
+      new_item["provenance"] = current_direct ? "direct" : "pivot";
+      result.append(new_item);
+      basic_item = &result[result.size() - 1];
+    }
+    merge_array_into_json_object(*basic_item, "abbreviations", current_abbreviations);
+    merge_array_into_json_object(*basic_item, "comments", current_comments);
+    merge_array_into_json_object(*basic_item, "pivot_phrases", json_array_from_field(row["pivot_phrases"]));
+  }  // for(const pqxx::tuple &row : db_query)
+  return encode(result, encoding);
+}  // JSON::pivot_phrase_to_json
+
+std::string JSON::completions_to_json(const std::vector<std::string> &completions, Encoding encoding) {
+  Json::Value result{Json::arrayValue};
+  for (const std::string &completion : completions) result.append(completion);
+  return encode(result, encoding);
+}
+
+std::string JSON::search_results_to_json(const std::vector<std::string> &phrases, Encoding encoding) {
+  Json::Value result{Json::arrayValue};
+  for (const std::string &phrase : phrases) result.append(phrase);
+  return encode(result, encoding);
+}
+
 std::string JSON::generic_multiple_result_to_json(const DbQuery &db_query,
                                                   const std::vector<std::string> &column_names,
-                                                  const std::map<std::string, std::string> &name_mapping) {
+                                                  const std::map<std::string, std::string> &name_mapping,
+                                                  Encoding encoding) {
   Json::Value result;
   for (const pqxx::tuple &row : db_query) {
     if (row.size() != column_names.size())
@@ -247,10 +416,11 @@ std::string JSON::generic_multiple_result_to_json(const DbQuery &db_query,
     }
     result.append(json_row);
   }
-  return json_value_to_string(result);
+  return encode(result, encoding);
 }
 
-std::string JSON::generic_single_result_to_json(const DbQuery &db_query, const std::string &column_name) {
+std::string JSON::generic_single_result_to_json(const DbQuery &db_query, const std::string &column_name,
+                                                Encoding encoding) {
   Json::Value result;
   if (db_query.size() == 1) {
     std::string str_container;
@@ -266,12 +436,13 @@ std::string JSON::generic_single_result_to_json(const DbQuery &db_query, const s
     throw JsonException("Cannot transform multiple DB results (" + std::to_string(db_query.size()) +
                         std::string{") to JSON string!"});
   }
-  return json_value_to_string(result);
+  return encode(result, encoding);
 }
 
 std::string JSON::generic_single_complex_result_to_json(const DbQuery &db_query,
                                                         const std::vector<std::string> &column_names,
-                                                        const std::map<std::string, std::string> &name_mapping) {
+                                                        const std::map<std::string, std::string> &name_mapping,
+                                                  Encoding encoding) {
   Json::Value result;
   if (db_query.size() == 1) {
     std::string str_container;
@@ -296,7 +467,7 @@ std::string JSON::generic_single_complex_result_to_json(const DbQuery &db_query,
     throw JsonException("Cannot transform multiple DB results (" + std::to_string(db_query.size()) +
                         std::string{") to JSON string!"});
   }
-  return json_value_to_string(result);
+  return encode(result, encoding);
 }
 
 std::string JSON::json_value_to_string(const Json::Value &value) {
@@ -305,6 +476,102 @@ std::string JSON::json_value_to_string(const Json::Value &value) {
   return Json::writeString(json_writer, value);
 }
 
+std::string JSON::encode(const Json::Value &value, Encoding encoding) {
+  return Encoding::cbor == encoding ? utils::json_to_cbor(value) : json_value_to_string(value);
+}
+
+std::string JSON::media_type(Encoding encoding) {
+  return Encoding::cbor == encoding ? utils::CBOR_MEDIA_TYPE : "application/json";
+}
+
+PhraseJsonStream::PhraseJsonStream(const Json::Value &user_options, Encoding encoding)
+    : encoding_{encoding},
+      show_phrase_{true},
+      show_word_class_{true},
+      show_gender_{true},
+      show_numerus_{true},
+      show_abbreviation_{true},
+      show_comment_{true},
+      current_id_{},
+      current_item_{},
+      written_items_{0} {
+  if (user_options.isObject()) {
+    this->show_phrase_ = get_bool_from_json_object(user_options, "show_phrase", this->show_phrase_);
+    this->show_word_class_ = get_bool_from_json_object(user_options, "show_word_class", this->show_word_class_);
+    this->show_gender_ = get_bool_from_json_object(user_options, "show_gender", this->show_gender_);
+    this->show_numerus_ = get_bool_from_json_object(user_options, "show_numerus", this->show_numerus_);
+    this->show_abbreviation_ = get_bool_from_json_object(user_options, "show_abbreviation", this->show_abbreviation_);
+    this->show_comment_ = get_bool_from_json_object(user_options, "show_comment", this->show_comment_);
+  }
+}
+
+std::string PhraseJsonStream::append(const DbQuery &db_query) {
+  std::string result;
+  for (const pqxx::tuple &row : db_query) {
+    std::string id;
+    row["phrase_id_out"].to(id);
+    // the rows are ordered by phrase_id_out, so a new id completes the current translation
+    if (id != this->current_id_) result += this->write_current_item();
+    this->current_id_ = id;
+    this->merge_row(row, db_query.uses_translation_lookup());
+  }
+  return result;
+}
+
+std::string PhraseJsonStream::finish() {
+  std::string result{this->write_current_item()};
+  if (Encoding::cbor == this->encoding_) {
+    // the break that ends the array of indefinite length, an empty array is written with its length
+    return this->written_items_ ? result + '\xFF' : std::string(1, '\x80');
+  }
+  return this->written_items_ ? result + "]" : "[]";
+}
+
+void PhraseJsonStream::merge_row(const pqxx::tuple &row, bool translation_lookup) {
+  std::string value;
+  auto merge_string = [&row, &value, this](bool show, const char *column, const char *member) {
+    value.clear();
+    if (show) row[column].to(value);
+    if (!value.empty()) this->current_item_[member] = value;
+  };
+  merge_string(this->show_phrase_, "phrase_out", "phrase");
+  merge_string(this->show_word_class_, "word_class_out", "word_class");
+  merge_string(this->show_gender_, "gender_out", "gender");
+  merge_string(this->show_numerus_, "numerus_out", "numerus");
+  if (translation_lookup) {
+    if (this->show_abbreviation_) {
+      merge_array_into_json_object(this->current_item_, "abbreviations",
+                                   json_array_from_field(row["abbreviations_out"]));
+    }
+    if (this->show_comment_)
+      merge_array_into_json_object(this->current_item_, "comments", json_array_from_field(row["comments_out"]));
+    return;
+  }
+  auto merge_value = [&row, &value, this](bool show, const char *column, const char *member) {
+    value.clear();
+    if (show) row[column].to(value);
+    if (!value.empty() && !json_object_contains_value_in_array(this->current_item_, member, value))
+      append_value_to_array_in_json_object(this->current_item_, member, value);
+  };
+  merge_value(this->show_abbreviation_, "abbriviation_out", "abbreviations");
+  merge_value(this->show_comment_, "comment_out", "comments");
+}
+
+std::string PhraseJsonStream::write_current_item() {
+  if (this->current_item_.isNull()) return "";
+  std::string result;
+  if (Encoding::cbor == this->encoding_) {
+    // the head of an array of indefinite length
+    if (!this->written_items_) result += '\x9F';
+    utils::append_cbor(this->current_item_, result);
+  } else {
+    result = (this->written_items_ ? "," : "[") + JSON::json_value_to_string(this->current_item_);
+  }
+  ++this->written_items_;
+  this->current_item_ = Json::Value{};
+  return result;
+}
+
 }  // server
 }  // translate
 }  // lgeorgieff
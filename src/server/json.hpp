@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 05/04/2015
+// Last modified: 10/19/2026
 // Description: Declares a class with several static methods for transforming DB query results into JSON string.
 // ====================================================================================================================
 
@@ -23,6 +23,9 @@
 
 #include "json/json.h"
 
+#include <pqxx/pqxx>
+
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <map>
@@ -31,7 +34,11 @@ namespace lgeorgieff {
 namespace translate {
 namespace server {
 
-// A static class that transforms DB results in form of DbQuery instances into JSON strings.
+// The encodings of a response, JSON text or the binary CBOR encoding of the same values, see RFC 7049.
+enum class Encoding { json, cbor };
+
+// A static class that transforms DB results in form of DbQuery instances into JSON strings. Each result is encoded as
+// JSON text unless another encoding is passed.
 class JSON {
  public:
   // The character string that is used for the final json string indentation.
@@ -39,39 +46,57 @@ class JSON {
   static const std::string JSON_INDENTATION_STRING;
 
   // Transforms a set of all languages from te DB into a JSON array.
-  static std::string all_languages_to_json(const DbQuery &);
+  static std::string all_languages_to_json(const DbQuery &, Encoding = Encoding::json);
   // Transforms a language name from the DB into a JSON string.
-  static std::string language_name_to_json(const DbQuery &);
+  static std::string language_name_to_json(const DbQuery &, Encoding = Encoding::json);
   // Transforms a language id from the DB into a JSON string.
-  static std::string language_id_to_json(const DbQuery &);
+  static std::string language_id_to_json(const DbQuery &, Encoding = Encoding::json);
 
   // Transforms a set of all word classes from te DB into a JSON array.
-  static std::string all_word_classes_to_json(const DbQuery &);
+  static std::string all_word_classes_to_json(const DbQuery &, Encoding = Encoding::json);
   // Transforms a word class name from the DB into a JSON object.
-  static std::string word_class_name_to_json(const DbQuery &);
+  static std::string word_class_name_to_json(const DbQuery &, Encoding = Encoding::json);
   // Transforms a word class id from the DB into a JSON object.
-  static std::string word_class_id_to_json(const DbQuery &);
+  static std::string word_class_id_to_json(const DbQuery &, Encoding = Encoding::json);
 
   // Transforms a set of all genders from te DB into a JSON array.
-  static std::string all_genders_to_json(const DbQuery &);
+  static std::string all_genders_to_json(const DbQuery &, Encoding = Encoding::json);
   // Transforms a gender name from the DB into a JSON string.
-  static std::string gender_name_to_json(const DbQuery &);
+  static std::string gender_name_to_json(const DbQuery &, Encoding = Encoding::json);
   // Transforms a gender id from the DB into a JSON string.
-  static std::string gender_id_to_json(const DbQuery &);
+  static std::string gender_id_to_json(const DbQuery &, Encoding = Encoding::json);
 
   // Transforms a set of all numeri from te DB into a JSON array.
-  static std::string all_numeri_to_json(const DbQuery &);
+  static std::string all_numeri_to_json(const DbQuery &, Encoding = Encoding::json);
 
   // Transforms a DB result for a phrase translation corresponding to the passed DbQuery and Json::Value.
   // The Json::Value string contains the request (POST) data from the user that specifies what the answer should
   // contain, e.g.
   // comments, abbreviations, ...
-  static std::string phrase_to_json(const DbQuery &, const Json::Value &);
+  static std::string phrase_to_json(const DbQuery &, const Json::Value &, Encoding = Encoding::json);
+
+  // Transforms a DB result for a pivot translation, see DbQuery::request_pivot_phrase, into the same JSON string as
+  // phrase_to_json. Each translation additionally contains its provenance and the hub phrases it was reached by.
+  static std::string pivot_phrase_to_json(const DbQuery &, const Json::Value &, Encoding = Encoding::json);
+
+  // Transforms a list of phrase completions into a JSON array.
+  static std::string completions_to_json(const std::vector<std::string> &, Encoding = Encoding::json);
+  // Transforms a list of phrases found by their comments or abbreviations into a JSON array.
+  static std::string search_results_to_json(const std::vector<std::string> &, Encoding = Encoding::json);
 
   // Returns a string value that represents the passed json value.
   static std::string json_value_to_string(const Json::Value &);
+  // Returns the passed json value in the passed encoding, i.e. the result of json_value_to_string for JSON.
+  static std::string encode(const Json::Value &, Encoding);
+  // Returns the media type of the passed encoding, e.g. "application/json".
+  static std::string media_type(Encoding);
 
  private:
+  // Transforms a DB result of the table translation_lookup into the same JSON string as phrase_to_json. The boolean
+  // values correspond to the user options show_phrase, show_word_class, show_gender, show_numerus, show_abbreviation
+  // and show_comment.
+  static std::string translation_lookup_to_json(const DbQuery &, bool, bool, bool, bool, bool, bool, Encoding);
+
   JSON() = delete;
   JSON(const JSON &) = delete;
   JSON &operator=(const JSON &) = delete;
@@ -82,15 +107,54 @@ class JSON {
   // A private helper method for transforming a DB result with multiple rows and multiple columns into a JSON array of
   // objects.
   static std::string generic_multiple_result_to_json(const DbQuery &, const std::vector<std::string> &,
-                                                     const std::map<std::string, std::string> &);
+                                                     const std::map<std::string, std::string> &, Encoding);
   // A private helper method for transforming a DB result with a single row and a single column into a JSON string.
-  static std::string generic_single_result_to_json(const DbQuery &, const std::string &);
+  static std::string generic_single_result_to_json(const DbQuery &, const std::string &, Encoding);
   // A private helper method for transforming a DB result with multiple rowa and a single column into a JSON array of
   // strings.
   static std::string generic_single_complex_result_to_json(const DbQuery &, const std::vector<std::string> &,
-                                                           const std::map<std::string, std::string> &);
+                                                           const std::map<std::string, std::string> &, Encoding);
 };  // JSON
 
+// Transforms the rows of a streamed phrase request, see DbQuery::stream, into the same JSON array as
+// JSON::phrase_to_json piece by piece. Since the rows are ordered by the target phrase, a translation is complete as
+// soon as a row of the next target phrase is read, so only a single translation is kept in memory. Unlike
+// phrase_to_json, the translations are not merged by their visible members but by their target phrase.
+// In CBOR, the translations are written as an array of indefinite length, since their number is not known in advance.
+class PhraseJsonStream {
+ public:
+  // Instantiates a stream for the passed request (POST) data from the user, see JSON::phrase_to_json, and the passed
+  // encoding of the array.
+  explicit PhraseJsonStream(const Json::Value &, Encoding = Encoding::json);
+  PhraseJsonStream(const PhraseJsonStream &) = delete;
+  PhraseJsonStream &operator=(const PhraseJsonStream &) = delete;
+  ~PhraseJsonStream() = default;
+
+  // Reads all rows of the passed DbQuery and returns the encoded translations that were completed, the first one is
+  // preceded by the start of the array.
+  std::string append(const DbQuery &);
+  // Returns the last encoded translation and the end of the array.
+  std::string finish();
+
+ private:
+  // Merges the passed row into the current translation.
+  void merge_row(const pqxx::tuple &, bool);
+  // Returns the encoded current translation and starts a new one.
+  std::string write_current_item();
+
+  Encoding encoding_;
+
+  bool show_phrase_;
+  bool show_word_class_;
+  bool show_gender_;
+  bool show_numerus_;
+  bool show_abbreviation_;
+  bool show_comment_;
+  std::string current_id_;
+  Json::Value current_item_;
+  size_t written_items_;
+};  // PhraseJsonStream
+
 }  // server
 }  // translate
 }  // lgeorgieff
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/14/2015
+// Last modified: 10/19/2026
 // Description: Defines the RESTful server for the translation service.
 // ====================================================================================================================
 
@@ -19,31 +19,61 @@
 #include "server.hpp"
 #include "server_exception.hpp"
 #include "json.hpp"
+#include "utils/cbor.hpp"
 #include "utils/helper.hpp"
 #include "utils/exception.hpp"
+#include "utils/phrase_key.hpp"
 
 #include "json/json.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace {
 // A helper function that sets the passed HTTP status code on the passed connection structure and finally writes the
-// given error message to the connection structure.
-void handle_http_error(mg_connection *connection, int status_code, const std::string &message) {
+// given error message to the connection structure. If retry_after is positive, it is sent as header "retry-after".
+void handle_http_error(mg_connection *connection, int status_code, const std::string &message, long retry_after = 0) {
   std::cerr << "HTTP " << status_code << ": " << message << std::endl;
   mg_send_status(connection, status_code);
+  if (0 < retry_after) mg_send_header(connection, "retry-after", std::to_string(retry_after).c_str());
   mg_send_header(connection, "content-type", "application/json");
   std::string json_string{lgeorgieff::translate::server::JSON::json_value_to_string(message)};
   mg_printf_data(connection, "%s", json_string.c_str());
 }
 
-// A helper function that sets the HTTP content-type "application/json" and writes the passed json string to the HTTP
-// connection.
-void send_json_data(mg_connection *connection, const std::string &json_string) {
-  mg_send_header(connection, "content-type", "application/json");
-  mg_printf_data(connection, "%s", json_string.c_str());
+// A helper function that sets the HTTP content-type of the passed encoding and writes the passed json string or CBOR
+// data to the HTTP connection.
+void send_json_data(mg_connection *connection, const std::string &json_string,
+                    lgeorgieff::translate::server::Encoding encoding = lgeorgieff::translate::server::Encoding::json) {
+  mg_send_header(connection, "content-type", lgeorgieff::translate::server::JSON::media_type(encoding).c_str());
+  // CBOR data may contain null bytes
+  mg_send_data(connection, json_string.data(), static_cast<int>(json_string.size()));
+}
+
+// A helper function that reads the query variable "limit" of the passed connection. The passed default value is kept
+// if the variable is missing, false is returned if it is not a valid number.
+bool get_limit_from_query(mg_connection *connection, size_t &limit) {
+  char limit_value[32];
+  int limit_length{mg_get_var(connection, "limit", limit_value, sizeof(limit_value))};
+  if (-1 == limit_length) return true;
+  if (0 > limit_length) return false;
+  try {
+    limit = lgeorgieff::translate::utils::string_to_size_t(limit_value);
+    return true;
+  } catch (const std::invalid_argument &) {
+    return false;
+  }
 }
 
 // A helper function that checks the given connection for the accept header value.
@@ -51,6 +81,94 @@ bool check_accept_header(mg_connection *connection, const std::string &expected
   return mg_get_header(connection, "accept") != nullptr &&
          lgeorgieff::translate::utils::check_accept_header(mg_get_header(connection, "accept"), expected);
 }
+
+// A helper function that chooses the encoding of the response from the accept header of the given connection. CBOR is
+// only chosen if the header names it with a quality value above 0 and not below the one of JSON, so clients that
+// accept any type keep getting JSON. Returns false if neither JSON nor CBOR is accepted.
+bool get_encoding_from_accept_header(mg_connection *connection, lgeorgieff::translate::server::Encoding &encoding) {
+  encoding = lgeorgieff::translate::server::Encoding::json;
+  const char *accept_header{mg_get_header(connection, "accept")};
+  if (!accept_header) return false;
+  const double cbor_quality{
+      lgeorgieff::translate::utils::accept_header_quality(accept_header, lgeorgieff::translate::utils::CBOR_MEDIA_TYPE,
+                                                          true)};
+  if (0 < cbor_quality && lgeorgieff::translate::utils::accept_header_quality(accept_header) <= cbor_quality) {
+    encoding = lgeorgieff::translate::server::Encoding::cbor;
+    return true;
+  }
+  return check_accept_header(connection);
+}
+
+// A helper function that reads the passed member "cursor" of a translation request, i.e. the id of the last target
+// phrase of the previous page. An empty string keeps the passed value, false is returned if it is not a valid id.
+bool get_cursor_from_json(const Json::Value &cursor, uint32_t &after) {
+  if (!cursor.isString()) return false;
+  if (cursor.asString().empty()) return true;
+  try {
+    size_t id{lgeorgieff::translate::utils::string_to_size_t(cursor.asString())};
+    if (id > std::numeric_limits<uint32_t>::max()) return false;
+    after = static_cast<uint32_t>(id);
+    return true;
+  } catch (const std::invalid_argument &) {
+    return false;
+  }
+}
+
+// The state of a streamed translation request, it is stored as connection_param of its connection. Each stream owns
+// a data base connection, since its cursor keeps a transaction open while further requests are handled.
+struct TranslationStream {
+  TranslationStream(const lgeorgieff::translate::server::ConnectionString &connection_string, bool translation_lookup,
+                    size_t batch_size, const Json::Value &user_options,
+                    lgeorgieff::translate::server::Encoding encoding)
+      : db_query{connection_string}, json_stream{user_options, encoding} {
+    this->db_query.use_translation_lookup(translation_lookup).stream(batch_size);
+  }
+
+  lgeorgieff::translate::server::DbQuery db_query;
+  lgeorgieff::translate::server::PhraseJsonStream json_stream;
+};
+
+// Passes the payload of each notification on the passed channel of the passed connection to the passed function. The
+// notifications are received while the connection awaits them.
+class NotificationReceiver : public pqxx::notification_receiver {
+ public:
+  NotificationReceiver(pqxx::connection_base &connection, const std::string &channel,
+                       std::function<void(const std::string &)> receive)
+      : pqxx::notification_receiver{connection, channel}, receive_{receive} {}
+
+  void operator()(const std::string &payload, int) override { this->receive_(payload); }
+
+ private:
+  std::function<void(const std::string &)> receive_;
+};
+
+// A helper function that sends the next rows of the translation stream of the passed connection until more than the
+// passed number of bytes are waiting to be sent. Returns false and deletes the stream after its last row was sent.
+bool continue_translation_stream(mg_connection *connection, size_t buffer_size) {
+  TranslationStream *translation_stream{static_cast<TranslationStream *>(connection->connection_param)};
+  bool open{true};
+  try {
+    // mg_write returns the number of bytes that still wait to be sent
+    while (open && mg_write(connection, "", 0) <= buffer_size) {
+      if (translation_stream->db_query.fetch()) {
+        std::string json{translation_stream->json_stream.append(translation_stream->db_query)};
+        if (!json.empty()) mg_send_data(connection, json.data(), static_cast<int>(json.size()));
+      } else {
+        std::string json{translation_stream->json_stream.finish()};
+        mg_send_data(connection, json.data(), static_cast<int>(json.size()));
+        open = false;
+      }
+    }
+  } catch (const std::exception &err) {
+    // the status is already sent, so the response is just truncated
+    std::cerr << "Translation stream aborted: " << err.what() << std::endl;
+    open = false;
+  }
+  if (open) return true;
+  delete translation_stream;
+  connection->connection_param = nullptr;
+  return false;
+}
 }  // anonymous namespace
 
 namespace lgeorgieff {
@@ -62,6 +180,7 @@ using lgeorgieff::translate::utils::cstring_ends_with;
 using lgeorgieff::translate::utils::get_last_path_from_url;
 using lgeorgieff::translate::utils::get_exe_path;
 using lgeorgieff::translate::utils::Exception;
+using lgeorgieff::translate::utils::FuzzyIndex;
 
 std::string Server::service_prefix_{"/trlt/"};
 std::string Server::url_help_{service_prefix_ + "help/"};
@@ -76,26 +195,300 @@ std::string Server::url_gender_id_prefix_{service_prefix_ + "gender/id/"};
 std::string Server::url_gender_name_prefix_{service_prefix_ + "gender/name/"};
 std::string Server::url_numeri_{service_prefix_ + "numeri/"};
 std::string Server::url_translation_prefix_{service_prefix_ + "translation/"};
+std::string Server::url_complete_prefix_{service_prefix_ + "complete/"};
+std::string Server::url_search_prefix_{service_prefix_ + "search/"};
+std::string Server::url_ready_{service_prefix_ + "ready/"};
+std::string Server::url_metrics_{service_prefix_ + "metrics/"};
+const size_t Server::DEFAULT_COMPLETION_LIMIT{10};
+const size_t Server::DEFAULT_SEARCH_LIMIT{50};
+const size_t Server::FUZZY_CANDIDATES{5};
+const size_t Server::STREAM_BATCH_SIZE{100};
+const size_t Server::STREAM_BUFFER_SIZE{16384};
+const std::chrono::milliseconds Server::MAX_TRANSLATION_DELAY{1000};
+const std::chrono::milliseconds Server::MAX_REFERENCE_DELAY{3000};
+const size_t Server::MAX_STREAMS{32};
+const double Server::LATENCY_WEIGHT{0.2};
+const size_t Server::TRANSLATION_CACHE_SIZE{10000};
+const size_t Server::WARMUP_KEYS{1000};
+const size_t Server::WARMUP_CONNECTIONS{4};
+const std::chrono::seconds Server::WARMUP_SAVE_INTERVAL{300};
+const size_t Server::NEGATIVE_CACHE_SIZE{10000};
+const std::chrono::seconds Server::CHANGE_LISTENER_RETRY{10};
+const std::chrono::seconds Server::NEGATIVE_CACHE_TTL{3600};
+const std::string Server::DEFAULT_HUB_LANGUAGE{"EN"};
+const double Server::DEFAULT_FILTER_FALSE_POSITIVE_RATE{0.01};
+const std::string Server::DATA_CHANGED_CHANNEL{"trlt_data_changed"};
+volatile std::sig_atomic_t Server::reload_requested_{0};
+volatile std::sig_atomic_t Server::stop_requested_{0};
 
-Server::Server(const ConnectionString &db_connection_string, const std::string &service_address, size_t service_port)
+Server::Server(const ConnectionString &db_connection_string, const std::string &service_address, size_t service_port,
+               bool translation_lookup, const std::string &hub_language, const std::string &warmup_file,
+               double filter_false_positive_rate, const std::string &unix_socket)
     : connection_address_{service_address + ":" + std::to_string(service_port)},
+      unix_socket_{unix_socket},
+      connection_string_{db_connection_string},
       db_query_{db_connection_string},
-      server_{mg_create_server(&db_query_, Server::request_handler)} {
+      hub_language_{hub_language},
+      snapshot_{},
+      reload_thread_{},
+      reloading_{false},
+      pending_reload_{false, {}},
+      change_listener_thread_{},
+      listening_for_changes_{true},
+      data_changes_{false, {}},
+      data_changes_mutex_{},
+      translation_cache_{TRANSLATION_CACHE_SIZE},
+      translation_cache_version_{1},
+      negative_cache_{NEGATIVE_CACHE_SIZE},
+      negative_cache_hits_{0},
+      warmup_file_{warmup_file},
+      warmup_thread_{},
+      warming_up_{false},
+      warmup_translations_{},
+      filter_false_positive_rate_{filter_false_positive_rate},
+      filtered_translations_{0},
+      unfiltered_misses_{0},
+      round_start_{},
+      round_translations_{0},
+      translation_latency_{0},
+      open_streams_{0},
+      shed_requests_{0},
+      request_url_{},
+      json_reader_{Json::CharReaderBuilder{}.newCharReader()},
+      server_{mg_create_server(this, Server::request_handler)} {
   if (!this->server_) throw ServerException("Server resources could not be allocated!");
-  mg_set_option(this->server_, "listening_port", this->connection_address_.c_str());
+  this->db_query_.use_translation_lookup(translation_lookup);
+  this->snapshot_ = build_snapshot(this->db_query_, 1, this->filter_false_positive_rate_);
+  std::string listening_ports{this->connection_address_};
+  if (!this->unix_socket_.empty()) {
+    // a socket file of a previous run is not removed if the server was killed
+    std::remove(this->unix_socket_.c_str());
+    listening_ports += ",unix://" + this->unix_socket_;
+  }
+  if (mg_set_option(this->server_, "listening_port", listening_ports.c_str())) {
+    mg_destroy_server(&this->server_);
+    throw ServerException("The server could not be bound to \"" + listening_ports + "\"!");
+  }
+
+  std::vector<std::string> warmup_keys;
+  std::ifstream warmup_stream{this->warmup_file_};
+  for (std::string key; warmup_stream && std::getline(warmup_stream, key);)
+    if (!key.empty()) warmup_keys.push_back(key);
+  if (!warmup_keys.empty()) {
+    this->warming_up_ = true;
+    this->warmup_thread_ = std::thread{&Server::warm_up, this, std::move(warmup_keys)};
+  }
+  this->change_listener_thread_ = std::thread{&Server::listen_for_changes, this};
 }
 
 void Server::listen() {
-  while (true) {
-    mg_poll_server(this->server_, 1000);  // Infinite loop, Ctrl-C to stop
+  std::chrono::steady_clock::time_point last_save{std::chrono::steady_clock::now()};
+  while (!stop_requested_) {
+    this->round_start_ = std::chrono::steady_clock::time_point{};
+    this->round_translations_ = 0;
+    mg_poll_server(this->server_, 1000);
+    if (reload_requested_) {
+      reload_requested_ = 0;
+      this->pending_reload_.add(DataChange{true, {}});
+    }
+    DataChange data_changes{false, {}};
+    {
+      std::lock_guard<std::mutex> lock{this->data_changes_mutex_};
+      std::swap(data_changes, this->data_changes_);
+    }
+    // the responses are evicted right away and once more when the snapshot with the changes is published, since
+    // requests are answered from the current snapshot until then
+    this->evict(data_changes);
+    this->pending_reload_.add(data_changes);
+    this->evict_outdated(*this->snapshot());
+    if (!this->pending_reload_.empty() && !this->reloading_) {
+      this->reload(this->pending_reload_);
+      this->pending_reload_ = DataChange{false, {}};
+    }
+    if (this->warmup_thread_.joinable() && !this->warming_up_) {
+      this->warmup_thread_.join();
+      for (std::pair<std::string, CachedTranslation> &translation : this->warmup_translations_)
+        this->translation_cache_.put(translation.first, std::move(translation.second));
+      this->warmup_translations_.clear();
+      std::cerr << "Translation cache warmed up with " << this->translation_cache_.size() << " translations"
+                << std::endl;
+    }
+    if (!this->warmup_thread_.joinable() && std::chrono::steady_clock::now() - last_save > WARMUP_SAVE_INTERVAL) {
+      this->save_warmup_keys();
+      last_save = std::chrono::steady_clock::now();
+    }
   }
+  if (!this->warmup_thread_.joinable()) this->save_warmup_keys();
 }
 
+void Server::request_stop() noexcept { stop_requested_ = 1; }
+
+void Server::warm_up(const std::vector<std::string> &keys) {
+  std::vector<std::vector<std::pair<std::string, CachedTranslation>>> translations(WARMUP_CONNECTIONS);
+  std::vector<std::thread> workers;
+  for (size_t worker{0}; worker != WARMUP_CONNECTIONS; ++worker) {
+    workers.emplace_back([this, &keys, &translations, worker]() {
+      try {
+        // the connection of db_query_ is used by the request handler meanwhile
+        DbQuery db_query{this->connection_string_};
+        db_query.use_translation_lookup(this->db_query_.uses_translation_lookup());
+        std::shared_ptr<const Snapshot> snapshot{this->snapshot()};
+        Json::CharReaderBuilder json_reader_factory;
+        std::unique_ptr<Json::CharReader> json_reader{json_reader_factory.newCharReader()};
+        for (size_t pos{worker}; pos < keys.size(); pos += WARMUP_CONNECTIONS) {
+          // <language id source>\t<language id target>\t<POST data>[\tcbor], see translation_cache_key
+          std::vector<std::string> parts{utils::split_string(keys[pos], '\t')};
+          Json::Value user_options;
+          TranslationRequest request;
+          const Encoding encoding{4 == parts.size() ? Encoding::cbor : Encoding::json};
+          if ((3 != parts.size() && 4 != parts.size()) ||
+              !json_reader->parse(parts[2].data(), parts[2].data() + parts[2].size(), &user_options, nullptr) ||
+              !this->parse_translation_request(parts[0], parts[1], user_options, encoding, request).empty() ||
+              translation_cache_key(request) != keys[pos])
+            continue;
+          std::string resolved_phrase{this->request_translation(db_query, *snapshot, request)};
+          if (db_query.empty()) continue;
+          translations[worker].emplace_back(keys[pos],
+                                            CachedTranslation{translation_to_json(db_query, request), resolved_phrase});
+        }
+      } catch (const std::exception &err) {
+        std::cerr << "Warm-up connection " << worker << " failed: " << err.what() << std::endl;
+      }
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+  for (auto &worker_translations : translations) {
+    for (auto &translation : worker_translations) this->warmup_translations_.push_back(std::move(translation));
+  }
+  this->warming_up_ = false;
+}
+
+void Server::save_warmup_keys() {
+  if (this->warmup_file_.empty()) return;
+  // the file is replaced at once, so an interrupted write keeps the previous keys
+  std::string temporary_file{this->warmup_file_ + ".tmp"};
+  {
+    std::ofstream warmup_stream{temporary_file, std::ios::trunc};
+    for (const std::string &key : this->translation_cache_.most_used(WARMUP_KEYS)) warmup_stream << key << '\n';
+    if (!warmup_stream) {
+      std::cerr << "The warm-up file \"" << temporary_file << "\" could not be written" << std::endl;
+      return;
+    }
+  }
+  if (std::rename(temporary_file.c_str(), this->warmup_file_.c_str()))
+    std::cerr << "The warm-up file \"" << this->warmup_file_ << "\" could not be replaced" << std::endl;
+}
+
+void Server::reload() { this->reload(DataChange{true, {}}); }
+
+void Server::reload(const DataChange &changes) {
+  if (this->reloading_) return;
+  if (this->reload_thread_.joinable()) this->reload_thread_.join();
+  this->reloading_ = true;
+  const size_t version{this->snapshot()->version + 1};
+  this->reload_thread_ = std::thread{[this, version, changes]() {
+    try {
+      // the connection of db_query_ is used by the request handler meanwhile
+      DbQuery db_query{this->connection_string_};
+      std::shared_ptr<Snapshot> next_snapshot{build_snapshot(db_query, version, this->filter_false_positive_rate_)};
+      next_snapshot->changes = changes;
+      std::shared_ptr<const Snapshot> snapshot{std::move(next_snapshot)};
+      if (snapshot->completion_indexes.empty()) {
+        // the data base is being re-initialized, e.g. by populate_db.sh
+        std::cerr << "Snapshot " << version << " is empty, the current snapshot is kept" << std::endl;
+      } else {
+        std::atomic_store(&this->snapshot_, snapshot);
+        std::cerr << "Snapshot " << version << " published" << std::endl;
+      }
+    } catch (const std::exception &err) {
+      std::cerr << "Snapshot " << version << " could not be built: " << err.what() << std::endl;
+    }
+    this->reloading_ = false;
+  }};
+}
+
+void Server::request_reload() noexcept { reload_requested_ = 1; }
+
+void Server::evict_outdated(const Snapshot &snapshot) {
+  if (snapshot.version == this->translation_cache_version_) return;
+  this->evict(snapshot.changes);
+  this->translation_cache_version_ = snapshot.version;
+}
+
+void Server::evict(const DataChange &changes) {
+  if (changes.empty()) return;
+  if (changes.all) {
+    this->translation_cache_.clear();
+    this->negative_cache_.clear();
+    return;
+  }
+  // <language id source>\t<language id target>\t<POST data>[\tcbor], see translation_cache_key
+  auto outdated = [&changes](const std::string &key) {
+    const size_t target_begin{key.find('\t') + 1};
+    return changes.contains(key.substr(0, target_begin - 1)) ||
+           changes.contains(key.substr(target_begin, key.find('\t', target_begin) - target_begin));
+  };
+  const size_t evicted{this->translation_cache_.erase_if(outdated) + this->negative_cache_.erase_if(outdated)};
+  std::cerr << "Evicted " << evicted << " cached responses of the changed languages";
+  for (const std::string &language : changes.languages) std::cerr << " " << language;
+  std::cerr << std::endl;
+}
+
+void Server::listen_for_changes() {
+  bool missed_changes{false};
+  while (!stop_requested_ && this->listening_for_changes_) {
+    try {
+      pqxx::connection connection{this->connection_string_.to_string()};
+      NotificationReceiver receiver{connection, DATA_CHANGED_CHANNEL, [this](const std::string &payload) {
+        DataChange changes{false, {}};
+        for (const std::string &language : utils::split_string(payload, ' ', true)) changes.languages.insert(language);
+        changes.all = changes.languages.empty();
+        std::lock_guard<std::mutex> lock{this->data_changes_mutex_};
+        this->data_changes_.add(changes);
+      }};
+      // notifications are only received while the connection listens, so all data may have changed meanwhile
+      if (missed_changes) {
+        std::lock_guard<std::mutex> lock{this->data_changes_mutex_};
+        this->data_changes_.add(DataChange{true, {}});
+        missed_changes = false;
+      }
+      while (!stop_requested_ && this->listening_for_changes_) connection.await_notification(1, 0);
+    } catch (const std::exception &err) {
+      std::cerr << "Listening on \"" << DATA_CHANGED_CHANNEL << "\" failed: " << err.what() << std::endl;
+      missed_changes = true;
+      for (std::chrono::seconds waited{0};
+           waited < CHANGE_LISTENER_RETRY && !stop_requested_ && this->listening_for_changes_;
+           waited += std::chrono::seconds{1})
+        std::this_thread::sleep_for(std::chrono::seconds{1});
+    }
+  }
+}
+
+void Server::DataChange::add(const DataChange &other) {
+  this->all = this->all || other.all;
+  this->languages.insert(other.languages.begin(), other.languages.end());
+}
+
+bool Server::DataChange::empty() const noexcept { return !this->all && this->languages.empty(); }
+
+bool Server::DataChange::contains(const std::string &language) const {
+  return this->all || this->languages.count(language);
+}
+
+size_t Server::snapshot_version() const { return this->snapshot()->version; }
+
+std::shared_ptr<const Server::Snapshot> Server::snapshot() const { return std::atomic_load(&this->snapshot_); }
+
 Server::~Server() {
+  this->listening_for_changes_ = false;
+  if (this->change_listener_thread_.joinable()) this->change_listener_thread_.join();
+  if (this->reload_thread_.joinable()) this->reload_thread_.join();
+  if (this->warmup_thread_.joinable()) this->warmup_thread_.join();
   if (this->server_) {
     mg_destroy_server(&this->server_);
     this->server_ = nullptr;
   }
+  if (!this->unix_socket_.empty()) std::remove(this->unix_socket_.c_str());
 }
 
 std::string Server::get_origin_language_id_from_url(const char *url) {
@@ -117,24 +510,251 @@ std::string Server::get_target_language_id_from_url(const char *url) {
   return language_id;
 }
 
+std::string Server::get_completion_language_id_from_url(const char *url) {
+  // don't check prefix here, must be ensured outside this function
+  url += strlen(url_complete_prefix_.c_str());
+  std::string language_id{};
+  for (; *url && '/' != *url; ++url) language_id += *url;
+  return language_id;
+}
+
+std::string Server::get_completion_prefix_from_url(const char *url) {
+  // don't check prefix and language id here, must be ensured outside this function
+  url += strlen(url_complete_prefix_.c_str());
+  for (; *url && '/' != *url; ++url)
+    ;
+  if (*url) ++url;
+  // the prefix itself may contain '/', only the closing separator is removed
+  std::string prefix{url};
+  if (!prefix.empty() && '/' == prefix.back()) prefix.pop_back();
+  return prefix;
+}
+
+std::string Server::get_search_language_id_from_url(const char *url) {
+  // don't check prefix here, must be ensured outside this function
+  url += strlen(url_search_prefix_.c_str());
+  std::string language_id{};
+  for (; *url && '/' != *url; ++url) language_id += *url;
+  return language_id;
+}
+
+std::shared_ptr<Server::Snapshot> Server::build_snapshot(DbQuery &db_query, size_t version,
+                                                         double filter_false_positive_rate) {
+  std::shared_ptr<Snapshot> snapshot{std::make_shared<Snapshot>()};
+  snapshot->version = version;
+  build_phrase_indexes(db_query, filter_false_positive_rate, *snapshot);
+  build_annotation_index(db_query, *snapshot);
+  return snapshot;
+}
+
+void Server::build_phrase_indexes(DbQuery &db_query, double filter_false_positive_rate, Snapshot &snapshot) {
+  db_query.request_phrase_popularity();
+  // the size of each phrase filter must be known before the first phrase is added
+  std::map<std::string, size_t> phrase_counts;
+  for (const pqxx::tuple &row : db_query) ++phrase_counts[row[0].c_str()];
+  for (const std::pair<const std::string, size_t> &phrase_count : phrase_counts) {
+    snapshot.phrase_filters.emplace(phrase_count.first,
+                                    utils::BloomFilter{phrase_count.second, filter_false_positive_rate});
+  }
+  for (const pqxx::tuple &row : db_query) {
+    std::string language_id, phrase;
+    size_t popularity;
+    row[0].to(language_id);
+    row[1].to(phrase);
+    row[2].to(popularity);
+    snapshot.completion_indexes[language_id].add(phrase, popularity);
+    snapshot.fuzzy_indexes[language_id].add(phrase, popularity);
+    snapshot.phrase_filters.at(language_id).add(utils::to_phrase_key(phrase));
+  }
+  db_query.clear();
+  for (auto &completion_index : snapshot.completion_indexes) completion_index.second.build();
+  for (auto &fuzzy_index : snapshot.fuzzy_indexes) fuzzy_index.second.build();
+}
+
+void Server::build_annotation_index(DbQuery &db_query, Snapshot &snapshot) {
+  db_query.request_phrase_annotations();
+  for (const pqxx::tuple &row : db_query) {
+    uint32_t id;
+    std::string language_id, phrase, annotation;
+    row[0].to(id);
+    row[1].to(language_id);
+    row[2].to(phrase);
+    row[3].to(annotation);
+    snapshot.annotation_index.add(annotation, id);
+    snapshot.annotated_phrases.emplace(id, std::make_pair(std::move(language_id), std::move(phrase)));
+  }
+  db_query.clear();
+  snapshot.annotation_index.build();
+}
+
+std::string Server::parse_translation_request(const std::string &origin_language_id,
+                                              const std::string &target_language_id, const Json::Value &user_options,
+                                              Encoding encoding, TranslationRequest &request) const {
+  request.origin_language_id = origin_language_id;
+  request.target_language_id = target_language_id;
+  request.user_options = user_options;
+  request.encoding = encoding;
+  if (user_options.isObject()) {
+    Json::Value extracted_phrase{user_options.get("phrase", "")};
+    if (!extracted_phrase.isString()) return "Expected a JSON object with at least the string member \"phrase\"!";
+    request.phrase = extracted_phrase.asString();
+  }
+  if (request.phrase.empty()) return "Phrase for translation must not be empty!";
+  Json::Value extracted_word_class{user_options.get("word_class", "")};
+  if (extracted_word_class.isString()) request.word_class = extracted_word_class.asString();
+  Json::Value extracted_fuzzy{user_options.get("fuzzy", 0)};
+  if (!extracted_fuzzy.isUInt() || extracted_fuzzy.asUInt() > FuzzyIndex::MAX_DISTANCE)
+    return "The member \"fuzzy\" must be a number between 0 and " + std::to_string(FuzzyIndex::MAX_DISTANCE) + "!";
+  request.fuzzy = extracted_fuzzy.asUInt();
+  // In pivot mode, the phrase is additionally translated through the hub language, which is only meaningful if
+  // neither the origin nor the target language is the hub language itself.
+  Json::Value extracted_pivot{user_options.get("pivot", false)};
+  if (extracted_pivot.isString() && !extracted_pivot.asString().empty()) {
+    request.hub_language_id = extracted_pivot.asString();
+  } else if (extracted_pivot.isBool()) {
+    if (extracted_pivot.asBool()) request.hub_language_id = this->hub_language_;
+  } else {
+    return "The member \"pivot\" must be a boolean or a language id!";
+  }
+  if (request.hub_language_id == origin_language_id || request.hub_language_id == target_language_id)
+    request.hub_language_id.clear();
+  // A large result is either requested page by page, where "cursor" continues after the last target phrase of the
+  // previous page, or streamed from a server-side cursor.
+  request.page = PhrasePage{0, 0};
+  Json::Value extracted_limit{user_options.get("limit", 0)};
+  Json::Value extracted_stream{user_options.get("stream", false)};
+  if (!extracted_limit.isUInt()) return "The member \"limit\" must be a positive number!";
+  if (!get_cursor_from_json(user_options.get("cursor", ""), request.page.after))
+    return "The member \"cursor\" must be the value of the header \"x-trlt-cursor\"!";
+  if (!extracted_stream.isBool()) return "The member \"stream\" must be a boolean!";
+  request.page.limit = extracted_limit.asUInt();
+  request.stream = extracted_stream.asBool();
+  const bool paged{request.page.limit || request.page.after};
+  if ((paged || request.stream) && !request.hub_language_id.empty())
+    return "Pivot translations cannot be paged or streamed!";
+  if (paged && request.stream) return "The members \"limit\" and \"cursor\" cannot be combined with \"stream\"!";
+  return "";
+}
+
+std::string Server::request_translation(DbQuery &db_query, const Snapshot &snapshot,
+                                        const TranslationRequest &request) {
+  auto phrase_filter = snapshot.phrase_filters.find(request.origin_language_id);
+  auto request_phrase = [&db_query, &request, &snapshot, &phrase_filter, this](const std::string &phrase) {
+    // phrases are matched by their search key, so the filter contains the keys
+    if (snapshot.phrase_filters.end() == phrase_filter ||
+        !phrase_filter->second.contains(utils::to_phrase_key(phrase))) {
+      db_query.clear();
+      ++this->filtered_translations_;
+      return;
+    }
+    if (!request.hub_language_id.empty() && request.word_class.empty()) {
+      db_query.request_pivot_phrase(phrase, request.origin_language_id, request.hub_language_id,
+                                    request.target_language_id);
+    } else if (!request.hub_language_id.empty()) {
+      db_query.request_pivot_phrase(phrase, request.origin_language_id, request.hub_language_id,
+                                    request.target_language_id, request.word_class);
+    } else if (request.word_class.empty()) {
+      db_query.request_phrase(phrase, request.origin_language_id, request.target_language_id, request.page);
+    } else {
+      db_query.request_phrase(phrase, request.origin_language_id, request.target_language_id, request.word_class,
+                              request.page);
+    }
+    if (db_query.empty()) ++this->unfiltered_misses_;
+  };
+  request_phrase(request.phrase);
+  // In fuzzy mode, a phrase without translation is resolved to the closest similar phrase that has one. A further
+  // page is not resolved again, since an empty page just means that no translation is left.
+  auto fuzzy_index = snapshot.fuzzy_indexes.find(request.origin_language_id);
+  if (db_query.empty() && request.fuzzy && !request.page.after && snapshot.fuzzy_indexes.end() != fuzzy_index) {
+    for (const std::string &suggestion : fuzzy_index->second.lookup(request.phrase, request.fuzzy, FUZZY_CANDIDATES)) {
+      if (suggestion == request.phrase) continue;
+      request_phrase(suggestion);
+      if (!db_query.empty()) return suggestion;
+    }
+  }
+  return request.phrase;
+}
+
+long Server::overload_retry_after(bool translation, bool stream) const {
+  const std::chrono::milliseconds delay{
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->round_start_)};
+  const std::chrono::milliseconds latency{static_cast<int64_t>(this->translation_latency_)};
+  bool overloaded{false};
+  if (!translation)
+    overloaded = delay > MAX_REFERENCE_DELAY;
+  else
+    overloaded = (stream && this->open_streams_ >= MAX_STREAMS) ||
+                 (this->round_translations_ && delay + latency > MAX_TRANSLATION_DELAY);
+  if (!overloaded) return 0;
+  // the requests that are waiting now are handled in about the same time
+  const std::chrono::seconds retry_after{std::chrono::duration_cast<std::chrono::seconds>(delay + latency)};
+  return std::max<long>(1, static_cast<long>(retry_after.count()));
+}
+
+std::string Server::translation_to_json(const DbQuery &db_query, const TranslationRequest &request) {
+  return request.hub_language_id.empty() ? JSON::phrase_to_json(db_query, request.user_options, request.encoding)
+                                         : JSON::pivot_phrase_to_json(db_query, request.user_options, request.encoding);
+}
+
+std::string Server::no_translation_message(const TranslationRequest &request) {
+  return "No translation found for \"" + request.phrase +
+         (request.word_class.empty() ? "" : " (" + request.word_class + ")") + "\" (" + request.origin_language_id +
+         " => " + request.target_language_id + ")!";
+}
+
+std::string Server::translation_cache_key(const TranslationRequest &request) {
+  if (request.page.limit || request.page.after || request.stream) return "";
+  // the members of a JSON object are written in a fixed order, so equal requests have equal keys
+  return request.origin_language_id + "\t" + request.target_language_id + "\t" +
+         JSON::json_value_to_string(request.user_options) + (Encoding::cbor == request.encoding ? "\tcbor" : "");
+}
+
 int Server::request_handler(mg_connection *connection, enum mg_event event) {
+  Server *server;
   DbQuery *db_query;
+  // the snapshot is kept until the request is answered, even if a reload publishes the next one meanwhile
+  std::shared_ptr<const Snapshot> snapshot;
+  int result;
+  Encoding encoding;
+  const char *url;
+  long retry_after;
   switch (event) {
     case MG_AUTH:
       return MG_TRUE;
+    case MG_POLL:
+      // a streamed translation is continued until its last row is sent
+      if (!connection->connection_param) return MG_FALSE;
+      if (continue_translation_stream(connection, STREAM_BUFFER_SIZE)) return MG_FALSE;
+      server = (Server *)connection->server_param;
+      --server->open_streams_;
+      return MG_TRUE;
+    case MG_CLOSE:
+      server = (Server *)connection->server_param;
+      if (connection->connection_param) --server->open_streams_;
+      delete static_cast<TranslationStream *>(connection->connection_param);
+      connection->connection_param = nullptr;
+      return MG_TRUE;
     case MG_REQUEST:
-      db_query = (DbQuery *)connection->server_param;
-      char *url;
-      if (cstring_ends_with(connection->uri, "/")) {
-        url = new char[strlen(connection->uri) + 1];
-        strncpy(url, connection->uri, strlen(connection->uri));
-      } else {
-        url = new char[strlen(connection->uri) + 2];
-        strncpy(url, connection->uri, strlen(connection->uri) + 1);
-        strncat(url, "/", 1);
-      }
+      result = MG_TRUE;
+      server = (Server *)connection->server_param;
+      db_query = &server->db_query_;
+      if (std::chrono::steady_clock::time_point{} == server->round_start_)
+        server->round_start_ = std::chrono::steady_clock::now();
+      snapshot = server->snapshot();
+      // the cached translations and misses may be outdated after a reload
+      server->evict_outdated(*snapshot);
+      server->request_url_.assign(connection->uri);
+      if (!cstring_ends_with(connection->uri, "/")) server->request_url_ += '/';
+      url = server->request_url_.c_str();
       if (!strcmp(connection->request_method, "GET")) {
-        if (!strcmp(url, url_help_.c_str())) {
+        if (!strcmp(url, url_ready_.c_str())) {
+          // readiness probes usually send no accept header
+          Json::Value readiness{Json::objectValue};
+          readiness["ready"] = !server->warmup_thread_.joinable();
+          readiness["snapshot"] = static_cast<Json::UInt64>(snapshot->version);
+          if (server->warmup_thread_.joinable()) mg_send_status(connection, 503);
+          send_json_data(connection, JSON::json_value_to_string(readiness));
+        } else if (!strcmp(url, url_help_.c_str())) {
           if (!check_accept_header(connection, "text/html")) {
             std::string error_message{"Only the content-type \"text/html\" is supported!"};
             handle_http_error(connection, 406, error_message);
@@ -148,23 +768,27 @@ int Server::request_handler(mg_connection *connection, enum mg_event event) {
               handle_http_error(connection, 500, error_message);
             }
           }
-        } else if (!check_accept_header(connection)) {
-          std::string error_message{"Only the content-type \"application/json\" is supported!"};
+        } else if (!get_encoding_from_accept_header(connection, encoding)) {
+          std::string error_message{
+              "Only the content-types \"application/json\" and \"application/cbor\" are supported!"};
           handle_http_error(connection, 406, error_message);
+        } else if ((retry_after = server->overload_retry_after(false, false))) {
+          ++server->shed_requests_;
+          handle_http_error(connection, 503, "Service overloaded, retry later!", retry_after);
         } else {
           try {
             if (!strcmp(url, url_languages_.c_str())) {
               db_query->request_all_languages();
-              string json{JSON::all_languages_to_json(*db_query)};
-              send_json_data(connection, json);
+              string json{JSON::all_languages_to_json(*db_query, encoding)};
+              send_json_data(connection, json, encoding);
             } else if (cstring_starts_with(url, url_language_id_prefix_.c_str())) {
               db_query->request_language_by_id(get_last_path_from_url(url));
               if (db_query->empty()) {
                 std::string error_message{"Language ID \"" + get_last_path_from_url(url) + "\" not found!"};
                 handle_http_error(connection, 404, error_message);
               } else {
-                string json{JSON::language_name_to_json(*db_query)};
-                send_json_data(connection, json);
+                string json{JSON::language_name_to_json(*db_query, encoding)};
+                send_json_data(connection, json, encoding);
               }
             } else if (cstring_starts_with(url, url_language_name_prefix_.c_str())) {
               db_query->request_language_by_name(get_last_path_from_url(url));
@@ -172,21 +796,21 @@ int Server::request_handler(mg_connection *connection, enum mg_event event) {
                 std::string error_message{"Language name \"" + get_last_path_from_url(url) + "\" not found!"};
                 handle_http_error(connection, 404, error_message);
               } else {
-                string json{JSON::language_id_to_json(*db_query)};
-                send_json_data(connection, json);
+                string json{JSON::language_id_to_json(*db_query, encoding)};
+                send_json_data(connection, json, encoding);
               }
             } else if (!strcmp(url, url_word_classes_.c_str())) {
               db_query->request_all_word_classes();
-              string json{JSON::all_word_classes_to_json(*db_query)};
-              send_json_data(connection, json);
+              string json{JSON::all_word_classes_to_json(*db_query, encoding)};
+              send_json_data(connection, json, encoding);
             } else if (cstring_starts_with(url, url_word_class_id_prefix_.c_str())) {
               db_query->request_word_class_by_id(get_last_path_from_url(url));
               if (db_query->empty()) {
                 std::string error_message{"Word class ID \"" + get_last_path_from_url(url) + "\" not found!"};
                 handle_http_error(connection, 404, error_message);
               } else {
-                string json{JSON::word_class_name_to_json(*db_query)};
-                send_json_data(connection, json);
+                string json{JSON::word_class_name_to_json(*db_query, encoding)};
+                send_json_data(connection, json, encoding);
               }
             } else if (cstring_starts_with(url, url_word_class_name_prefix_.c_str())) {
               db_query->request_word_class_by_name(get_last_path_from_url(url));
@@ -194,21 +818,21 @@ int Server::request_handler(mg_connection *connection, enum mg_event event) {
                 std::string error_message{"Word class name \"" + get_last_path_from_url(url) + "\" not found!"};
                 handle_http_error(connection, 404, error_message);
               } else {
-                string json{JSON::word_class_id_to_json(*db_query)};
-                send_json_data(connection, json);
+                string json{JSON::word_class_id_to_json(*db_query, encoding)};
+                send_json_data(connection, json, encoding);
               }
             } else if (!strcmp(url, url_genders_.c_str())) {
               db_query->request_all_genders();
-              string json{JSON::all_genders_to_json(*db_query)};
-              send_json_data(connection, json);
+              string json{JSON::all_genders_to_json(*db_query, encoding)};
+              send_json_data(connection, json, encoding);
             } else if (cstring_starts_with(url, url_gender_id_prefix_.c_str())) {
               db_query->request_gender_by_id(get_last_path_from_url(url));
               if (db_query->empty()) {
                 std::string error_message{"Gender ID \"" + get_last_path_from_url(url) + "\" not found!"};
                 handle_http_error(connection, 404, error_message);
               } else {
-                string json{JSON::gender_name_to_json(*db_query)};
-                send_json_data(connection, json);
+                string json{JSON::gender_name_to_json(*db_query, encoding)};
+                send_json_data(connection, json, encoding);
               }
             } else if (cstring_starts_with(url, url_gender_name_prefix_.c_str())) {
               db_query->request_gender_by_name(get_last_path_from_url(url));
@@ -216,13 +840,73 @@ int Server::request_handler(mg_connection *connection, enum mg_event event) {
                 std::string error_message{"Gender name \"" + get_last_path_from_url(url) + "\" not found!"};
                 handle_http_error(connection, 404, error_message);
               } else {
-                string json{JSON::gender_id_to_json(*db_query)};
-                send_json_data(connection, json);
+                string json{JSON::gender_id_to_json(*db_query, encoding)};
+                send_json_data(connection, json, encoding);
               }
             } else if (!strcmp(url, url_numeri_.c_str())) {
               db_query->request_all_numeri();
-              string json{JSON::all_numeri_to_json(*db_query)};
-              send_json_data(connection, json);
+              string json{JSON::all_numeri_to_json(*db_query, encoding)};
+              send_json_data(connection, json, encoding);
+            } else if (cstring_starts_with(url, url_complete_prefix_.c_str())) {
+              std::string language_id{get_completion_language_id_from_url(url)};
+              size_t limit{DEFAULT_COMPLETION_LIMIT};
+              bool limit_valid{get_limit_from_query(connection, limit)};
+              auto completion_index = snapshot->completion_indexes.find(language_id);
+              if (!limit_valid) {
+                std::string error_message{"Bad Request: the limit must be a valid number!"};
+                handle_http_error(connection, 400, error_message);
+              } else if (snapshot->completion_indexes.end() == completion_index) {
+                std::string error_message{"No completions available for the language ID \"" + language_id + "\"!"};
+                handle_http_error(connection, 404, error_message);
+              } else {
+                string json{JSON::completions_to_json(
+                    completion_index->second.complete(get_completion_prefix_from_url(url), limit), encoding)};
+                send_json_data(connection, json, encoding);
+              }
+            } else if (!strcmp(url, url_metrics_.c_str())) {
+              Json::Value metrics{Json::objectValue};
+              metrics["snapshot"] = static_cast<Json::UInt64>(snapshot->version);
+              metrics["translation_cache_entries"] = static_cast<Json::UInt64>(server->translation_cache_.size());
+              metrics["negative_cache_entries"] = static_cast<Json::UInt64>(server->negative_cache_.size());
+              metrics["negative_cache_hits"] = static_cast<Json::UInt64>(server->negative_cache_hits_);
+              metrics["filtered_translations"] = static_cast<Json::UInt64>(server->filtered_translations_.load());
+              metrics["unfiltered_misses"] = static_cast<Json::UInt64>(server->unfiltered_misses_.load());
+              metrics["open_streams"] = static_cast<Json::UInt64>(server->open_streams_);
+              metrics["translation_latency"] = server->translation_latency_;
+              metrics["shed_requests"] = static_cast<Json::UInt64>(server->shed_requests_);
+              metrics["phrase_filters"] = Json::Value{Json::objectValue};
+              for (const std::pair<const std::string, utils::BloomFilter> &phrase_filter : snapshot->phrase_filters) {
+                Json::Value &filter_metrics = metrics["phrase_filters"][phrase_filter.first];
+                filter_metrics["phrases"] = static_cast<Json::UInt64>(phrase_filter.second.size());
+                filter_metrics["bytes"] = static_cast<Json::UInt64>(phrase_filter.second.bytes());
+                filter_metrics["hash_functions"] = static_cast<Json::UInt64>(phrase_filter.second.hash_count());
+                filter_metrics["false_positive_rate"] = phrase_filter.second.false_positive_rate();
+              }
+              send_json_data(connection, JSON::encode(metrics, encoding), encoding);
+            } else if (cstring_starts_with(url, url_search_prefix_.c_str())) {
+              std::string language_id{get_search_language_id_from_url(url)};
+              size_t limit{DEFAULT_SEARCH_LIMIT};
+              char query[1024];
+              int query_length{mg_get_var(connection, "q", query, sizeof(query))};
+              if (!get_limit_from_query(connection, limit)) {
+                std::string error_message{"Bad Request: the limit must be a valid number!"};
+                handle_http_error(connection, 400, error_message);
+              } else if (0 >= query_length) {
+                std::string error_message{"Bad Request: the query \"q\" must be a non empty string of at most " +
+                                          std::to_string(sizeof(query) - 1) + " bytes!"};
+                handle_http_error(connection, 400, error_message);
+              } else {
+                // The ids are intersected by the inverted index, only the phrases of the requested language are kept.
+                std::vector<std::string> phrases;
+                for (uint32_t id : snapshot->annotation_index.lookup(query)) {
+                  if (phrases.size() == limit) break;
+                  const std::pair<std::string, std::string> &phrase = snapshot->annotated_phrases.at(id);
+                  if (phrase.first == language_id &&
+                      phrases.end() == std::find(phrases.begin(), phrases.end(), phrase.second))
+                    phrases.push_back(phrase.second);
+                }
+                send_json_data(connection, JSON::search_results_to_json(phrases, encoding), encoding);
+              }
             } else {
               // 400 => Bad Request (Bad URL)
               std::string error_message{"Bad Request: called GET on \"" + std::string{url} + "\"!"};
@@ -235,8 +919,9 @@ int Server::request_handler(mg_connection *connection, enum mg_event event) {
           }
         }
       } else if (!strcmp(connection->request_method, "POST")) {
-        if (!check_accept_header(connection)) {
-          std::string error_message{"Only the content-type \"application/json\" is supported!"};
+        if (!get_encoding_from_accept_header(connection, encoding)) {
+          std::string error_message{
+              "Only the content-types \"application/json\" and \"application/cbor\" are supported!"};
           handle_http_error(connection, 406, error_message);
         } else if (mg_get_header(connection, "content-type") != nullptr &&
                    strcmp(mg_get_header(connection, "content-type"), "application/json")) {
@@ -245,52 +930,89 @@ int Server::request_handler(mg_connection *connection, enum mg_event event) {
         } else {
           try {
             if (cstring_starts_with(connection->uri, url_translation_prefix_.c_str())) {
-              char *post_content = new char[connection->content_len + 1];
-              strncpy(post_content, connection->content, connection->content_len);
-              post_content[connection->content_len] = '\0';
-              Json::CharReaderBuilder json_reader_factory;
-              Json::CharReader *json_reader(json_reader_factory.newCharReader());
+              // the POST data is parsed in place, it is not null-terminated
               Json::Value user_options;
               std::string errors;
-              if (!json_reader->parse(post_content, post_content + strlen(post_content), &user_options, &errors)) {
+              if (!server->json_reader_->parse(connection->content, connection->content + connection->content_len,
+                                               &user_options, &errors)) {
                 // 400 => Bad Request (Bad URL)
                 std::string error_message{"Bad Request: Malformed POST content:\n" + errors};
                 handle_http_error(connection, 400, error_message);
               } else {
-                std::string origin_phrase{""};
-                if (user_options.isObject()) {
-                  Json::Value extracted_phrase{user_options.get("phrase", "")};
-                  if (!extracted_phrase.isString()) {
-                    handle_http_error(connection, 400,
-                                      "Expected a JSON object with at least the string member \"phrase\"!");
-                    delete[] url;
-                    return MG_TRUE;
-                  }
-                  origin_phrase = extracted_phrase.asString();
-                }
-                if (origin_phrase.empty()) {
-                  handle_http_error(connection, 400, "Phrase for translation must not be empty!");
-                  delete[] url;
-                  return MG_TRUE;
-                }
-                std::string word_class{""};
-                Json::Value extracted_word_class{user_options.get("word_class", "")};
-                if (extracted_word_class.isString()) word_class = extracted_word_class.asString();
-                std::string origin_language_id{get_origin_language_id_from_url(url)};
-                std::string target_language_id{get_target_language_id_from_url(url)};
-                if (word_class.empty()) {
-                  db_query->request_phrase(origin_phrase, origin_language_id, target_language_id);
-                } else {
-                  db_query->request_phrase(origin_phrase, origin_language_id, target_language_id, word_class);
-                }
-                if (db_query->empty()) {
-                  std::string error_message{"No translation found for \"" + origin_phrase +
-                                            (word_class.empty() ? "" : " (" + word_class + ")") + "\" (" +
-                                            origin_language_id + " => " + target_language_id + ")!"};
-                  handle_http_error(connection, 404, error_message);
+                TranslationRequest request;
+                std::string request_error{server->parse_translation_request(get_origin_language_id_from_url(url),
+                                                                            get_target_language_id_from_url(url),
+                                                                            user_options, encoding, request)};
+                std::string cache_key{translation_cache_key(request)};
+                const CachedTranslation *cached_translation{
+                    request_error.empty() && !cache_key.empty() ? server->translation_cache_.get(cache_key) : nullptr};
+                const std::chrono::steady_clock::time_point *cached_miss{
+                    request_error.empty() && !cache_key.empty() && !cached_translation
+                        ? server->negative_cache_.get(cache_key)
+                        : nullptr};
+                if (cached_miss && *cached_miss < std::chrono::steady_clock::now()) cached_miss = nullptr;
+                if (!request_error.empty()) {
+                  handle_http_error(connection, 400, request_error);
+                } else if (cached_miss) {
+                  ++server->negative_cache_hits_;
+                  handle_http_error(connection, 404, no_translation_message(request));
+                } else if (cached_translation) {
+                  mg_send_header(connection, "x-trlt-phrase",
+                                 utils::percent_encode(cached_translation->resolved_phrase).c_str());
+                  send_json_data(connection, cached_translation->json, encoding);
+                } else if ((retry_after = server->overload_retry_after(true, request.stream))) {
+                  ++server->shed_requests_;
+                  handle_http_error(connection, 503, "Service overloaded, retry later!", retry_after);
                 } else {
-                  string json{JSON::phrase_to_json(*db_query, user_options)};
-                  send_json_data(connection, json);
+                  ++server->round_translations_;
+                  std::unique_ptr<TranslationStream> translation_stream;
+                  if (request.stream) {
+                    translation_stream.reset(new TranslationStream{server->connection_string_,
+                                                                   db_query->uses_translation_lookup(),
+                                                                   STREAM_BATCH_SIZE, user_options, encoding});
+                    db_query = &translation_stream->db_query;
+                  }
+                  const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+                  std::string resolved_phrase{server->request_translation(*db_query, *snapshot, request)};
+                  double latency{static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start).count())};
+                  if (server->translation_latency_)
+                    latency = LATENCY_WEIGHT * latency + (1 - LATENCY_WEIGHT) * server->translation_latency_;
+                  server->translation_latency_ = latency;
+                  if (db_query->empty() && !request.page.after) {
+                    if (!cache_key.empty()) {
+                      server->negative_cache_.put(cache_key, std::chrono::steady_clock::now() + NEGATIVE_CACHE_TTL);
+                    }
+                    handle_http_error(connection, 404, no_translation_message(request));
+                  } else if (translation_stream) {
+                    // the first rows are sent right away, all further ones are sent by MG_POLL
+                    mg_send_header(connection, "x-trlt-phrase", utils::percent_encode(resolved_phrase).c_str());
+                    mg_send_header(connection, "content-type", JSON::media_type(encoding).c_str());
+                    string json{translation_stream->json_stream.append(*db_query)};
+                    if (!json.empty()) mg_send_data(connection, json.data(), static_cast<int>(json.size()));
+                    connection->connection_param = translation_stream.release();
+                    ++server->open_streams_;
+                    result = MG_MORE;
+                  } else {
+                    string json{translation_to_json(*db_query, request)};
+                    // the phrase that was actually translated, it differs from the requested one for fuzzy matches.
+                    // It is percent-encoded, since it may be the phrase of the client including line breaks.
+                    mg_send_header(connection, "x-trlt-phrase", utils::percent_encode(resolved_phrase).c_str());
+                    // a full page is continued by passing the id of its last target phrase as "cursor"
+                    size_t target_phrases{0};
+                    std::string last_id, current_id;
+                    for (const pqxx::tuple &row : *db_query) {
+                      if (!request.page.limit) break;
+                      row["phrase_id_out"].to(current_id);
+                      if (current_id != last_id) ++target_phrases;
+                      last_id.swap(current_id);
+                    }
+                    if (request.page.limit && target_phrases == request.page.limit)
+                      mg_send_header(connection, "x-trlt-cursor", last_id.c_str());
+                    send_json_data(connection, json, encoding);
+                    if (!cache_key.empty())
+                      server->translation_cache_.put(cache_key, CachedTranslation{json, resolved_phrase});
+                  }
                 }
               }
             } else {
@@ -310,8 +1032,7 @@ int Server::request_handler(mg_connection *connection, enum mg_event event) {
                                   std::string{url} + "\"!"};
         handle_http_error(connection, 400, error_message);
       }
-      delete[] url;
-      return MG_TRUE;
+      return result;
     default:
       return MG_FALSE;
   }
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/14/2015
+// Last modified: 10/19/2026
 // Description: Declares the RESTful server for the translation service.
 // ====================================================================================================================
 
@@ -34,9 +34,23 @@
 //
 //  GET /numeri => ["numerus-id", "numerus-id"]
 //
+//  GET /complete/<language id>/<prefix>/?limit=<n> => ["<phrase>", "<phrase>"]
+//
+//  GET /search/<language id>/?q=<terms>&limit=<n> => ["<phrase>", "<phrase>"]
+//
+//  GET /ready => {"ready": <bool>, "snapshot": <version>} (503 while the translation cache is warmed up)
+//
+//  GET /metrics => {"snapshot": <version>, "translation_cache_entries": <n>, "negative_cache_entries": <n>,
+//                   "negative_cache_hits": <n>, "filtered_translations": <n>, "unfiltered_misses": <n>,
+//                   "open_streams": <n>, "translation_latency": <milliseconds>, "shed_requests": <n>,
+//                   "phrase_filters": {"<language id>": {"phrases": <n>, "bytes": <n>, "hash_functions": <n>,
+//                   "false_positive_rate": <rate>}}}
+//
 //  POST /translation/<language id source>/<language id target>/:
 //    {"phrase": "<phrase origin>", "word_class": "<word class id>", "show_phrase": <bool>, "show_word_class": <bool>,
-//    "show_gender": <bool>, "show_numerus": <bool>, "show_abbreviation": bool, "show_comment": <bool>}
+//    "show_gender": <bool>, "show_numerus": <bool>, "show_abbreviation": bool, "show_comment": <bool>,
+//    "fuzzy": <0|1|2>, "pivot": <bool|"<language id hub>">, "limit": <n>, "cursor": "<x-trlt-cursor>",
+//    "stream": <bool>}
 //    => [{"origin_phrase": "<phrase origin language>", "origin_word_class": "<word class origin language>",
 //         "origin_gender": "<gender origin language>", "origin_numerus": "<numerus>": "<numerus origin language>",
 //         "origin_comment": "<comment origin language>", "origin_abbreviation": "<abbreviation origin language>",
@@ -44,6 +58,20 @@
 //           ["target_phrase": "<phrase target language>", "target_word_class": "<word class target language>",
 //            "target_gender": "<gender target language>", "target_numerus": "<numerus>": "<numerus target language>",
 //            "target_comment": "<comment target language>", "target_abbreviation": "<abbreviation target language>"]}]
+//    => in pivot mode each translation additionally contains "provenance": "<direct|pivot>" and
+//       "pivot_phrases": ["<phrase hub language>"]
+//    => a page with "limit" target phrases sets the header "x-trlt-cursor" to continue with the next page, in stream
+//       mode the result is sent in chunks while it is read from the data base
+//
+//  All results are encoded as CBOR (RFC 7049) instead of JSON if the accept header names "application/cbor" with a
+//  quality value that is above 0 and not below the one of JSON, a streamed result is an array of indefinite length
+//  then. Error messages are always JSON.
+//
+//  An overloaded server answers translations and then all other requests except /ready and /help with 503 and the
+//  header "retry-after", see Server::overload_retry_after.
+//
+//  Cached responses are evicted when trlt-import notifies the changed languages or populate_db.sh notifies all
+//  languages on the channel trlt_data_changed, see Server::DATA_CHANGED_CHANNEL.
 // ====================================================================================================================
 
 #ifndef SERVER_HPP_
@@ -51,11 +79,31 @@
 
 #include "connection_string.hpp"
 #include "db_query.hpp"
+#include "json.hpp"
+
+#include "utils/bloom_filter.hpp"
+#include "utils/completion_index.hpp"
+#include "utils/fuzzy_index.hpp"
+#include "utils/inverted_index.hpp"
+#include "utils/lru_cache.hpp"
+
+#include "json/json.h"
 
 #include "mongoose.h"
 
+#include <atomic>
+#include <chrono>
+#include <csignal>
 #include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace lgeorgieff {
 namespace translate {
@@ -63,17 +111,53 @@ namespace server {
 // Defines the RESTful server API for the translation service.
 class Server {
  public:
+  // The hub language of pivot translations if no other one is configured
+  static const std::string DEFAULT_HUB_LANGUAGE;
+  // The false positive rate of the phrase filters if no other one is configured
+  static const double DEFAULT_FILTER_FALSE_POSITIVE_RATE;
+  // The notification channel the server listens on for changes of the data base, see
+  // ImportStaging::notify_changes. The payload contains the ids of the changed languages separated by spaces, an
+  // empty payload denotes a change of all languages, e.g. "NOTIFY trlt_data_changed;" after populate_db.sh.
+  // The cached responses of the changed languages are evicted and the indexes are rebuilt like by reload().
+  static const std::string DATA_CHANGED_CHANNEL;
+
   // Instantiates an instance of this class with a connection string to the translation data base, an address and a
-  // port the running server will be bound to
-  explicit Server(const ConnectionString &, const std::string & = "0.0.0.0", size_t = 8885);
-  // Starts the server.
+  // port the running server will be bound to. If the fourth argument is true, translations are requested from the
+  // denormalized table translation_lookup. The fifth argument is the default hub language of pivot translations. The
+  // completion and fuzzy indexes of all languages and the index of all comments and abbreviations are built as the
+  // first snapshot before this constructor returns.
+  // If a warm-up file is passed as sixth argument, the most requested translations are recorded in it periodically
+  // and when the server stops. The translations recorded by a previous run are requested in the background right
+  // after the start, the server is ready (see GET /ready) when they are cached.
+  // The seventh argument is the false positive rate of the phrase filters, which answer requests for unknown phrases
+  // without the data base. A lower rate needs more memory, about 4.8 bits per phrase for each halving.
+  // If the path of a Unix domain socket is passed as last argument, the server is bound to it as well, so local
+  // clients do not need the TCP stack. An existing file of this path is replaced.
+  explicit Server(const ConnectionString &, const std::string & = "0.0.0.0", size_t = 8885, bool = false,
+                  const std::string & = DEFAULT_HUB_LANGUAGE, const std::string & = "",
+                  double = DEFAULT_FILTER_FALSE_POSITIVE_RATE, const std::string & = "");
+  // Starts the server, it runs until request_stop() is called.
   void listen();
+  // Requests listen() to return. Since it only sets a flag, it may be called by a signal handler.
+  static void request_stop() noexcept;
+  // Rebuilds all indexes from the data base in a background thread and publishes them as the next snapshot, while the
+  // current one keeps answering requests. All cached responses are evicted when the snapshot is published. Does
+  // nothing if a reload is still running.
+  void reload();
+  // Requests a reload by the running listen(), e.g. after populate_db.sh. Since it only sets a flag, it may be called
+  // by a signal handler.
+  static void request_reload() noexcept;
+  // Returns the version of the current snapshot, the initial snapshot has the version 1.
+  size_t snapshot_version() const;
 
   ~Server();
 
   // Some methods that extract information from the passed URL
   static std::string get_origin_language_id_from_url(const char *);
   static std::string get_target_language_id_from_url(const char *);
+  static std::string get_completion_language_id_from_url(const char *);
+  static std::string get_completion_prefix_from_url(const char *);
+  static std::string get_search_language_id_from_url(const char *);
 
  private:
   // Some values that are used to describe the different URL of the RESTful API
@@ -97,13 +181,246 @@ class Server {
 
   static std::string url_translation_prefix_;
 
+  static std::string url_complete_prefix_;
+
+  static std::string url_search_prefix_;
+
+  static std::string url_ready_;
+
+  static std::string url_metrics_;
+
+  // The number of completions that is returned if a request does not specify a limit
+  static const size_t DEFAULT_COMPLETION_LIMIT;
+
+  // The number of phrases a search returns if a request does not specify a limit
+  static const size_t DEFAULT_SEARCH_LIMIT;
+
+  // The number of fuzzy matches that are tried to resolve a phrase without translation
+  static const size_t FUZZY_CANDIDATES;
+
+  // The number of rows a streamed translation fetches at once from its server-side cursor
+  static const size_t STREAM_BATCH_SIZE;
+
+  // The number of bytes of a streamed translation that may wait to be sent before no further rows are fetched
+  static const size_t STREAM_BUFFER_SIZE;
+
+  // The time a poll round may spend on requests before further translations are rejected, the expected latency of
+  // the rejected translation included
+  static const std::chrono::milliseconds MAX_TRANSLATION_DELAY;
+
+  // The time a poll round may spend on requests before further requests for languages, word classes, genders,
+  // numeri, completions, searches and metrics are rejected
+  static const std::chrono::milliseconds MAX_REFERENCE_DELAY;
+
+  // The number of streamed translations that may be open at once, each one holds a data base connection
+  static const size_t MAX_STREAMS;
+
+  // The weight of the latest data base latency in translation_latency_
+  static const double LATENCY_WEIGHT;
+
+  // The number of translation responses that are cached
+  static const size_t TRANSLATION_CACHE_SIZE;
+
+  // The number of most requested translations that are recorded in the warm-up file
+  static const size_t WARMUP_KEYS;
+
+  // The number of data base connections that request the recorded translations concurrently after the start
+  static const size_t WARMUP_CONNECTIONS;
+
+  // The interval in which the most requested translations are recorded in the warm-up file
+  static const std::chrono::seconds WARMUP_SAVE_INTERVAL;
+
+  // The time to wait before the connection of the listener on DATA_CHANGED_CHANNEL is opened again after it failed
+  static const std::chrono::seconds CHANGE_LISTENER_RETRY;
+
+  // The number of translation requests without result that are cached
+  static const size_t NEGATIVE_CACHE_SIZE;
+
+  // The time a translation request without result is answered from the cache
+  static const std::chrono::seconds NEGATIVE_CACHE_TTL;
+
+  // The languages whose data changed in the data base
+  struct DataChange {
+    // true if the data of all languages may have changed
+    bool all;
+    std::set<std::string> languages;
+
+    // Adds the passed change to this one.
+    void add(const DataChange &);
+    // Returns true if no data changed.
+    bool empty() const noexcept;
+    // Returns true if the data of the passed language changed.
+    bool contains(const std::string &) const;
+  };
+
+  // All data that is derived from the data base once and shared by all requests. A snapshot is never modified after
+  // it was published, so requests use it without locking.
+  struct Snapshot {
+    size_t version;
+    // The prefix completion index of each language
+    std::map<std::string, utils::CompletionIndex> completion_indexes;
+    // The fuzzy phrase index of each language
+    std::map<std::string, utils::FuzzyIndex> fuzzy_indexes;
+    // The Bloom filter over the search keys of all translated phrases of each language
+    std::map<std::string, utils::BloomFilter> phrase_filters;
+    // The inverted index from the terms of all comments and abbreviations to phrase ids
+    utils::InvertedIndex annotation_index;
+    // The language and the phrase of each phrase id in annotation_index
+    std::unordered_map<uint32_t, std::pair<std::string, std::string>> annotated_phrases;
+    // The data that changed since the previous snapshot, the cached responses of these languages are outdated
+    DataChange changes;
+  };
+
+  // Builds a snapshot with the passed version and false positive rate of the phrase filters from the passed data base
+  // connection
+  static std::shared_ptr<Snapshot> build_snapshot(DbQuery &, size_t, double);
+  // Builds the completion and the fuzzy index and the phrase filter with the passed false positive rate of every
+  // language from all translated phrases and their number of translations
+  static void build_phrase_indexes(DbQuery &, double, Snapshot &);
+  // Builds the inverted index over the comments and abbreviations of all phrases
+  static void build_annotation_index(DbQuery &, Snapshot &);
+  // Returns the current snapshot, the caller keeps it alive even if a reload publishes the next one meanwhile
+  std::shared_ptr<const Snapshot> snapshot() const;
+  // Builds the next snapshot like reload() and records the passed changes in it.
+  void reload(const DataChange &);
+  // Evicts the cached responses that are outdated by the passed snapshot, unless this was done before.
+  void evict_outdated(const Snapshot &);
+  // Evicts the cached responses and cached misses of all requests from or into a changed language. A pivot
+  // translation depends on the translations between both of its languages and the hub language, so it is evicted as
+  // well if one of them changed.
+  void evict(const DataChange &);
+  // Receives the notifications on DATA_CHANGED_CHANNEL over a connection of its own and adds them to data_changes_,
+  // until the server is destroyed or stopped. If the connection fails, it is opened again after
+  // CHANGE_LISTENER_RETRY and all data is considered changed, since notifications may have been missed.
+  void listen_for_changes();
+
+  // A translation request whose POST data was checked by parse_translation_request
+  struct TranslationRequest {
+    std::string origin_language_id;
+    std::string target_language_id;
+    std::string phrase;
+    // empty for any word class
+    std::string word_class;
+    // empty for a direct translation
+    std::string hub_language_id;
+    size_t fuzzy;
+    PhrasePage page;
+    bool stream;
+    Json::Value user_options;
+    Encoding encoding;
+  };
+
+  // A translation response that is kept in translation_cache_
+  struct CachedTranslation {
+    // the response in the encoding of the request
+    std::string json;
+    // the phrase that was actually translated, see the header x-trlt-phrase, which contains it percent-encoded
+    std::string resolved_phrase;
+  };
+
+  // Reads the passed POST data of a translation request from the first into the second passed language, whose
+  // response is written in the passed encoding. Returns an error message if the data is not valid, otherwise an empty
+  // string.
+  std::string parse_translation_request(const std::string &, const std::string &, const Json::Value &, Encoding,
+                                        TranslationRequest &) const;
+  // Requests the translations of the passed request from the passed data base connection. In fuzzy mode, a phrase
+  // without translation is resolved by the fuzzy index of the passed snapshot. Phrases that are not contained in the
+  // phrase filter of the snapshot are not requested at all. Returns the phrase that was actually translated, the
+  // result of the DbQuery is empty if no translation was found.
+  std::string request_translation(DbQuery &, const Snapshot &, const TranslationRequest &);
+  // Returns the response of the passed request in its encoding from the result of request_translation.
+  static std::string translation_to_json(const DbQuery &, const TranslationRequest &);
+  // Returns the error message of the passed request if it has no translation.
+  static std::string no_translation_message(const TranslationRequest &);
+  // Returns the key of the passed request in translation_cache_ or an empty string if it is not cached, e.g. a page.
+  // The key contains the languages and the POST data on a single line, followed by "cbor" for a CBOR response.
+  static std::string translation_cache_key(const TranslationRequest &);
+  // Returns 0 if a translation, optionally streamed, or another request is admitted, otherwise the number of seconds
+  // after which the client should retry. Mongoose handles all requests that are waiting in a single poll round one
+  // after another, so the time the round already took is the time the current request waited. Translations are
+  // rejected if this time and their expected latency exceed MAX_TRANSLATION_DELAY, but the first one of each round is
+  // admitted, so translation_latency_ keeps adapting. Other requests are cheaper and are only rejected after
+  // MAX_REFERENCE_DELAY.
+  long overload_retry_after(bool, bool) const;
+  // Requests the translations of the passed cache keys over WARMUP_CONNECTIONS data base connections and stores the
+  // responses in warmup_translations_.
+  void warm_up(const std::vector<std::string> &);
+  // Writes the WARMUP_KEYS most requested cache keys to the warm-up file.
+  void save_warmup_keys();
+
+  // Set by request_reload() and reset by listen()
+  static volatile std::sig_atomic_t reload_requested_;
+  // Set by request_stop()
+  static volatile std::sig_atomic_t stop_requested_;
+
   // The handler that is invoked by the server when a new request is received
   static int request_handler(mg_connection *, enum mg_event);
 
   // The connection address of the running server, i.e. address and port
   std::string connection_address_;
+  // The path of the Unix domain socket the server is bound to, empty if it is only bound to connection_address_
+  std::string unix_socket_;
+  // The connection string of the data base, each streamed translation and each reload opens its own connection
+  ConnectionString connection_string_;
   // The query object that connects this server instance to the data base
   DbQuery db_query_;
+  // The hub language of pivot translations that do not specify one
+  std::string hub_language_;
+  // The current snapshot, it is only accessed by std::atomic_load and std::atomic_store, since a reload replaces it
+  // from a background thread. The previous snapshot is released by the last request that still uses it.
+  std::shared_ptr<const Snapshot> snapshot_;
+  // The background thread of the last reload
+  std::thread reload_thread_;
+  // True while reload_thread_ builds the next snapshot
+  std::atomic<bool> reloading_;
+  // The changes that are waiting for the next reload, since a reload was still running when they were received
+  DataChange pending_reload_;
+  // The thread that runs listen_for_changes()
+  std::thread change_listener_thread_;
+  // Reset by the destructor to stop change_listener_thread_
+  std::atomic<bool> listening_for_changes_;
+  // The changes received by change_listener_thread_ that were not applied by listen() so far
+  DataChange data_changes_;
+  // Synchronizes data_changes_
+  std::mutex data_changes_mutex_;
+  // The responses of the most recent translation requests, it is only accessed by the request handler
+  utils::LruCache<std::string, CachedTranslation> translation_cache_;
+  // The snapshot version the cached translations were requested with
+  size_t translation_cache_version_;
+  // The expiry of each recent translation request without result, keyed like translation_cache_
+  utils::LruCache<std::string, std::chrono::steady_clock::time_point> negative_cache_;
+  // The number of requests that were answered from negative_cache_
+  size_t negative_cache_hits_;
+  // The file the most requested cache keys are recorded in, empty if they are not recorded
+  std::string warmup_file_;
+  // The background thread that warms up the translation cache, it is joined by listen() when it is done
+  std::thread warmup_thread_;
+  // True while warmup_thread_ requests the recorded translations
+  std::atomic<bool> warming_up_;
+  // The responses requested by warmup_thread_, they are moved into translation_cache_ by listen()
+  std::vector<std::pair<std::string, CachedTranslation>> warmup_translations_;
+  // The false positive rate of the phrase filters of each snapshot
+  double filter_false_positive_rate_;
+  // The number of phrases that were not requested, since the phrase filter excluded them
+  std::atomic<size_t> filtered_translations_;
+  // The number of phrases that passed the phrase filter but have no translation, including false positives
+  std::atomic<size_t> unfiltered_misses_;
+  // The time the first request of the current poll round was handled, the epoch before
+  std::chrono::steady_clock::time_point round_start_;
+  // The number of translations that were admitted in the current poll round
+  size_t round_translations_;
+  // The average time in milliseconds a translation that was not cached took in the data base, weighted by
+  // LATENCY_WEIGHT
+  double translation_latency_;
+  // The number of open streamed translations
+  size_t open_streams_;
+  // The number of requests that were rejected with 503, since the server was overloaded
+  size_t shed_requests_;
+  // The normalized URL of the request that is handled, i.e. with a trailing slash. Mongoose handles all requests on
+  // the thread of listen(), so a single buffer is reused and keeps its capacity.
+  std::string request_url_;
+  // The reader of the POST data of all requests, it is only accessed by the request handler
+  std::unique_ptr<Json::CharReader> json_reader_;
   // The mongoose server instance
   mg_server *server_;
 };  // Server
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 05/14/2015
+// Last modified: 10/19/2026
 // Description: Implements command line parsing and starting process of the RESTful server API for the translation
 //              service.
 // ====================================================================================================================
@@ -24,6 +24,7 @@
 #include "server.hpp"
 
 #include <pqxx/pqxx>
+#include <csignal>
 #include <iostream>
 #include <string>
 #include <cstring>
@@ -38,6 +39,13 @@ using lgeorgieff::translate::utils::string_to_size_t;
 ConnectionString connection_string;
 size_t service_port{8885};
 std::string service_address{"127.0.0.1"};
+bool translation_lookup{false};
+// Empty for Server::DEFAULT_HUB_LANGUAGE, which cannot be used to initialize a global of another translation unit.
+std::string hub_language;
+std::string warmup_file;
+// Not initialized by Server::DEFAULT_FILTER_FALSE_POSITIVE_RATE for the same reason as hub_language, 0 for the default.
+double filter_false_positive_rate{0};
+std::string unix_socket;
 
 // Returns the usage instractions for this programme.
 std::string get_usage(const string &programme_name) {
@@ -56,9 +64,27 @@ std::string get_usage(const string &programme_name) {
          "-p | --db-port <port>              Sets the port of the data base server\n"
          "-P | --service-port <port>         Sets the port of this RESTful service\n"
          "-L | --service-address <address>   Sets the host address (IP) of this\n"
-         "                                   RESTful service\n";
+         "                                   RESTful service\n"
+         "-T | --translation-lookup          Answers translation requests from the\n"
+         "                                   precomputed table translation_lookup\n"
+         "-H | --hub-language <language id>  Sets the default hub language of pivot\n"
+         "                                   translations (default: " + Server::DEFAULT_HUB_LANGUAGE + ")\n"
+         "-W | --warmup-file <file>          Records the most requested translations\n"
+         "                                   in this file and requests them right\n"
+         "                                   after the next start\n"
+         "-F | --filter-fp-rate <rate>       Sets the false positive rate of the\n"
+         "                                   phrase filters, between 0 and 1\n"
+         "                                   (default: 0.01)\n"
+         "-U | --unix-socket <path>          Binds this RESTful service to a Unix\n"
+         "                                   domain socket as well\n";
 }
 
+// Reloads all indexes of the running server when SIGHUP is received, e.g. by "kill -HUP" after populate_db.sh.
+void handle_sighup(int) { Server::request_reload(); }
+
+// Stops the running server when SIGTERM or SIGINT is received, so the warm-up file is written before it exits.
+void handle_sigterm(int) { Server::request_stop(); }
+
 // Processes all command line arguments and sets the corresponding coniguration values.
 bool process_cmd_arguments(const int argc, const char **argv) {
   bool db_host_set{false};
@@ -105,6 +131,22 @@ bool process_cmd_arguments(const int argc, const char **argv) {
       }
     } else if ((!strcmp("-L", argv[pos]) || !strcmp("--service-address", argv[pos])) && pos != argc - 1) {
       service_address = argv[++pos];
+    } else if (!strcmp("-T", argv[pos]) || !strcmp("--translation-lookup", argv[pos])) {
+      translation_lookup = true;
+    } else if ((!strcmp("-H", argv[pos]) || !strcmp("--hub-language", argv[pos])) && pos != argc - 1) {
+      hub_language = argv[++pos];
+    } else if ((!strcmp("-W", argv[pos]) || !strcmp("--warmup-file", argv[pos])) && pos != argc - 1) {
+      warmup_file = argv[++pos];
+    } else if ((!strcmp("-F", argv[pos]) || !strcmp("--filter-fp-rate", argv[pos])) && pos != argc - 1) {
+      try {
+        filter_false_positive_rate = std::stod(argv[++pos]);
+      } catch (const std::logic_error &) {
+        filter_false_positive_rate = 0;
+      }
+      if (!(filter_false_positive_rate > 0 && filter_false_positive_rate < 1))
+        throw CommandLineException(std::string("The value \"") + argv[pos] + "\" is not a valid false positive rate!");
+    } else if ((!strcmp("-U", argv[pos]) || !strcmp("--unix-socket", argv[pos])) && pos != argc - 1) {
+      unix_socket = argv[++pos];
     } else {
       throw CommandLineException(std::string("The option \"") + argv[pos] + "\" is not supported!");
     }
@@ -125,7 +167,13 @@ int main(const int argc, const char **argv) {
     return 1;
   }
 
-  Server server{connection_string, service_address, service_port};
+  if (hub_language.empty()) hub_language = Server::DEFAULT_HUB_LANGUAGE;
+  if (!filter_false_positive_rate) filter_false_positive_rate = Server::DEFAULT_FILTER_FALSE_POSITIVE_RATE;
+  Server server{connection_string, service_address, service_port, translation_lookup, hub_language, warmup_file,
+                filter_false_positive_rate, unix_socket};
+  std::signal(SIGHUP, handle_sighup);
+  std::signal(SIGTERM, handle_sigterm);
+  std::signal(SIGINT, handle_sigterm);
   server.listen();
   return 0;
 }
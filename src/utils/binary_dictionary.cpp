@@ -0,0 +1,501 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements the compiler and the reader of the binary dictionary format, i.e. a compact and indexed
+//              representation of a language resource that can be queried without a data base.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "binary_dictionary.hpp"
+#include "exception.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+using lgeorgieff::translate::utils::Exception;
+using lgeorgieff::translate::utils::Gender;
+using lgeorgieff::translate::utils::Numerus;
+using lgeorgieff::translate::utils::WordClass;
+
+const char MAGIC[]{"TRLTDICT"};
+const size_t MAGIC_SIZE{8};
+const uint32_t VERSION{1};
+// The number of sections: comment pool, abbreviation pool, record table, phrase table and entry table.
+const size_t SECTION_COUNT{5};
+const size_t HEADER_SIZE{MAGIC_SIZE + 4 + 2 + 2 + SECTION_COUNT * 8};
+
+// All word classes, the position in this list is the packed value of a word class.
+const WordClass WORD_CLASSES[]{WordClass::none,   WordClass::adj,    WordClass::adv,    WordClass::pastp,
+                               WordClass::verb,   WordClass::presp,  WordClass::prep,   WordClass::conj,
+                               WordClass::pron,   WordClass::prefix, WordClass::suffix, WordClass::noun,
+                               WordClass::art,    WordClass::num,    WordClass::interj, WordClass::phrase,
+                               WordClass::idiom};
+const size_t WORD_CLASS_COUNT{sizeof(WORD_CLASSES) / sizeof(WORD_CLASSES[0])};
+
+void write_uint32(std::string &dest, uint32_t value) {
+  for (size_t pos{0}; pos != 4; ++pos) dest.push_back(static_cast<char>((value >> (8 * pos)) & 0xff));
+}
+
+void write_uint64(std::string &dest, uint64_t value) {
+  for (size_t pos{0}; pos != 8; ++pos) dest.push_back(static_cast<char>((value >> (8 * pos)) & 0xff));
+}
+
+void write_varint(std::string &dest, uint64_t value) {
+  while (value >= 0x80) {
+    dest.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  dest.push_back(static_cast<char>(value));
+}
+
+void write_ids(std::string &dest, const std::set<uint32_t> &ids) {
+  write_varint(dest, ids.size());
+  for (const uint32_t &id : ids) write_varint(dest, id);
+}
+
+unsigned char pack_gender_numerus(Gender gender, Numerus numerus) {
+  return static_cast<unsigned char>(static_cast<unsigned char>(gender) | (static_cast<unsigned char>(numerus) << 4));
+}
+
+unsigned char pack_word_class(WordClass word_class) {
+  return static_cast<unsigned char>(std::find(WORD_CLASSES, WORD_CLASSES + WORD_CLASS_COUNT, word_class) -
+                                    WORD_CLASSES);
+}
+
+// Appends a table of the passed items, i.e. the number of items, the offsets and the item data, to dest.
+void write_table(std::string &dest, const std::vector<std::string> &items) {
+  write_uint32(dest, items.size());
+  uint32_t offset{0};
+  for (const std::string &item : items) {
+    write_uint32(dest, offset);
+    offset += item.size();
+  }
+  write_uint32(dest, offset);
+  for (const std::string &item : items) dest += item;
+}
+
+// Returns all strings of the passed pool ordered by their ids.
+std::vector<std::string> pool_to_vector(const std::map<std::string, uint32_t> &pool) {
+  std::vector<std::string> result(pool.size());
+  for (const std::pair<const std::string, uint32_t> &item : pool) result[item.second] = item.first;
+  return result;
+}
+
+// A cursor on a section of a mapped binary dictionary, all read operations are bounds checked.
+class Reader {
+ public:
+  Reader(const unsigned char *begin, const unsigned char *end) : pos_{begin}, end_{end} {}
+
+  uint32_t read_uint32() {
+    this->check(4);
+    uint32_t result{0};
+    for (size_t pos{0}; pos != 4; ++pos) result |= static_cast<uint32_t>(this->pos_[pos]) << (8 * pos);
+    this->pos_ += 4;
+    return result;
+  }
+
+  uint64_t read_uint64() {
+    this->check(8);
+    uint64_t result{0};
+    for (size_t pos{0}; pos != 8; ++pos) result |= static_cast<uint64_t>(this->pos_[pos]) << (8 * pos);
+    this->pos_ += 8;
+    return result;
+  }
+
+  uint64_t read_varint() {
+    uint64_t result{0};
+    for (size_t shift{0}; shift < 64; shift += 7) {
+      this->check(1);
+      unsigned char byte{*this->pos_++};
+      result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) return result;
+    }
+    throw Exception{"The binary dictionary contains a bad varint!"};
+  }
+
+  unsigned char read_byte() {
+    this->check(1);
+    return *this->pos_++;
+  }
+
+  std::string read_string(size_t length) {
+    this->check(length);
+    std::string result{reinterpret_cast<const char *>(this->pos_), length};
+    this->pos_ += length;
+    return result;
+  }
+
+ private:
+  void check(size_t length) const {
+    if (this->pos_ > this->end_ || static_cast<size_t>(this->end_ - this->pos_) < length)
+      throw Exception{"The binary dictionary is truncated!"};
+  }
+
+  const unsigned char *pos_;
+  const unsigned char *end_;
+};  // Reader
+
+// Returns a reader at the passed offset of the section [begin, end). The offset is read from the file, so it is checked
+// before it is added to begin.
+Reader reader_at(const unsigned char *begin, const unsigned char *end, uint64_t offset) {
+  if (offset > static_cast<uint64_t>(end - begin)) throw Exception{"The binary dictionary contains a bad offset!"};
+  return Reader{begin + offset, end};
+}
+
+// Throws an Exception if the table at the beginning of the section [begin, end), e.g. a count and its offsets, is
+// bigger than the section.
+void check_table(const unsigned char *begin, const unsigned char *end, uint64_t table_size) {
+  if (table_size > static_cast<uint64_t>(end - begin))
+    throw Exception{"The binary dictionary contains a bad table size!"};
+}
+
+void unpack_gender_numerus(unsigned char value, Gender &gender, Numerus &numerus) {
+  gender = static_cast<Gender>(value & 0x0f);
+  numerus = static_cast<Numerus>(value >> 4);
+}
+
+WordClass unpack_word_class(unsigned char value) {
+  if (value >= WORD_CLASS_COUNT) throw Exception{"The binary dictionary contains a bad word class!"};
+  return WORD_CLASSES[value];
+}
+}  // anonymous namespace
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+const uint32_t BinaryDictionaryWriter::BLOCK_SIZE{16};
+
+BinaryDictionaryWriter::BinaryDictionaryWriter(const std::string &language_in, const std::string &language_out)
+    : language_in_{language_in},
+      language_out_{language_out},
+      comments_{},
+      abbreviations_{},
+      phrases_in_{},
+      phrases_out_{} {
+  if (2 != language_in.size() || 2 != language_out.size())
+    throw Exception{"The language ids \"" + language_in + "\" and \"" + language_out + "\" must have two letters!"};
+}
+
+uint32_t BinaryDictionaryWriter::intern(const std::string &str, std::map<std::string, uint32_t> &pool) {
+  return pool.emplace(str, pool.size()).first->second;
+}
+
+BinaryDictionaryWriter::PhraseData &BinaryDictionaryWriter::add_phrase(const DictionaryPhrase &phrase,
+                                                                       std::map<phrase_key, PhraseData> &phrases) {
+  PhraseData &data(phrases[phrase_key{phrase.phrase, phrase.gender, phrase.numerus, phrase.word_class}]);
+  for (const std::string &comment : phrase.comments) data.comments.insert(intern(comment, this->comments_));
+  for (const std::string &abbreviation : phrase.abbreviations)
+    data.abbreviations.insert(intern(abbreviation, this->abbreviations_));
+  return data;
+}
+
+void BinaryDictionaryWriter::add(const DictionaryPhrase &phrase_in, const DictionaryPhrase &phrase_out) {
+  PhraseData &data_out(this->add_phrase(phrase_out, this->phrases_out_));
+  PhraseData &data_in(this->add_phrase(phrase_in, this->phrases_in_));
+  data_in.translations.insert(&data_out);
+}
+
+void BinaryDictionaryWriter::write(std::ostream &dest) const {
+  std::string sections[SECTION_COUNT];
+
+  write_table(sections[0], pool_to_vector(this->comments_));
+  write_table(sections[1], pool_to_vector(this->abbreviations_));
+
+  std::unordered_map<const PhraseData *, uint32_t> record_ids;
+  std::vector<std::string> records;
+  for (const std::pair<const phrase_key, PhraseData> &phrase : this->phrases_out_) {
+    record_ids.emplace(&phrase.second, records.size());
+    std::string record;
+    write_varint(record, std::get<0>(phrase.first).size());
+    record += std::get<0>(phrase.first);
+    record.push_back(static_cast<char>(pack_gender_numerus(std::get<1>(phrase.first), std::get<2>(phrase.first))));
+    record.push_back(static_cast<char>(pack_word_class(std::get<3>(phrase.first))));
+    write_ids(record, phrase.second.comments);
+    write_ids(record, phrase.second.abbreviations);
+    records.push_back(std::move(record));
+  }
+  write_table(sections[2], records);
+
+  // The phrases in are grouped by their phrase string, all senses of a phrase string form a single entry.
+  std::vector<std::string> phrases;
+  std::vector<std::string> entries;
+  for (std::map<phrase_key, PhraseData>::const_iterator iter{this->phrases_in_.cbegin()};
+       iter != this->phrases_in_.cend();) {
+    const std::string &phrase(std::get<0>(iter->first));
+    std::map<phrase_key, PhraseData>::const_iterator group_end{iter};
+    size_t sense_count{0};
+    while (group_end != this->phrases_in_.cend() && std::get<0>(group_end->first) == phrase) {
+      ++group_end;
+      ++sense_count;
+    }
+    std::string entry;
+    write_varint(entry, sense_count);
+    for (; iter != group_end; ++iter) {
+      entry.push_back(static_cast<char>(pack_gender_numerus(std::get<1>(iter->first), std::get<2>(iter->first))));
+      entry.push_back(static_cast<char>(pack_word_class(std::get<3>(iter->first))));
+      write_ids(entry, iter->second.comments);
+      write_ids(entry, iter->second.abbreviations);
+      std::set<uint32_t> translations;
+      for (const PhraseData *translation : iter->second.translations) translations.insert(record_ids[translation]);
+      write_ids(entry, translations);
+    }
+    phrases.push_back(phrase);
+    entries.push_back(std::move(entry));
+  }
+
+  std::string &phrase_table(sections[3]);
+  std::vector<uint32_t> block_offsets;
+  std::string blocks;
+  for (size_t pos{0}; pos != phrases.size(); ++pos) {
+    if (0 == pos % BLOCK_SIZE) {
+      block_offsets.push_back(blocks.size());
+      write_varint(blocks, phrases[pos].size());
+      blocks += phrases[pos];
+    } else {
+      const std::string &previous(phrases[pos - 1]);
+      size_t shared{0};
+      while (shared != previous.size() && shared != phrases[pos].size() && previous[shared] == phrases[pos][shared])
+        ++shared;
+      write_varint(blocks, shared);
+      write_varint(blocks, phrases[pos].size() - shared);
+      blocks.append(phrases[pos], shared, std::string::npos);
+    }
+  }
+  write_uint32(phrase_table, phrases.size());
+  write_uint32(phrase_table, BLOCK_SIZE);
+  for (const uint32_t &offset : block_offsets) write_uint32(phrase_table, offset);
+  phrase_table += blocks;
+
+  std::string &entry_table(sections[4]);
+  uint32_t offset{0};
+  for (const std::string &entry : entries) {
+    write_uint32(entry_table, offset);
+    offset += entry.size();
+  }
+  write_uint32(entry_table, offset);
+  for (const std::string &entry : entries) entry_table += entry;
+
+  std::string header{MAGIC, MAGIC_SIZE};
+  write_uint32(header, VERSION);
+  header += this->language_in_ + this->language_out_;
+  uint64_t section_offset{HEADER_SIZE};
+  for (const std::string &section : sections) {
+    write_uint64(header, section_offset);
+    section_offset += section.size();
+  }
+  dest << header;
+  for (const std::string &section : sections) dest << section;
+  if (!dest) throw Exception{"Cannot write the binary dictionary!"};
+}
+
+BinaryDictionary::BinaryDictionary(const std::string &path)
+    : data_{nullptr},
+      size_{0},
+      comments_{},
+      abbreviations_{},
+      records_{},
+      phrases_{},
+      entries_{},
+      phrase_count_{0},
+      block_size_{0} {
+  int file_descriptor{open(path.c_str(), O_RDONLY)};
+  if (-1 == file_descriptor) throw Exception{"Cannot open the binary dictionary \"" + path + "\"!"};
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) || static_cast<size_t>(file_status.st_size) < HEADER_SIZE) {
+    close(file_descriptor);
+    throw Exception{"The file \"" + path + "\" is not a binary dictionary!"};
+  }
+  this->size_ = file_status.st_size;
+  void *data{mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, file_descriptor, 0)};
+  close(file_descriptor);
+  if (MAP_FAILED == data) throw Exception{"Cannot map the binary dictionary \"" + path + "\" into memory!"};
+  this->data_ = static_cast<const unsigned char *>(data);
+
+  try {
+    Reader header{this->data_ + MAGIC_SIZE, this->data_ + HEADER_SIZE};
+    if (memcmp(this->data_, MAGIC, MAGIC_SIZE) || VERSION != header.read_uint32())
+      throw Exception{"The file \"" + path + "\" is not a binary dictionary of version " + std::to_string(VERSION) +
+                      "!"};
+    this->comments_ = this->section(0);
+    this->abbreviations_ = this->section(1);
+    this->records_ = this->section(2);
+    this->phrases_ = this->section(3);
+    this->entries_ = this->section(4);
+    Reader phrase_table{this->phrases_.begin, this->phrases_.end};
+    this->phrase_count_ = phrase_table.read_uint32();
+    this->block_size_ = phrase_table.read_uint32();
+    if (!this->block_size_) throw Exception{"The binary dictionary \"" + path + "\" has a bad block size!"};
+    // The offset tables are checked once here, the offsets they contain are checked when they are used
+    for (const Section *table : {&this->comments_, &this->abbreviations_, &this->records_}) {
+      uint64_t count{Reader{table->begin, table->end}.read_uint32()};
+      check_table(table->begin, table->end, 4 + 4 * (count + 1));
+    }
+    uint64_t block_count{(static_cast<uint64_t>(this->phrase_count_) + this->block_size_ - 1) / this->block_size_};
+    check_table(this->phrases_.begin, this->phrases_.end, 8 + 4 * block_count);
+    check_table(this->entries_.begin, this->entries_.end, 4 * (static_cast<uint64_t>(this->phrase_count_) + 1));
+  } catch (...) {
+    munmap(const_cast<unsigned char *>(this->data_), this->size_);
+    throw;
+  }
+}
+
+BinaryDictionary::BinaryDictionary(BinaryDictionary &&other) noexcept : data_{other.data_},
+                                                                        size_{other.size_},
+                                                                        comments_(other.comments_),
+                                                                        abbreviations_(other.abbreviations_),
+                                                                        records_(other.records_),
+                                                                        phrases_(other.phrases_),
+                                                                        entries_(other.entries_),
+                                                                        phrase_count_{other.phrase_count_},
+                                                                        block_size_{other.block_size_} {
+  other.data_ = nullptr;
+  other.size_ = 0;
+}
+
+BinaryDictionary::~BinaryDictionary() {
+  if (this->data_) munmap(const_cast<unsigned char *>(this->data_), this->size_);
+}
+
+std::string BinaryDictionary::language_in() const {
+  return std::string{reinterpret_cast<const char *>(this->data_) + MAGIC_SIZE + 4, 2};
+}
+
+std::string BinaryDictionary::language_out() const {
+  return std::string{reinterpret_cast<const char *>(this->data_) + MAGIC_SIZE + 6, 2};
+}
+
+size_t BinaryDictionary::size() const noexcept { return this->phrase_count_; }
+
+BinaryDictionary::Section BinaryDictionary::section(size_t index) const {
+  Reader header{this->data_ + MAGIC_SIZE + 8 + 8 * index, this->data_ + HEADER_SIZE};
+  uint64_t begin{header.read_uint64()};
+  uint64_t end{index + 1 == SECTION_COUNT ? this->size_ : header.read_uint64()};
+  if (begin < HEADER_SIZE || begin > end || end > this->size_)
+    throw Exception{"The binary dictionary contains a bad section offset!"};
+  return Section{this->data_ + begin, this->data_ + end};
+}
+
+std::string BinaryDictionary::pool_string(const Section &pool, uint64_t id) const {
+  Reader table{pool.begin, pool.end};
+  uint64_t count{table.read_uint32()};
+  if (id >= count) throw Exception{"The binary dictionary contains a bad string id!"};
+  Reader offsets{reader_at(pool.begin, pool.end, 4 + 4 * id)};
+  uint32_t begin{offsets.read_uint32()};
+  uint32_t end{offsets.read_uint32()};
+  if (begin > end) throw Exception{"The binary dictionary contains a bad string offset!"};
+  Reader data{reader_at(pool.begin, pool.end, 4 + 4 * (count + 1) + begin)};
+  return data.read_string(end - begin);
+}
+
+DictionaryPhrase BinaryDictionary::record(uint64_t id) const {
+  Reader table{this->records_.begin, this->records_.end};
+  uint64_t count{table.read_uint32()};
+  if (id >= count) throw Exception{"The binary dictionary contains a bad record id!"};
+  Reader offsets{reader_at(this->records_.begin, this->records_.end, 4 + 4 * id)};
+  Reader record{reader_at(this->records_.begin, this->records_.end, 4 + 4 * (count + 1) + offsets.read_uint32())};
+  DictionaryPhrase result;
+  result.phrase = record.read_string(record.read_varint());
+  unpack_gender_numerus(record.read_byte(), result.gender, result.numerus);
+  result.word_class = unpack_word_class(record.read_byte());
+  for (uint64_t count{record.read_varint()}; count; --count)
+    result.comments.push_back(this->pool_string(this->comments_, record.read_varint()));
+  for (uint64_t count{record.read_varint()}; count; --count)
+    result.abbreviations.push_back(this->pool_string(this->abbreviations_, record.read_varint()));
+  return result;
+}
+
+std::string BinaryDictionary::phrase(size_t index) const {
+  if (index >= this->phrase_count_) throw Exception{"The phrase index " + std::to_string(index) + " is too big!"};
+  size_t block{index / this->block_size_};
+  size_t block_count{(static_cast<size_t>(this->phrase_count_) + this->block_size_ - 1) / this->block_size_};
+  Reader offsets{reader_at(this->phrases_.begin, this->phrases_.end, 8 + 4 * block)};
+  Reader reader{reader_at(this->phrases_.begin, this->phrases_.end, 8 + 4 * block_count + offsets.read_uint32())};
+  std::string result{reader.read_string(reader.read_varint())};
+  for (size_t pos{block * this->block_size_}; pos != index; ++pos) {
+    uint64_t shared{reader.read_varint()};
+    if (shared > result.size()) throw Exception{"The binary dictionary contains a bad front coding!"};
+    result.resize(shared);
+    result += reader.read_string(reader.read_varint());
+  }
+  return result;
+}
+
+size_t BinaryDictionary::find(const std::string &phrase) const {
+  if (!this->phrase_count_) return 0;
+  size_t block_count{(static_cast<size_t>(this->phrase_count_) + this->block_size_ - 1) / this->block_size_};
+  const uint64_t blocks{8 + 4 * block_count};
+
+  // binary search for the last block whose first phrase is not greater than the searched phrase
+  size_t low{0};
+  size_t high{block_count};
+  while (high - low > 1) {
+    size_t middle{low + (high - low) / 2};
+    Reader offsets{reader_at(this->phrases_.begin, this->phrases_.end, 8 + 4 * middle)};
+    Reader reader{reader_at(this->phrases_.begin, this->phrases_.end, blocks + offsets.read_uint32())};
+    if (phrase < reader.read_string(reader.read_varint()))
+      high = middle;
+    else
+      low = middle;
+  }
+
+  // linear scan within the block
+  Reader offsets{reader_at(this->phrases_.begin, this->phrases_.end, 8 + 4 * low)};
+  Reader reader{reader_at(this->phrases_.begin, this->phrases_.end, blocks + offsets.read_uint32())};
+  std::string current{reader.read_string(reader.read_varint())};
+  size_t end{std::min<size_t>((low + 1) * this->block_size_, this->phrase_count_)};
+  for (size_t pos{low * this->block_size_};; ++pos) {
+    if (current == phrase) return pos;
+    if (current > phrase || pos + 1 == end) return this->phrase_count_;
+    uint64_t shared{reader.read_varint()};
+    if (shared > current.size()) throw Exception{"The binary dictionary contains a bad front coding!"};
+    current.resize(shared);
+    current += reader.read_string(reader.read_varint());
+  }
+}
+
+std::vector<DictionaryEntry> BinaryDictionary::lookup(const std::string &phrase) const {
+  std::vector<DictionaryEntry> result;
+  size_t index{this->find(phrase)};
+  if (index == this->phrase_count_) return result;
+  Reader offsets{reader_at(this->entries_.begin, this->entries_.end, 4 * index)};
+  Reader entry{reader_at(this->entries_.begin, this->entries_.end,
+                         4 * (static_cast<uint64_t>(this->phrase_count_) + 1) + offsets.read_uint32())};
+  for (uint64_t sense_count{entry.read_varint()}; sense_count; --sense_count) {
+    DictionaryEntry sense;
+    sense.phrase_in.phrase = phrase;
+    unpack_gender_numerus(entry.read_byte(), sense.phrase_in.gender, sense.phrase_in.numerus);
+    sense.phrase_in.word_class = unpack_word_class(entry.read_byte());
+    for (uint64_t count{entry.read_varint()}; count; --count)
+      sense.phrase_in.comments.push_back(this->pool_string(this->comments_, entry.read_varint()));
+    for (uint64_t count{entry.read_varint()}; count; --count)
+      sense.phrase_in.abbreviations.push_back(this->pool_string(this->abbreviations_, entry.read_varint()));
+    for (uint64_t count{entry.read_varint()}; count; --count)
+      sense.phrases_out.push_back(this->record(entry.read_varint()));
+    result.push_back(std::move(sense));
+  }
+  return result;
+}
+
+}  // utils
+}  // translate
+}  // lgeorgieff
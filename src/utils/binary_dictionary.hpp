@@ -0,0 +1,182 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares the compiler and the reader of the binary dictionary format, i.e. a compact and indexed
+//              representation of a language resource that can be queried without a data base.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// File format
+// ===========
+//
+// All integers are little endian, "varint" denotes an unsigned LEB128 value.
+//
+// header:        "TRLTDICT" | uint32 version | char[2] language in | char[2] language out |
+//                uint64 offset of each of the sections below
+// string pool:   uint32 count | uint32 offsets[count + 1] | string data
+//                (used for the comment pool and the abbreviation pool, each string is stored only once)
+// record table:  uint32 count | uint32 offsets[count + 1] | records
+//                record: varint length | phrase | byte gender/numerus | byte word class |
+//                        varint comment count | varint comment ids | varint abbreviation count | varint ids
+//                (one record for every distinct phrase of the language out)
+// phrase table:  uint32 count | uint32 block size | uint32 block offsets[block count] | blocks
+//                block: varint length | first phrase | (varint shared prefix | varint length | suffix)*
+//                (the sorted and front coded distinct phrases of the language in)
+// entry table:   uint32 offsets[phrase count + 1] | entries
+//                entry: varint sense count | senses
+//                sense: byte gender/numerus | byte word class | varint comment count | varint comment ids |
+//                       varint abbreviation count | varint ids | varint translation count | varint record ids
+//                (the n-th entry belongs to the n-th phrase)
+//
+// Gender and numerus are packed into one byte, the gender value in the lower and the numerus value in the upper
+// four bits. The word class is stored as its position in the list of all word classes.
+// ====================================================================================================================
+
+#ifndef BINARY_DICTIONARY_HPP_
+#define BINARY_DICTIONARY_HPP_
+
+#include "gender.hpp"
+#include "numerus.hpp"
+#include "word_class.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+// A phrase with all its characteristics as it is stored in a binary dictionary.
+struct DictionaryPhrase {
+  std::string phrase;
+  Gender gender;
+  Numerus numerus;
+  WordClass word_class;
+  std::vector<std::string> comments;
+  std::vector<std::string> abbreviations;
+};
+
+// A phrase of the language in with all its translations into the language out.
+struct DictionaryEntry {
+  DictionaryPhrase phrase_in;
+  std::vector<DictionaryPhrase> phrases_out;
+};
+
+// Collects translations and writes them in the binary dictionary format.
+class BinaryDictionaryWriter {
+ public:
+  // The number of phrases in a front coded block.
+  static const uint32_t BLOCK_SIZE;
+
+  // Instantiates a writer for the passed language in and language out.
+  BinaryDictionaryWriter(const std::string &, const std::string &);
+  BinaryDictionaryWriter(const BinaryDictionaryWriter &) = delete;
+  BinaryDictionaryWriter(BinaryDictionaryWriter &&) = default;
+  BinaryDictionaryWriter &operator=(const BinaryDictionaryWriter &) = delete;
+  BinaryDictionaryWriter &operator=(BinaryDictionaryWriter &&) = default;
+  ~BinaryDictionaryWriter() = default;
+
+  // Adds a translation from the first into the second phrase. Comments and abbreviations of the same phrase from
+  // several translations are merged.
+  void add(const DictionaryPhrase &, const DictionaryPhrase &);
+  // Writes the binary dictionary of all added translations to the passed stream.
+  void write(std::ostream &) const;
+
+ private:
+  // Identifies a phrase, i.e. phrase, gender, numerus and word class.
+  typedef std::tuple<std::string, Gender, Numerus, WordClass> phrase_key;
+
+  // The interned comments and abbreviations of a phrase and the data of all its translations.
+  struct PhraseData {
+    std::set<uint32_t> comments;
+    std::set<uint32_t> abbreviations;
+    std::set<const PhraseData *> translations;
+  };
+
+  // Returns the id of the passed string in the passed pool and inserts the string if necessary.
+  static uint32_t intern(const std::string &, std::map<std::string, uint32_t> &);
+  // Adds the passed phrase to the passed phrase map and returns its data.
+  PhraseData &add_phrase(const DictionaryPhrase &, std::map<phrase_key, PhraseData> &);
+
+  std::string language_in_;
+  std::string language_out_;
+  std::map<std::string, uint32_t> comments_;
+  std::map<std::string, uint32_t> abbreviations_;
+  std::map<phrase_key, PhraseData> phrases_in_;
+  std::map<phrase_key, PhraseData> phrases_out_;
+};  // BinaryDictionaryWriter
+
+// A read only view on a binary dictionary file. The file is mapped into memory, lookups use a binary search on the
+// front coded phrase table and decode only the matching entry.
+class BinaryDictionary {
+ public:
+  // Maps the passed binary dictionary file into memory. An Exception is thrown if the file cannot be read or if it is
+  // not a valid binary dictionary.
+  explicit BinaryDictionary(const std::string &);
+  BinaryDictionary(const BinaryDictionary &) = delete;
+  BinaryDictionary(BinaryDictionary &&) noexcept;
+  BinaryDictionary &operator=(const BinaryDictionary &) = delete;
+  BinaryDictionary &operator=(BinaryDictionary &&) = delete;
+  ~BinaryDictionary();
+
+  // Returns the id of the language in, e.g. "DE".
+  std::string language_in() const;
+  // Returns the id of the language out, e.g. "EN".
+  std::string language_out() const;
+  // Returns the number of distinct phrases of the language in.
+  size_t size() const noexcept;
+  // Returns the n-th phrase of the sorted phrase table.
+  std::string phrase(size_t) const;
+  // Returns all entries for the passed phrase of the language in. The result is empty if the phrase is unknown.
+  std::vector<DictionaryEntry> lookup(const std::string &) const;
+
+ private:
+  // A section of the mapped file.
+  struct Section {
+    const unsigned char *begin;
+    const unsigned char *end;
+  };
+
+  // Returns the section with the passed index from the header.
+  Section section(size_t) const;
+  // Returns the n-th string of the passed string pool.
+  std::string pool_string(const Section &, uint64_t) const;
+  // Decodes the n-th record of the record table.
+  DictionaryPhrase record(uint64_t) const;
+  // Returns the position of the passed phrase in the phrase table or size() if it is not contained.
+  size_t find(const std::string &) const;
+
+  const unsigned char *data_;
+  size_t size_;
+  Section comments_;
+  Section abbreviations_;
+  Section records_;
+  Section phrases_;
+  Section entries_;
+  uint32_t phrase_count_;
+  uint32_t block_size_;
+};  // BinaryDictionary
+
+}  // utils
+}  // translate
+}  // lgeorgieff
+
+#endif  // BINARY_DICTIONARY_HPP_
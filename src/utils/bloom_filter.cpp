@@ -0,0 +1,89 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements a Bloom filter that tells which phrases are definitely not contained in a set of phrases.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "bloom_filter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+BloomFilter::BloomFilter(size_t expected_size, double false_positive_rate)
+    : bits_{}, bit_count_{64}, hash_count_{1}, size_{0} {
+  const double ln2{std::log(2.0)};
+  false_positive_rate = std::min(std::max(false_positive_rate, 1e-9), 0.5);
+  const double bits{std::ceil(-static_cast<double>(std::max<size_t>(expected_size, 1)) *
+                              std::log(false_positive_rate) / (ln2 * ln2))};
+  this->bit_count_ = std::max<uint64_t>(64, static_cast<uint64_t>(bits));
+  this->bits_.resize((this->bit_count_ + 63) / 64);
+  this->bit_count_ = this->bits_.size() * 64;
+  this->hash_count_ = std::max<size_t>(1, static_cast<size_t>(std::lround(-std::log(false_positive_rate) / ln2)));
+}
+
+void BloomFilter::add(const std::string &str) {
+  uint64_t first, second;
+  hash(str, first, second);
+  for (size_t pos{0}; pos != this->hash_count_; ++pos) {
+    const uint64_t bit{(first + pos * second) % this->bit_count_};
+    this->bits_[bit / 64] |= uint64_t{1} << (bit % 64);
+  }
+  ++this->size_;
+}
+
+bool BloomFilter::contains(const std::string &str) const {
+  uint64_t first, second;
+  hash(str, first, second);
+  for (size_t pos{0}; pos != this->hash_count_; ++pos) {
+    const uint64_t bit{(first + pos * second) % this->bit_count_};
+    if (!(this->bits_[bit / 64] & (uint64_t{1} << (bit % 64)))) return false;
+  }
+  return true;
+}
+
+size_t BloomFilter::size() const noexcept { return this->size_; }
+
+size_t BloomFilter::bytes() const noexcept { return this->bits_.size() * sizeof(uint64_t); }
+
+size_t BloomFilter::hash_count() const noexcept { return this->hash_count_; }
+
+double BloomFilter::false_positive_rate() const {
+  return std::pow(1.0 - std::exp(-static_cast<double>(this->hash_count_ * this->size_) / this->bit_count_),
+                  static_cast<double>(this->hash_count_));
+}
+
+void BloomFilter::hash(const std::string &str, uint64_t &first, uint64_t &second) {
+  // FNV-1a, the second hash is the first one mixed by the finalizer of MurmurHash3
+  first = 14695981039346656037u;
+  for (char chr : str) {
+    first ^= static_cast<unsigned char>(chr);
+    first *= 1099511628211u;
+  }
+  second = first;
+  second ^= second >> 33;
+  second *= 0xff51afd7ed558ccdu;
+  second ^= second >> 33;
+  second *= 0xc4ceb9fe1a85ec53u;
+  second ^= second >> 33;
+  second |= 1;
+}
+
+}  // utils
+}  // translate
+}  // lgeorgieff
@@ -0,0 +1,72 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares a Bloom filter that tells which phrases are definitely not contained in a set of phrases.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#ifndef BLOOM_FILTER_HPP_
+#define BLOOM_FILTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+// A Bloom filter over strings. The number of bits and hash functions is chosen for the expected number of strings
+// and the requested false positive rate, i.e. about 9.6 bits and 7 hash functions per string for a rate of 1%.
+// contains() never returns false for an added string, but returns true for a string that was not added with about
+// the requested rate. The bit positions of a string are derived from two 64 bit hashes by double hashing.
+class BloomFilter {
+ public:
+  // Instantiates an empty filter for the passed expected number of strings and false positive rate.
+  BloomFilter(size_t, double);
+  BloomFilter(const BloomFilter &) = delete;
+  BloomFilter(BloomFilter &&) = default;
+  BloomFilter &operator=(const BloomFilter &) = delete;
+  BloomFilter &operator=(BloomFilter &&) = default;
+  ~BloomFilter() = default;
+
+  // Adds the passed string.
+  void add(const std::string &);
+  // Returns false if the passed string was definitely not added.
+  bool contains(const std::string &) const;
+  // Returns the number of added strings.
+  size_t size() const noexcept;
+  // Returns the number of bytes of the bit array.
+  size_t bytes() const noexcept;
+  // Returns the number of hash functions.
+  size_t hash_count() const noexcept;
+  // Returns the expected false positive rate for the number of added strings.
+  double false_positive_rate() const;
+
+ private:
+  // Returns the two hashes of the passed string, the second one is odd.
+  static void hash(const std::string &, uint64_t &, uint64_t &);
+
+  std::vector<uint64_t> bits_;
+  uint64_t bit_count_;
+  size_t hash_count_;
+  size_t size_;
+};  // BloomFilter
+
+}  // utils
+}  // translate
+}  // lgeorgieff
+
+#endif  // BLOOM_FILTER_HPP_
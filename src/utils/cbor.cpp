@@ -0,0 +1,297 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements the encoding of json values as CBOR and the decoding of CBOR into json strings.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "cbor.hpp"
+#include "json_exception.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+using lgeorgieff::translate::utils::JsonException;
+
+// The major types of CBOR data items
+const uint8_t MAJOR_UNSIGNED{0};
+const uint8_t MAJOR_NEGATIVE{1};
+const uint8_t MAJOR_TEXT{3};
+const uint8_t MAJOR_ARRAY{4};
+const uint8_t MAJOR_MAP{5};
+const uint8_t MAJOR_SIMPLE{7};
+// The additional information of an item of indefinite length and of the break that terminates it
+const uint8_t INDEFINITE{31};
+const uint8_t BREAK{0xFF};
+// Nested arrays and maps are decoded recursively, deeper data is rejected
+const size_t MAX_DEPTH{256};
+
+// Appends the head of a data item, i.e. the major type and the passed argument in the shortest form.
+void append_head(uint8_t major_type, uint64_t argument, std::string &destination) {
+  const char type(static_cast<char>(major_type << 5));
+  if (argument < 24) {
+    destination += static_cast<char>(type | argument);
+    return;
+  }
+  size_t bytes{8};
+  if (argument <= 0xFF)
+    bytes = 1;
+  else if (argument <= 0xFFFF)
+    bytes = 2;
+  else if (argument <= 0xFFFFFFFF)
+    bytes = 4;
+  // 24, 25, 26 and 27 denote an argument of 1, 2, 4 and 8 bytes
+  destination += static_cast<char>(type | (1 == bytes ? 24 : 2 == bytes ? 25 : 4 == bytes ? 26 : 27));
+  for (size_t pos{bytes}; pos != 0; --pos) destination += static_cast<char>(argument >> ((pos - 1) * 8));
+}
+
+// Appends the passed string as json string literal, only the characters json requires are escaped.
+void append_quoted(const char *begin, const char *end, std::string &destination) {
+  static const char HEX_DIGITS[]{"0123456789abcdef"};
+  destination += '"';
+  for (const char *chr{begin}; chr != end; ++chr) {
+    switch (*chr) {
+      case '"': destination += "\\\""; break;
+      case '\\': destination += "\\\\"; break;
+      case '\b': destination += "\\b"; break;
+      case '\f': destination += "\\f"; break;
+      case '\n': destination += "\\n"; break;
+      case '\r': destination += "\\r"; break;
+      case '\t': destination += "\\t"; break;
+      default:
+        if (0x20 > static_cast<unsigned char>(*chr)) {
+          destination += "\\u00";
+          destination += HEX_DIGITS[*chr >> 4];
+          destination += HEX_DIGITS[*chr & 0xF];
+        } else {
+          destination += *chr;
+        }
+    }
+  }
+  destination += '"';
+}
+
+// A reader of a single CBOR data item that writes it as json string.
+class CborReader {
+ public:
+  explicit CborReader(const std::string &cbor) : cbor_(cbor), pos_{0} {}
+
+  // Appends the json string of the data item to the passed string.
+  void read(std::string &destination) {
+    this->read_item(destination, 0);
+    if (this->pos_ != this->cbor_.size()) this->fail("data after the first item");
+  }
+
+ private:
+  uint8_t next_byte() {
+    if (this->pos_ == this->cbor_.size()) this->fail("unexpected end");
+    return static_cast<uint8_t>(this->cbor_[this->pos_++]);
+  }
+
+  // Reads the argument of the passed additional information, i.e. the value, length or number of elements.
+  uint64_t read_argument(uint8_t info) {
+    if (info < 24) return info;
+    if (info > 27) this->fail("reserved additional information " + std::to_string(info));
+    const size_t bytes{static_cast<size_t>(1) << (info - 24)};
+    uint64_t argument{0};
+    for (size_t pos{0}; pos != bytes; ++pos) argument = (argument << 8) | this->next_byte();
+    return argument;
+  }
+
+  void read_item(std::string &destination, size_t depth) {
+    if (depth > MAX_DEPTH) this->fail("nested too deeply");
+    const uint8_t initial{this->next_byte()};
+    const uint8_t major_type(initial >> 5), info(initial & 0x1F);
+    if (MAJOR_SIMPLE == major_type) return this->read_simple(info, destination);
+    if (INDEFINITE == info) {
+      if (MAJOR_ARRAY != major_type && MAJOR_MAP != major_type) this->fail("indefinite length string");
+      return this->read_container(major_type, 0, true, destination, depth);
+    }
+    const uint64_t argument{this->read_argument(info)};
+    switch (major_type) {
+      case MAJOR_UNSIGNED:
+        destination += std::to_string(argument);
+        break;
+      case MAJOR_NEGATIVE:
+        // -1 - argument, which may exceed the range of int64_t
+        destination += '-';
+        destination += argument == UINT64_MAX ? "18446744073709551616" : std::to_string(argument + 1);
+        break;
+      case MAJOR_TEXT:
+        if (argument > this->cbor_.size() - this->pos_) this->fail("unexpected end");
+        append_quoted(this->cbor_.data() + this->pos_, this->cbor_.data() + this->pos_ + argument, destination);
+        this->pos_ += argument;
+        break;
+      case MAJOR_ARRAY:
+      case MAJOR_MAP:
+        this->read_container(major_type, argument, false, destination, depth);
+        break;
+      default:
+        this->fail("unsupported major type " + std::to_string(major_type));
+    }
+  }
+
+  // Reads the passed number of elements of an array or map or all elements up to the break if indefinite is set.
+  void read_container(uint8_t major_type, uint64_t elements, bool indefinite, std::string &destination,
+                      size_t depth) {
+    destination += MAJOR_ARRAY == major_type ? '[' : '{';
+    for (uint64_t element{0}; indefinite || element != elements; ++element) {
+      if (indefinite && this->pos_ != this->cbor_.size() && BREAK == static_cast<uint8_t>(this->cbor_[this->pos_])) {
+        ++this->pos_;
+        break;
+      }
+      if (element) destination += ',';
+      if (MAJOR_MAP == major_type) {
+        if (this->pos_ == this->cbor_.size() || MAJOR_TEXT != static_cast<uint8_t>(this->cbor_[this->pos_]) >> 5 ||
+            INDEFINITE == (static_cast<uint8_t>(this->cbor_[this->pos_]) & 0x1F))
+          this->fail("map key that is no string");
+        this->read_item(destination, depth + 1);
+        destination += ':';
+      }
+      this->read_item(destination, depth + 1);
+    }
+    destination += MAJOR_ARRAY == major_type ? ']' : '}';
+  }
+
+  void read_simple(uint8_t info, std::string &destination) {
+    switch (info) {
+      case 20:
+        destination += "false";
+        return;
+      case 21:
+        destination += "true";
+        return;
+      case 22:
+      case 23:
+        destination += "null";
+        return;
+      case 25:
+        return this->append_real(this->read_half(), destination);
+      case 26: {
+        const uint32_t bits{static_cast<uint32_t>(this->read_argument(info))};
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return this->append_real(value, destination);
+      }
+      case 27: {
+        const uint64_t bits{this->read_argument(info)};
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return this->append_real(value, destination);
+      }
+      default:
+        this->fail("unsupported simple value " + std::to_string(info));
+    }
+  }
+
+  double read_half() {
+    const uint16_t bits{static_cast<uint16_t>(this->read_argument(25))};
+    const int exponent{(bits >> 10) & 0x1F}, mantissa{bits & 0x3FF};
+    double value;
+    if (0 == exponent)
+      value = std::ldexp(mantissa, -24);
+    else if (31 == exponent)
+      value = mantissa ? NAN : INFINITY;
+    else
+      value = std::ldexp(mantissa + 1024, exponent - 25);
+    return bits & 0x8000 ? -value : value;
+  }
+
+  // json has no representation of NaN and infinity, they are written as null like by Json::FastWriter
+  void append_real(double value, std::string &destination) {
+    destination += std::isfinite(value) ? Json::valueToString(value) : "null";
+  }
+
+  [[noreturn]] void fail(const std::string &reason) const {
+    throw JsonException{"The CBOR data cannot be decoded at byte " + std::to_string(this->pos_) + ": " + reason + "!"};
+  }
+
+  const std::string &cbor_;
+  size_t pos_;
+};  // CborReader
+}  // anonymous namespace
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+const std::string CBOR_MEDIA_TYPE{"application/cbor"};
+
+std::string json_to_cbor(const Json::Value &value) {
+  std::string result;
+  append_cbor(value, result);
+  return result;
+}
+
+void append_cbor(const Json::Value &value, std::string &destination) {
+  switch (value.type()) {
+    case Json::nullValue:
+      destination += static_cast<char>(0xF6);
+      break;
+    case Json::booleanValue:
+      destination += static_cast<char>(value.asBool() ? 0xF5 : 0xF4);
+      break;
+    case Json::intValue:
+      if (value.asLargestInt() >= 0)
+        append_head(MAJOR_UNSIGNED, static_cast<uint64_t>(value.asLargestInt()), destination);
+      else
+        append_head(MAJOR_NEGATIVE, static_cast<uint64_t>(-1 - value.asLargestInt()), destination);
+      break;
+    case Json::uintValue:
+      append_head(MAJOR_UNSIGNED, value.asLargestUInt(), destination);
+      break;
+    case Json::realValue: {
+      const double real{value.asDouble()};
+      uint64_t bits;
+      std::memcpy(&bits, &real, sizeof(bits));
+      // 27 denotes a double precision float
+      destination += static_cast<char>((MAJOR_SIMPLE << 5) | 27);
+      for (size_t pos{8}; pos != 0; --pos) destination += static_cast<char>(bits >> ((pos - 1) * 8));
+      break;
+    }
+    case Json::stringValue: {
+      const char *begin{nullptr}, *end{nullptr};
+      value.getString(&begin, &end);
+      append_head(MAJOR_TEXT, static_cast<uint64_t>(end - begin), destination);
+      destination.append(begin, end);
+      break;
+    }
+    case Json::arrayValue:
+      append_head(MAJOR_ARRAY, value.size(), destination);
+      for (const Json::Value &element : value) append_cbor(element, destination);
+      break;
+    case Json::objectValue:
+      append_head(MAJOR_MAP, value.size(), destination);
+      for (auto member = value.begin(); value.end() != member; ++member) {
+        const std::string name{member.name()};
+        append_head(MAJOR_TEXT, name.size(), destination);
+        destination += name;
+        append_cbor(*member, destination);
+      }
+      break;
+  }
+}
+
+std::string cbor_to_json_string(const std::string &cbor) {
+  std::string result;
+  result.reserve(cbor.size() + cbor.size() / 4);
+  CborReader{cbor}.read(result);
+  return result;
+}
+
+}  // utils
+}  // translate
+}  // lgeorgieff
@@ -0,0 +1,50 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares the encoding of json values as CBOR and the decoding of CBOR into json strings.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#ifndef CBOR_HPP_
+#define CBOR_HPP_
+
+#include "json/json.h"
+
+#include <cstddef>
+#include <string>
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+// The media type of CBOR data, see RFC 7049
+extern const std::string CBOR_MEDIA_TYPE;
+
+// Returns the CBOR encoding of the passed json value. Objects are encoded as maps with string keys, integers as
+// integers and real numbers as double precision floats, so the encoding has the same values as the json string.
+std::string json_to_cbor(const Json::Value &);
+// Appends the CBOR encoding of the passed json value to the passed string.
+void append_cbor(const Json::Value &, std::string &);
+
+// Returns the compact json string of the passed CBOR data item without building a tree of Json::Value objects.
+// Besides the types written by json_to_cbor, indefinite length arrays and maps, half and single precision floats and
+// undefined, which is written as null, are supported. Byte strings, tags and non string map keys have no json
+// counterpart. A JsonException is thrown if the data is malformed or not supported.
+std::string cbor_to_json_string(const std::string &);
+
+}  // utils
+}  // translate
+}  // lgeorgieff
+
+#endif  // CBOR_HPP_
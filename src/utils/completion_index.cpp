@@ -0,0 +1,138 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements an in-memory index that returns the most popular completions of a phrase prefix.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "completion_index.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+const size_t CompletionIndex::MAX_COMPLETIONS{50};
+
+void CompletionIndex::add(const std::string &phrase, size_t score) {
+  auto added = this->added_.emplace(phrase, this->phrases_.size());
+  if (added.second) {
+    this->phrases_.push_back(phrase);
+    this->scores_.push_back(0);
+  }
+  uint32_t &current_score = this->scores_[added.first->second];
+  current_score = static_cast<uint32_t>(
+      std::min<size_t>(std::numeric_limits<uint32_t>::max(), static_cast<size_t>(current_score) + score));
+}
+
+void CompletionIndex::build() {
+  std::vector<uint32_t> order(this->phrases_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [this](uint32_t lft, uint32_t rgt) { return this->phrases_[lft] < this->phrases_[rgt]; });
+  std::vector<std::string> phrases;
+  std::vector<uint32_t> scores;
+  phrases.reserve(order.size());
+  scores.reserve(order.size());
+  for (uint32_t pos : order) {
+    phrases.push_back(std::move(this->phrases_[pos]));
+    scores.push_back(this->scores_[pos]);
+  }
+  this->phrases_.swap(phrases);
+  this->scores_.swap(scores);
+  this->added_.clear();
+  this->top_completions_.clear();
+
+  std::vector<uint32_t> root;
+  if (!this->phrases_.empty()) this->build_node(0, static_cast<uint32_t>(this->phrases_.size()), 0, root);
+}
+
+std::vector<std::string> CompletionIndex::complete(const std::string &prefix, size_t limit) const {
+  limit = std::min(limit, MAX_COMPLETIONS);
+  auto begin = std::lower_bound(this->phrases_.begin(), this->phrases_.end(), prefix);
+  auto end = std::partition_point(begin, this->phrases_.end(), [&prefix](const std::string &phrase) {
+    return !phrase.compare(0, prefix.size(), prefix);
+  });
+  const uint32_t lo{static_cast<uint32_t>(begin - this->phrases_.begin())};
+  const uint32_t hi{static_cast<uint32_t>(end - this->phrases_.begin())};
+
+  std::vector<uint32_t> ranked;
+  auto top = this->top_completions_.find(range_key(lo, hi));
+  if (this->top_completions_.end() != top) {
+    ranked.assign(top->second.begin(), top->second.begin() + std::min(limit, top->second.size()));
+  } else {
+    ranked.resize(hi - lo);
+    std::iota(ranked.begin(), ranked.end(), lo);
+    auto middle = ranked.begin() + std::min(limit, ranked.size());
+    std::partial_sort(ranked.begin(), middle, ranked.end(),
+                      [this](uint32_t lft, uint32_t rgt) { return this->ranked_before(lft, rgt); });
+    ranked.erase(middle, ranked.end());
+  }
+
+  std::vector<std::string> result;
+  result.reserve(ranked.size());
+  for (uint32_t pos : ranked) result.push_back(this->phrases_[pos]);
+  return result;
+}
+
+size_t CompletionIndex::size() const noexcept { return this->phrases_.size(); }
+
+bool CompletionIndex::ranked_before(uint32_t lft, uint32_t rgt) const {
+  if (this->scores_[lft] != this->scores_[rgt]) return this->scores_[lft] > this->scores_[rgt];
+  return lft < rgt;
+}
+
+void CompletionIndex::build_node(uint32_t lo, uint32_t hi, size_t depth, std::vector<uint32_t> &top) {
+  auto ranking = [this](uint32_t lft, uint32_t rgt) { return this->ranked_before(lft, rgt); };
+  top.clear();
+  if (hi - lo <= MAX_COMPLETIONS) {
+    for (uint32_t pos{lo}; pos != hi; ++pos) top.push_back(pos);
+    std::sort(top.begin(), top.end(), ranking);
+    return;
+  }
+
+  // Skip all characters that are shared by the whole range, i.e. the edge to the next branching node. Since the
+  // phrases are sorted, it is sufficient to compare the first and the last phrase.
+  while (this->phrases_[lo].size() > depth && this->phrases_[lo][depth] == this->phrases_[hi - 1][depth]) ++depth;
+
+  uint32_t child_lo{lo};
+  if (this->phrases_[lo].size() == depth) top.push_back(child_lo++);
+  std::vector<uint32_t> child_top;
+  while (child_lo != hi) {
+    const char current{this->phrases_[child_lo][depth]};
+    auto child_end = std::partition_point(
+        this->phrases_.begin() + child_lo, this->phrases_.begin() + hi,
+        [depth, current](const std::string &phrase) { return phrase[depth] == current; });
+    const uint32_t child_hi{static_cast<uint32_t>(child_end - this->phrases_.begin())};
+    this->build_node(child_lo, child_hi, depth + 1, child_top);
+    top.insert(top.end(), child_top.begin(), child_top.end());
+    child_lo = child_hi;
+  }
+
+  auto middle = top.begin() + std::min(MAX_COMPLETIONS, top.size());
+  std::partial_sort(top.begin(), middle, top.end(), ranking);
+  top.erase(middle, top.end());
+  this->top_completions_[range_key(lo, hi)] = top;
+}
+
+uint64_t CompletionIndex::range_key(uint32_t lo, uint32_t hi) noexcept {
+  return (static_cast<uint64_t>(lo) << 32) | hi;
+}
+
+}  // utils
+}  // translate
+}  // lgeorgieff
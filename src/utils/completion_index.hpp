@@ -0,0 +1,79 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares an in-memory index that returns the most popular completions of a phrase prefix.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#ifndef COMPLETION_INDEX_HPP_
+#define COMPLETION_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+// An index over phrases and their popularity scores for prefix completion.
+// All phrases are kept in a sorted array, so the completions of a prefix form a contiguous range that is found by a
+// binary search. Each branching node of the implicit radix trie over this array that covers more than
+// MAX_COMPLETIONS phrases stores its top MAX_COMPLETIONS phrases, smaller ranges are ranked on the fly. Thus, a
+// lookup never touches more than MAX_COMPLETIONS phrases besides the binary search.
+class CompletionIndex {
+ public:
+  // The maximum number of completions a single lookup returns.
+  static const size_t MAX_COMPLETIONS;
+
+  CompletionIndex() = default;
+  CompletionIndex(const CompletionIndex &) = delete;
+  CompletionIndex(CompletionIndex &&) = default;
+  CompletionIndex &operator=(const CompletionIndex &) = delete;
+  CompletionIndex &operator=(CompletionIndex &&) = default;
+  ~CompletionIndex() = default;
+
+  // Adds a phrase with the passed popularity score. The scores of a phrase that is added several times are summed up.
+  // build() must be called after the last phrase was added.
+  void add(const std::string &, size_t);
+  // Sorts all added phrases and precomputes the top completions of all large trie nodes.
+  void build();
+  // Returns up to the passed number of phrases, but not more than MAX_COMPLETIONS, that start with the passed prefix.
+  // The phrases are ordered by descending popularity and ascending phrase.
+  std::vector<std::string> complete(const std::string &, size_t) const;
+  // Returns the number of distinct phrases of this index.
+  size_t size() const noexcept;
+
+ private:
+  // Returns true if the phrase at the first position is ranked before the phrase at the second position.
+  bool ranked_before(uint32_t, uint32_t) const;
+  // Appends the top completions of the passed range to the passed vector, the range starts at the trie node with the
+  // passed depth.
+  void build_node(uint32_t, uint32_t, size_t, std::vector<uint32_t> &);
+  // Returns the key of a range in top_completions_.
+  static uint64_t range_key(uint32_t, uint32_t) noexcept;
+
+  std::vector<std::string> phrases_;
+  std::vector<uint32_t> scores_;
+  std::unordered_map<std::string, size_t> added_;
+  std::unordered_map<uint64_t, std::vector<uint32_t>> top_completions_;
+};  // CompletionIndex
+
+}  // utils
+}  // translate
+}  // lgeorgieff
+
+#endif  // COMPLETION_INDEX_HPP_
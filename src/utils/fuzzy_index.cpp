@@ -0,0 +1,177 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements an in-memory index that finds phrases within a small edit distance of a misspelled phrase.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "fuzzy_index.hpp"
+#include "helper.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+namespace {
+// Returns the FNV-1a hash of the passed code points.
+uint32_t hash_code_points(const std::u32string &str) {
+  uint32_t hash{2166136261u};
+  for (char32_t code_point : str) {
+    hash ^= static_cast<uint32_t>(code_point);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Appends the hashes of the passed string and of all variants with up to the passed number of further deleted
+// characters. Only characters at a position of at least first are deleted, so every variant is generated once.
+void add_deletes(std::u32string &str, size_t first, size_t distance, std::vector<uint32_t> &hashes) {
+  hashes.push_back(hash_code_points(str));
+  if (!distance) return;
+  for (size_t pos{first}; pos < str.size(); ++pos) {
+    const char32_t deleted{str[pos]};
+    str.erase(pos, 1);
+    add_deletes(str, pos, distance - 1, hashes);
+    str.insert(pos, 1, deleted);
+  }
+}
+}  // anonymous namespace
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+const size_t FuzzyIndex::MAX_DISTANCE{2};
+const size_t FuzzyIndex::PREFIX_LENGTH{7};
+
+void FuzzyIndex::add(const std::string &phrase, size_t score) {
+  auto added = this->added_.emplace(phrase, this->phrases_.size());
+  if (added.second) {
+    this->phrases_.push_back(phrase);
+    this->scores_.push_back(0);
+  }
+  uint32_t &current_score = this->scores_[added.first->second];
+  current_score = static_cast<uint32_t>(
+      std::min<size_t>(std::numeric_limits<uint32_t>::max(), static_cast<size_t>(current_score) + score));
+}
+
+void FuzzyIndex::build() {
+  std::vector<uint32_t> order(this->phrases_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [this](uint32_t lft, uint32_t rgt) { return this->phrases_[lft] < this->phrases_[rgt]; });
+  std::vector<std::string> phrases;
+  std::vector<uint32_t> scores;
+  phrases.reserve(order.size());
+  scores.reserve(order.size());
+  for (uint32_t pos : order) {
+    phrases.push_back(std::move(this->phrases_[pos]));
+    scores.push_back(this->scores_[pos]);
+  }
+  this->phrases_.swap(phrases);
+  this->scores_.swap(scores);
+  this->added_.clear();
+
+  // Phrases with the same prefix are adjacent in the sorted phrase list, since UTF-8 preserves the order of code
+  // points. So the deletion index only refers to groups of phrases.
+  this->groups_.clear();
+  this->deletes_.clear();
+  std::u32string last_prefix;
+  std::vector<uint32_t> hashes;
+  for (uint32_t pos{0}; pos != this->phrases_.size(); ++pos) {
+    std::u32string prefix{utf8_to_u32string(this->phrases_[pos]).substr(0, PREFIX_LENGTH)};
+    if (!this->groups_.empty() && prefix == last_prefix) continue;
+    const uint64_t group{this->groups_.size()};
+    this->groups_.push_back(pos);
+    hashes.clear();
+    add_deletes(prefix, 0, MAX_DISTANCE, hashes);
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+    for (uint32_t hash : hashes) this->deletes_.push_back((static_cast<uint64_t>(hash) << 32) | group);
+    last_prefix.swap(prefix);
+  }
+  this->groups_.push_back(static_cast<uint32_t>(this->phrases_.size()));
+  std::sort(this->deletes_.begin(), this->deletes_.end());
+  this->deletes_.shrink_to_fit();
+}
+
+std::vector<std::string> FuzzyIndex::lookup(const std::string &phrase, size_t distance, size_t limit) const {
+  distance = std::min(distance, MAX_DISTANCE);
+  const std::u32string code_points{utf8_to_u32string(phrase)};
+  std::u32string prefix{code_points.substr(0, PREFIX_LENGTH)};
+  std::vector<uint32_t> hashes;
+  add_deletes(prefix, 0, distance, hashes);
+
+  std::vector<uint32_t> groups;
+  for (uint32_t hash : hashes) {
+    auto posting = std::lower_bound(this->deletes_.begin(), this->deletes_.end(), static_cast<uint64_t>(hash) << 32);
+    for (; this->deletes_.end() != posting && hash == (*posting >> 32); ++posting)
+      groups.push_back(static_cast<uint32_t>(*posting));
+  }
+  std::sort(groups.begin(), groups.end());
+  groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+
+  // distance, phrase position
+  std::vector<std::tuple<size_t, uint32_t>> matches;
+  for (uint32_t group : groups) {
+    for (uint32_t pos{this->groups_[group]}; pos != this->groups_[group + 1]; ++pos) {
+      std::u32string candidate{utf8_to_u32string(this->phrases_[pos])};
+      if (std::max(candidate.size(), code_points.size()) - std::min(candidate.size(), code_points.size()) > distance)
+        continue;
+      size_t candidate_distance{edit_distance(code_points, candidate, distance)};
+      if (candidate_distance <= distance) matches.emplace_back(candidate_distance, pos);
+    }
+  }
+  std::sort(matches.begin(), matches.end(),
+            [this](const std::tuple<size_t, uint32_t> &lft, const std::tuple<size_t, uint32_t> &rgt) {
+              if (std::get<0>(lft) != std::get<0>(rgt)) return std::get<0>(lft) < std::get<0>(rgt);
+              if (this->scores_[std::get<1>(lft)] != this->scores_[std::get<1>(rgt)])
+                return this->scores_[std::get<1>(lft)] > this->scores_[std::get<1>(rgt)];
+              return std::get<1>(lft) < std::get<1>(rgt);
+            });
+
+  std::vector<std::string> result;
+  for (size_t pos{0}; pos != std::min(limit, matches.size()); ++pos)
+    result.push_back(this->phrases_[std::get<1>(matches[pos])]);
+  return result;
+}
+
+size_t FuzzyIndex::size() const noexcept { return this->phrases_.size(); }
+
+size_t FuzzyIndex::edit_distance(const std::u32string &lft, const std::u32string &rgt, size_t bound) {
+  // The optimal string alignment distance, computed row by row. If all values of a row exceed the bound, the final
+  // distance exceeds it as well.
+  std::vector<size_t> previous(rgt.size() + 1), current(rgt.size() + 1), before_previous(rgt.size() + 1);
+  std::iota(previous.begin(), previous.end(), 0);
+  for (size_t row{1}; row <= lft.size(); ++row) {
+    current[0] = row;
+    size_t row_minimum{current[0]};
+    for (size_t column{1}; column <= rgt.size(); ++column) {
+      const size_t cost{lft[row - 1] == rgt[column - 1] ? 0u : 1u};
+      current[column] = std::min({previous[column] + 1, current[column - 1] + 1, previous[column - 1] + cost});
+      if (row > 1 && column > 1 && lft[row - 1] == rgt[column - 2] && lft[row - 2] == rgt[column - 1])
+        current[column] = std::min(current[column], before_previous[column - 2] + 1);
+      row_minimum = std::min(row_minimum, current[column]);
+    }
+    if (row_minimum > bound) return bound + 1;
+    before_previous.swap(previous);
+    previous.swap(current);
+  }
+  return std::min(previous[rgt.size()], bound + 1);
+}
+
+}  // utils
+}  // translate
+}  // lgeorgieff
@@ -0,0 +1,81 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares an in-memory index that finds phrases within a small edit distance of a misspelled phrase.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#ifndef FUZZY_INDEX_HPP_
+#define FUZZY_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+// A symmetric deletion index (SymSpell) over phrases and their popularity scores.
+// Only the first PREFIX_LENGTH characters of a phrase are indexed: all variants of this prefix with up to
+// MAX_DISTANCE deleted characters are hashed and point to the group of phrases that share the prefix. A lookup
+// generates the same variants for the requested phrase, so the candidates are found by a few hash lookups instead of
+// a scan. Finally, the edit distance of each candidate is verified. Distances are counted in unicode code points and
+// a transposition of two adjacent characters counts as a single edit.
+class FuzzyIndex {
+ public:
+  // The maximum edit distance that is supported by lookup().
+  static const size_t MAX_DISTANCE;
+  // The number of leading characters of a phrase that are indexed.
+  static const size_t PREFIX_LENGTH;
+
+  FuzzyIndex() = default;
+  FuzzyIndex(const FuzzyIndex &) = delete;
+  FuzzyIndex(FuzzyIndex &&) = default;
+  FuzzyIndex &operator=(const FuzzyIndex &) = delete;
+  FuzzyIndex &operator=(FuzzyIndex &&) = default;
+  ~FuzzyIndex() = default;
+
+  // Adds a phrase with the passed popularity score. The scores of a phrase that is added several times are summed up.
+  // build() must be called after the last phrase was added.
+  void add(const std::string &, size_t);
+  // Sorts all added phrases and creates the deletion index.
+  void build();
+  // Returns up to the passed number of phrases whose edit distance to the passed phrase is not greater than the
+  // passed distance, which is limited to MAX_DISTANCE. The phrases are ordered by ascending distance, descending
+  // popularity and ascending phrase.
+  std::vector<std::string> lookup(const std::string &, size_t, size_t) const;
+  // Returns the number of distinct phrases of this index.
+  size_t size() const noexcept;
+
+  // Returns the edit distance of both passed strings of code points, but at most the passed bound plus 1.
+  static size_t edit_distance(const std::u32string &, const std::u32string &, size_t);
+
+ private:
+  std::vector<std::string> phrases_;
+  std::vector<uint32_t> scores_;
+  std::unordered_map<std::string, size_t> added_;
+  // The position of the first phrase of each prefix group in phrases_, the last value is the number of phrases.
+  std::vector<uint32_t> groups_;
+  // The sorted postings of the deletion index, the hash of a variant in the upper and the group in the lower 32 bits.
+  std::vector<uint64_t> deletes_;
+};  // FuzzyIndex
+
+}  // utils
+}  // translate
+}  // lgeorgieff
+
+#endif  // FUZZY_INDEX_HPP_
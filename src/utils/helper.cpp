@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/14/2015
+// Last modified: 10/19/2026
 // Description: Defines several helper functions for the entire project.
 // ====================================================================================================================
 
@@ -23,6 +23,7 @@
 
 #include <cstddef>
 #include <cctype>
+#include <cstdlib>
 #include <functional>
 #include <algorithm>
 #include <stdexcept>
@@ -117,6 +118,22 @@ std::string to_upper_case(const std::string &str) {
   return result;
 }
 
+std::string percent_encode(const std::string &str) {
+  static const char HEX_DIGITS[]{"0123456789ABCDEF"};
+  std::string result;
+  result.reserve(str.size());
+  for (unsigned char chr : str) {
+    if ((chr < 0x80 && std::isalnum(chr)) || '-' == chr || '.' == chr || '_' == chr || '~' == chr) {
+      result += static_cast<char>(chr);
+    } else {
+      result += '%';
+      result += HEX_DIGITS[chr >> 4];
+      result += HEX_DIGITS[chr & 0x0F];
+    }
+  }
+  return result;
+}
+
 std::vector<std::string> split_string(const std::string &source, char delimiter, bool trim_result) {
   std::vector<std::string> result;
   std::string::const_iterator source_end{source.cend()};
@@ -150,23 +167,108 @@ void parse_accept_header_item(const std::string &accept_item, std::string &accep
   }
 }
 
-bool check_accept_header(const std::string &accept_header, const std::string &expected) {
+double parse_accept_header_quality(const std::string &accept_item) {
+  std::vector<std::string> parameters{split_string(accept_item, ';', true)};
+  for (size_t pos{1}; pos < parameters.size(); ++pos) {
+    if (parameters[pos].size() < 2 || (parameters[pos][0] != 'q' && parameters[pos][0] != 'Q')) continue;
+    std::string value{parameters[pos].substr(1)};
+    trim(value);
+    if (value.empty() || value[0] != '=') continue;
+    char *value_end{nullptr};
+    const double quality{std::strtod(value.c_str() + 1, &value_end)};
+    if (value_end == value.c_str() + 1) return 1;
+    return quality < 0 ? 0 : (quality > 1 ? 1 : quality);
+  }
+  return 1;
+}
+
+double accept_header_quality(const std::string &accept_header, const std::string &expected, bool exact_only) {
   std::string expected_type, expected_subtype;
   parse_accept_header_item(expected, expected_type, expected_subtype);
   if (expected_type.empty()) expected_type = "*";
-  if (expected_type.empty()) expected_subtype = "*";
-  if (expected_type == "*" && expected_subtype == "*") return true;
+  if (expected_subtype.empty()) expected_subtype = "*";
+  if (expected_type == "*" && expected_subtype == "*") return 1;
+  // The specificity of a matching item is 0 for "*/*", 1 for "type/*" and 2 for "type/subtype"
+  int best_specificity{-1};
+  double quality{0};
   for (const std::string &accept_item : split_string(accept_header, ',')) {
     std::string accept_type, accept_subtype;
     parse_accept_header_item(accept_item, accept_type, accept_subtype);
+    int specificity{-1};
     if (accept_type == "*" && accept_subtype == "*")
-      return true;
+      specificity = 0;
     else if (accept_type == expected_type && (accept_subtype == "*" || expected_subtype == "*"))
-      return true;
+      specificity = accept_subtype == "*" ? 1 : 2;
     else if (accept_type == expected_type && accept_subtype == expected_subtype)
-      return true;
+      specificity = 2;
+    if (exact_only && (accept_type == "*" || accept_subtype == "*")) specificity = -1;
+    if (specificity > best_specificity) {
+      best_specificity = specificity;
+      quality = parse_accept_header_quality(accept_item);
+    }
   }
-  return false;
+  return quality;
+}
+
+bool check_accept_header(const std::string &accept_header, const std::string &expected) {
+  return accept_header_quality(accept_header, expected) > 0;
+}
+
+std::u32string utf8_to_u32string(const std::string &str) {
+  std::u32string result;
+  result.reserve(str.size());
+  for (size_t pos{0}; pos != str.size();) {
+    const unsigned char lead{static_cast<unsigned char>(str[pos])};
+    size_t length{1};
+    char32_t code_point{lead};
+    if (0xC0 == (lead & 0xE0)) {
+      length = 2;
+      code_point = lead & 0x1F;
+    } else if (0xE0 == (lead & 0xF0)) {
+      length = 3;
+      code_point = lead & 0x0F;
+    } else if (0xF0 == (lead & 0xF8)) {
+      length = 4;
+      code_point = lead & 0x07;
+    }
+    bool valid{1 == length || pos + length <= str.size()};
+    for (size_t offset{1}; valid && offset != length; ++offset) {
+      const unsigned char trail{static_cast<unsigned char>(str[pos + offset])};
+      valid = 0x80 == (trail & 0xC0);
+      code_point = (code_point << 6) | (trail & 0x3F);
+    }
+    if (valid) {
+      result.push_back(code_point);
+      pos += length;
+    } else {
+      result.push_back(lead);
+      ++pos;
+    }
+  }
+  return result;
+}
+
+std::string u32string_to_utf8(const std::u32string &str) {
+  std::string result;
+  result.reserve(str.size());
+  for (char32_t code_point : str) {
+    if (code_point < 0x80) {
+      result += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+      result += static_cast<char>(0xC0 | (code_point >> 6));
+      result += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+      result += static_cast<char>(0xE0 | (code_point >> 12));
+      result += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      result += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+      result += static_cast<char>(0xF0 | (code_point >> 18));
+      result += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+      result += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      result += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+  }
+  return result;
 }
 
 // Returns the folder which contains the executable file.
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/14/2015
+// Last modified: 10/19/2026
 // Description: Declares several helper functions for the entire project.
 // ====================================================================================================================
 
@@ -57,6 +57,10 @@ std::string get_last_path_from_url(const char *, bool = true);
 // Returns a copy of the passed string that contains each character in upper case format.
 std::string to_upper_case(const std::string &);
 
+// Returns the passed string percent-encoded (RFC 3986), i.e. every byte except letters, digits, '-', '.', '_' and '~'
+// is written as "%XX", e.g. "Stra%C3%9Fe%0D%0A" for "Straße\r\n". The result is safe as value of an HTTP header.
+std::string percent_encode(const std::string &);
+
 // Returns a vector of strings that are generated from the original string value which is split by the passed delimiter
 // character. If the bool value is set to true the split values are trimmed for white space characters in the beginning
 // and in the end.
@@ -66,11 +70,26 @@ std::vector<std::string> split_string(const std::string &, char, bool = false);
 // values.
 void parse_accept_header_item(const std::string &, std::string &, std::string &);
 
-// Returns true if the passed accept header string contains the specified accept type.
+// Returns the quality value "q" of one item from the accept header field, 1 if it has none.
+double parse_accept_header_quality(const std::string &);
+
+// Returns the quality value of the specified accept type in the passed accept header string, i.e. the one of the most
+// specific matching item, or 0 if no item matches. If the bool value is set to true only items without placeholders
+// like "*" are taken into account.
+double accept_header_quality(const std::string &, const std::string & = "application/json", bool = false);
+
+// Returns true if the passed accept header string contains the specified accept type with a quality value above 0.
 // This function takes also placeholders like "*" into account.
 // see: http://www.w3.org/Protocols/rfc2616/rfc2616-sec14.html#sec14.1
 bool check_accept_header(const std::string &, const std::string & = "application/json");
 
+// Decodes the passed UTF-8 string into unicode code points. Bytes that are not part of a valid UTF-8 sequence are
+// returned as code points of the same value.
+std::u32string utf8_to_u32string(const std::string &);
+
+// Encodes the passed unicode code points as UTF-8 string.
+std::string u32string_to_utf8(const std::u32string &);
+
 // Returns the folder which contains the executable file.
 // May throw an instance of Exception if cannot read from /proc/.
 std::string get_exe_path();
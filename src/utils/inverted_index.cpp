@@ -0,0 +1,159 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements an in-memory inverted index from the terms of comments and abbreviations to phrase ids.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "inverted_index.hpp"
+#include "phrase_key.hpp"
+
+#include <algorithm>
+
+namespace {
+// Appends the passed value as variable length integer, i.e. 7 bits per byte starting with the lowest ones. The
+// highest bit of a byte is set if another byte follows.
+void write_varint(uint32_t value, std::vector<uint8_t> &dest) {
+  while (value >= 0x80) {
+    dest.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  dest.push_back(static_cast<uint8_t>(value));
+}
+
+// Reads a variable length integer at the passed position and moves the position behind it.
+uint32_t read_varint(const uint8_t *&pos) {
+  uint32_t value{0};
+  for (unsigned shift{0};; shift += 7) {
+    const uint8_t byte{*pos++};
+    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return value;
+  }
+}
+
+// Returns true if the passed byte separates two terms, i.e. if it is an ASCII character but no letter or digit. All
+// bytes of multibyte UTF-8 sequences belong to a term.
+bool is_separator(char byte) {
+  const unsigned char value{static_cast<unsigned char>(byte)};
+  return value < 0x80 && !(('a' <= value && 'z' >= value) || ('0' <= value && '9' >= value));
+}
+}  // anonymous namespace
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+void InvertedIndex::add(const std::string &text, uint32_t id) {
+  for (const std::string &term : tokenize(text)) this->added_[term].push_back(id);
+}
+
+void InvertedIndex::build() {
+  this->terms_.clear();
+  this->terms_.reserve(this->added_.size());
+  for (const auto &added : this->added_) this->terms_.push_back(added.first);
+  std::sort(this->terms_.begin(), this->terms_.end());
+
+  this->counts_.clear();
+  this->offsets_.clear();
+  this->postings_.clear();
+  for (const std::string &term : this->terms_) {
+    std::vector<uint32_t> &ids = this->added_[term];
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    this->counts_.push_back(static_cast<uint32_t>(ids.size()));
+    this->offsets_.push_back(this->postings_.size());
+    uint32_t previous{0};
+    for (uint32_t id : ids) {
+      write_varint(id - previous, this->postings_);
+      previous = id;
+    }
+    // the uncompressed list is not needed anymore
+    std::vector<uint32_t>{}.swap(ids);
+  }
+  this->offsets_.push_back(this->postings_.size());
+  this->postings_.shrink_to_fit();
+  this->added_.clear();
+}
+
+std::vector<uint32_t> InvertedIndex::lookup(const std::string &query) const {
+  std::vector<size_t> terms;
+  for (const std::string &term : tokenize(query)) {
+    const size_t term_pos{this->find_term(term)};
+    if (this->terms_.size() == term_pos) return {};
+    terms.push_back(term_pos);
+  }
+  if (terms.empty()) return {};
+  std::sort(terms.begin(), terms.end(), [this](size_t lft, size_t rgt) {
+    return this->counts_[lft] != this->counts_[rgt] ? this->counts_[lft] < this->counts_[rgt] : lft < rgt;
+  });
+  terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+
+  // The shortest list is decoded completely, all further lists are merged against the remaining candidates while
+  // they are decoded, so no other list is materialized.
+  std::vector<uint32_t> result{this->decode(terms.front())};
+  for (auto term = terms.begin() + 1; terms.end() != term && !result.empty(); ++term) {
+    const uint8_t *pos{this->postings_.data() + this->offsets_[*term]};
+    const uint8_t *const end{this->postings_.data() + this->offsets_[*term + 1]};
+    auto kept = result.begin();
+    auto candidate = result.begin();
+    uint32_t current{0};
+    while (end != pos && result.end() != candidate) {
+      current += read_varint(pos);
+      while (result.end() != candidate && *candidate < current) ++candidate;
+      if (result.end() != candidate && *candidate == current) *kept++ = *candidate++;
+    }
+    result.erase(kept, result.end());
+  }
+  return result;
+}
+
+size_t InvertedIndex::size() const noexcept { return this->terms_.size(); }
+
+size_t InvertedIndex::posting_bytes() const noexcept { return this->postings_.size(); }
+
+std::vector<std::string> InvertedIndex::tokenize(const std::string &text) {
+  const std::string folded{to_phrase_key(text)};
+  std::vector<std::string> result;
+  auto begin = folded.begin();
+  while (folded.end() != begin) {
+    begin = std::find_if_not(begin, folded.end(), is_separator);
+    auto end = std::find_if(begin, folded.end(), is_separator);
+    if (begin != end) result.emplace_back(begin, end);
+    begin = end;
+  }
+  return result;
+}
+
+size_t InvertedIndex::find_term(const std::string &term) const {
+  auto found = std::lower_bound(this->terms_.begin(), this->terms_.end(), term);
+  if (this->terms_.end() == found || *found != term) return this->terms_.size();
+  return static_cast<size_t>(found - this->terms_.begin());
+}
+
+std::vector<uint32_t> InvertedIndex::decode(size_t term) const {
+  std::vector<uint32_t> result;
+  result.reserve(this->counts_[term]);
+  const uint8_t *pos{this->postings_.data() + this->offsets_[term]};
+  const uint8_t *const end{this->postings_.data() + this->offsets_[term + 1]};
+  uint32_t current{0};
+  while (end != pos) {
+    current += read_varint(pos);
+    result.push_back(current);
+  }
+  return result;
+}
+
+}  // utils
+}  // translate
+}  // lgeorgieff
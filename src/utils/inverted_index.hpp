@@ -0,0 +1,82 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares an in-memory inverted index from the terms of comments and abbreviations to phrase ids.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#ifndef INVERTED_INDEX_HPP_
+#define INVERTED_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+// An inverted index that maps the terms of texts, e.g. comments and abbreviations, to the ids of the phrases they
+// belong to. Texts are split into terms by all ASCII characters except letters and digits after folding them by
+// to_phrase_key, e.g. "Br." and "<br>" result in the term "br".
+// The posting list of each term is sorted and compressed: the first id and all gaps between consecutive ids are
+// stored as variable length integers with 7 bits per byte. All posting lists share a single byte array. A query with
+// several terms returns the ids of all phrases that contain each term, the lists are intersected starting with the
+// shortest one.
+class InvertedIndex {
+ public:
+  InvertedIndex() = default;
+  InvertedIndex(const InvertedIndex &) = delete;
+  InvertedIndex(InvertedIndex &&) = default;
+  InvertedIndex &operator=(const InvertedIndex &) = delete;
+  InvertedIndex &operator=(InvertedIndex &&) = default;
+  ~InvertedIndex() = default;
+
+  // Adds all terms of the passed text to the posting lists of the passed id. build() must be called after the last
+  // text was added.
+  void add(const std::string &, uint32_t);
+  // Sorts all terms and compresses their posting lists.
+  void build();
+  // Returns the ascending ids that contain all terms of the passed query. A query without any term matches nothing.
+  std::vector<uint32_t> lookup(const std::string &) const;
+  // Returns the number of distinct terms of this index.
+  size_t size() const noexcept;
+  // Returns the number of bytes of all compressed posting lists.
+  size_t posting_bytes() const noexcept;
+
+  // Returns the terms of the passed text in their order of occurrence.
+  static std::vector<std::string> tokenize(const std::string &);
+
+ private:
+  // Returns the position of the passed term in terms_ or terms_.size() if it is not indexed.
+  size_t find_term(const std::string &) const;
+  // Returns all ids of the posting list of the term at the passed position.
+  std::vector<uint32_t> decode(size_t) const;
+
+  std::unordered_map<std::string, std::vector<uint32_t>> added_;
+  std::vector<std::string> terms_;
+  // The number of ids of each term
+  std::vector<uint32_t> counts_;
+  // The start of the posting list of each term in postings_, the last value is the size of postings_
+  std::vector<size_t> offsets_;
+  std::vector<uint8_t> postings_;
+};  // InvertedIndex
+
+}  // utils
+}  // translate
+}  // lgeorgieff
+
+#endif  // INVERTED_INDEX_HPP_
@@ -0,0 +1,127 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Defines a bounded cache that evicts the least recently used entry and counts the hits of each entry.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#ifndef LRU_CACHE_HPP_
+#define LRU_CACHE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+// A cache of at most capacity entries. If a new entry exceeds the capacity, the entry that was not requested for the
+// longest time is evicted. Each entry counts how often it was requested, so the most used keys can be recorded and
+// requested again after a restart. The cache is not synchronized.
+template <typename Key, typename Value>
+class LruCache {
+ public:
+  explicit LruCache(size_t capacity) : capacity_{capacity}, entries_{}, positions_{} {}
+  LruCache(const LruCache &) = delete;
+  LruCache(LruCache &&) = default;
+  LruCache &operator=(const LruCache &) = delete;
+  LruCache &operator=(LruCache &&) = default;
+  ~LruCache() = default;
+
+  // Returns the value of the passed key or nullptr if it is not cached. A found entry becomes the most recently used
+  // one, the returned pointer is valid until the cache is modified.
+  const Value *get(const Key &key) {
+    auto position = this->positions_.find(key);
+    if (this->positions_.end() == position) return nullptr;
+    this->entries_.splice(this->entries_.begin(), this->entries_, position->second);
+    ++position->second->hits;
+    return &position->second->value;
+  }
+
+  // Stores the passed value as most recently used entry of the passed key. The hits of an existing entry are kept.
+  void put(const Key &key, Value value) {
+    if (!this->capacity_) return;
+    auto position = this->positions_.find(key);
+    if (this->positions_.end() != position) {
+      position->second->value = std::move(value);
+      this->entries_.splice(this->entries_.begin(), this->entries_, position->second);
+      return;
+    }
+    if (this->entries_.size() == this->capacity_) {
+      this->positions_.erase(this->entries_.back().key);
+      this->entries_.pop_back();
+    }
+    this->entries_.push_front(Entry{key, std::move(value), 0});
+    this->positions_.emplace(key, this->entries_.begin());
+  }
+
+  // Returns up to the passed number of keys ordered by descending hits and, for equal hits, by recent use.
+  std::vector<Key> most_used(size_t limit) const {
+    std::vector<const Entry *> entries;
+    entries.reserve(this->entries_.size());
+    for (const Entry &entry : this->entries_) entries.push_back(&entry);
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const Entry *lft, const Entry *rgt) { return lft->hits > rgt->hits; });
+    std::vector<Key> result;
+    for (size_t pos{0}; pos != std::min(limit, entries.size()); ++pos) result.push_back(entries[pos]->key);
+    return result;
+  }
+
+  // Removes all entries whose key satisfies the passed predicate and returns their number.
+  template <typename Predicate>
+  size_t erase_if(Predicate predicate) {
+    size_t result{0};
+    for (auto entry = this->entries_.begin(); entry != this->entries_.end();) {
+      if (predicate(entry->key)) {
+        this->positions_.erase(entry->key);
+        entry = this->entries_.erase(entry);
+        ++result;
+      } else {
+        ++entry;
+      }
+    }
+    return result;
+  }
+
+  // Removes all entries.
+  void clear() {
+    this->positions_.clear();
+    this->entries_.clear();
+  }
+
+  // Returns the number of cached entries.
+  size_t size() const noexcept { return this->entries_.size(); }
+
+ private:
+  struct Entry {
+    Key key;
+    Value value;
+    size_t hits;
+  };
+
+  size_t capacity_;
+  // All entries, the most recently used one first
+  std::list<Entry> entries_;
+  std::unordered_map<Key, typename std::list<Entry>::iterator> positions_;
+};  // LruCache
+
+}  // utils
+}  // translate
+}  // lgeorgieff
+
+#endif  // LRU_CACHE_HPP_
@@ -0,0 +1,93 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Implements the folding of phrases into case and diacritic insensitive search keys.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "phrase_key.hpp"
+#include "helper.hpp"
+
+namespace {
+// The folded forms of the Latin-1 supplement letters from U+00C0 to U+00FF. U+00D7 and U+00F7 are no letters.
+const char32_t *const LATIN_1[]{
+    U"a", U"a", U"a", U"a", U"a", U"a", U"ae", U"c", U"e", U"e", U"e", U"e", U"i", U"i", U"i", U"i",
+    U"d", U"n", U"o", U"o", U"o", U"o", U"o", U"×", U"o", U"u", U"u", U"u", U"u", U"y", U"th", U"ss",
+    U"a", U"a", U"a", U"a", U"a", U"a", U"ae", U"c", U"e", U"e", U"e", U"e", U"i", U"i", U"i", U"i",
+    U"d", U"n", U"o", U"o", U"o", U"o", U"o", U"÷", U"o", U"u", U"u", U"u", U"u", U"y", U"th", U"y"};
+
+// The folded forms of the Latin Extended-A letters from U+0100 to U+017F.
+const char32_t *const LATIN_EXTENDED_A[]{
+    U"a", U"a", U"a", U"a", U"a", U"a", U"c", U"c", U"c", U"c", U"c", U"c", U"c", U"c", U"d", U"d",
+    U"d", U"d", U"e", U"e", U"e", U"e", U"e", U"e", U"e", U"e", U"e", U"e", U"g", U"g", U"g", U"g",
+    U"g", U"g", U"g", U"g", U"h", U"h", U"h", U"h", U"i", U"i", U"i", U"i", U"i", U"i", U"i", U"i",
+    U"i", U"i", U"ij", U"ij", U"j", U"j", U"k", U"k", U"k", U"l", U"l", U"l", U"l", U"l", U"l", U"l",
+    U"l", U"l", U"l", U"n", U"n", U"n", U"n", U"n", U"n", U"n", U"n", U"n", U"o", U"o", U"o", U"o",
+    U"o", U"o", U"oe", U"oe", U"r", U"r", U"r", U"r", U"r", U"r", U"s", U"s", U"s", U"s", U"s", U"s",
+    U"s", U"s", U"t", U"t", U"t", U"t", U"t", U"t", U"u", U"u", U"u", U"u", U"u", U"u", U"u", U"u",
+    U"u", U"u", U"u", U"u", U"w", U"w", U"y", U"y", U"y", U"z", U"z", U"z", U"z", U"z", U"z", U"s"};
+
+// The folded forms of the Greek letters from U+0386 to U+03CE, 0 denotes a code point that is kept.
+const char32_t GREEK[]{
+    U'α', 0,    U'ε', U'η', U'ι', 0,    U'ο', 0,    U'υ', U'ω', U'ι', U'α', U'β', U'γ', U'δ', U'ε',
+    U'ζ', U'η', U'θ', U'ι', U'κ', U'λ', U'μ', U'ν', U'ξ', U'ο', U'π', U'ρ', 0,    U'σ', U'τ', U'υ',
+    U'φ', U'χ', U'ψ', U'ω', U'ι', U'υ', U'α', U'ε', U'η', U'ι', U'υ', U'α', U'β', U'γ', U'δ', U'ε',
+    U'ζ', U'η', U'θ', U'ι', U'κ', U'λ', U'μ', U'ν', U'ξ', U'ο', U'π', U'ρ', U'σ', U'σ', U'τ', U'υ',
+    U'φ', U'χ', U'ψ', U'ω', U'ι', U'υ', U'ο', U'υ', U'ω'};
+
+// Appends the folded form of the passed code point to the passed key.
+void fold(char32_t code_point, std::u32string &key) {
+  if (U'A' <= code_point && U'Z' >= code_point) {
+    key += code_point + (U'a' - U'A');
+  } else if (0xC0 <= code_point && 0xFF >= code_point) {
+    key += LATIN_1[code_point - 0xC0];
+  } else if (0x100 <= code_point && 0x17F >= code_point) {
+    key += LATIN_EXTENDED_A[code_point - 0x100];
+  } else if (0x218 <= code_point && 0x21B >= code_point) {
+    // Romanian letters with comma below
+    key += code_point < 0x21A ? U's' : U't';
+  } else if (0x300 <= code_point && 0x36F >= code_point) {
+    // combining diacritical marks are dropped
+  } else if (0x386 <= code_point && 0x3CE >= code_point) {
+    key += GREEK[code_point - 0x386] ? GREEK[code_point - 0x386] : code_point;
+  } else if (0x400 == code_point || 0x401 == code_point || 0x450 == code_point || 0x451 == code_point) {
+    // Ѐ, Ё, ѐ and ё
+    key += U'е';
+  } else if (0x40D == code_point || 0x45D == code_point) {
+    // Ѝ and ѝ
+    key += U'и';
+  } else if (0x402 <= code_point && 0x40F >= code_point) {
+    key += code_point + 0x50;
+  } else if (0x410 <= code_point && 0x42F >= code_point) {
+    key += code_point + 0x20;
+  } else {
+    key += code_point;
+  }
+}
+}  // anonymous namespace
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+std::string to_phrase_key(const std::string &phrase) {
+  std::u32string key;
+  key.reserve(phrase.size());
+  for (char32_t code_point : utf8_to_u32string(phrase)) fold(code_point, key);
+  return u32string_to_utf8(key);
+}
+
+}  // utils
+}  // translate
+}  // lgeorgieff
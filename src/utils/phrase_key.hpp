@@ -0,0 +1,39 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Declares the folding of phrases into case and diacritic insensitive search keys.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#ifndef PHRASE_KEY_HPP_
+#define PHRASE_KEY_HPP_
+
+#include <string>
+
+namespace lgeorgieff {
+namespace translate {
+namespace utils {
+
+// Returns the search key of the passed UTF-8 phrase, i.e. the phrase in lower case without diacritics, e.g. "francais"
+// for "Français" or "strasse" for "Straße". The folding covers the Latin, Greek and Cyrillic letters of all languages
+// of dict.cc, combining diacritical marks are removed and all other characters are kept.
+// The key is stored in the column phrase_key of the table phrase, so the same function must be used for the import
+// and for requests.
+std::string to_phrase_key(const std::string &);
+
+}  // utils
+}  // translate
+}  // lgeorgieff
+
+#endif  // PHRASE_KEY_HPP_
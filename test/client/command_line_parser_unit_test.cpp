@@ -633,3 +633,47 @@ TEST(command_line_parser, numeri_arguments) {
     EXPECT_EQ(clp.phrase(), string{"only a phrase"});
   }
 }
+
+TEST(command_line_parser, interactive_arguments) {
+  CommandLineParser clp = CommandLineParser{};
+  {
+    const char *args[]{"app", "--interactive"};
+    clp(2, args);
+    EXPECT_TRUE(clp.interactive());
+    EXPECT_FALSE(clp.has_phrase());
+  }
+
+  {
+    clp = CommandLineParser{};
+    const char *args[]{"app", "--interactive", "-i", "EN", "-o", "FR"};
+    clp(6, args);
+    EXPECT_TRUE(clp.interactive());
+    EXPECT_EQ(clp.in(), string{"EN"});
+    EXPECT_EQ(clp.out(), string{"FR"});
+  }
+
+  {
+    clp = CommandLineParser{};
+    const char *args[]{"app", "--offline"};
+    clp(2, args);
+    EXPECT_TRUE(clp.offline());
+    EXPECT_FALSE(clp.has_phrase());
+  }
+
+  {
+    clp = CommandLineParser{};
+    const char *args[]{"app", "--timing", "only a phrase"};
+    clp(3, args);
+    EXPECT_TRUE(clp.timing());
+    EXPECT_EQ(clp.phrase(), string{"only a phrase"});
+  }
+
+  {
+    clp = CommandLineParser{};
+    const char *args[]{"app", "only a phrase"};
+    clp(2, args);
+    EXPECT_FALSE(clp.interactive());
+    EXPECT_FALSE(clp.offline());
+    EXPECT_FALSE(clp.timing());
+  }
+}
@@ -26,6 +26,7 @@
 #include <string>
 #include <fstream>
 #include <cstdio>
+#include <vector>
 
 using lgeorgieff::translate::utils::Exception;
 using lgeorgieff::translate::utils::JsonException;
@@ -51,6 +52,38 @@ TEST(configuration_reader, default_configuration_file) {
   EXPECT_FALSE(config_reader.show_numerus());
   EXPECT_FALSE(config_reader.show_abbreviation());
   EXPECT_FALSE(config_reader.show_comment());
+  EXPECT_EQ(std::string{""}, config_reader.dictionary_folder());
+  EXPECT_FALSE(config_reader.timing());
+  EXPECT_TRUE(config_reader.service_endpoints().empty());
+  EXPECT_EQ(0, config_reader.hedge_delay());
+
+  std::remove(CONFIG_PATH.c_str());
+}
+
+TEST(configuration_reader, client_options) {
+  const std::string CONFIG_PATH{"test_config.json"};
+  std::ofstream test_file;
+  test_file.open(CONFIG_PATH);
+  test_file << "{\"dictionary_folder\":\"/var/lib/trlt\",\"timing\":true,\"service_endpoints\":[\"a:8885\","
+               "\"b:8885\"],\"hedge_delay\":50}";
+  test_file.close();
+
+  ConfigurationReader config_reader{CONFIG_PATH};
+  config_reader();
+  EXPECT_EQ(std::string{"/var/lib/trlt"}, config_reader.dictionary_folder());
+  EXPECT_TRUE(config_reader.timing());
+  EXPECT_EQ((std::vector<std::string>{"a:8885", "b:8885"}), config_reader.service_endpoints());
+  EXPECT_EQ(50, config_reader.hedge_delay());
+
+  test_file.open(CONFIG_PATH);
+  test_file << "{\"dictionary_folder\":1}";
+  test_file.close();
+  EXPECT_THROW(config_reader(), JsonException);
+
+  test_file.open(CONFIG_PATH);
+  test_file << "{\"service_endpoints\":[\"a:8885\",1]}";
+  test_file.close();
+  EXPECT_THROW(config_reader(), JsonException);
 
   std::remove(CONFIG_PATH.c_str());
 }
@@ -0,0 +1,88 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Contains unit tests for the ordering of the service endpoints by latency and failures.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "client/endpoint_selector.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+using lgeorgieff::translate::client::EndpointSelector;
+
+namespace {
+const string HISTORY_PATH{"./latency.json"};
+}  // anonymous namespace
+
+TEST(endpoint_selector, ranked_by_latency) {
+  EndpointSelector selector{{"a:8885", "b:8885", "c:8885"}, HISTORY_PATH};
+  EXPECT_EQ((vector<string>{"a:8885", "b:8885", "c:8885"}), selector.ranked());
+
+  selector.record_success("a:8885", 3000);
+  selector.record_success("b:8885", 1000);
+  EXPECT_EQ((vector<string>{"c:8885", "b:8885", "a:8885"}), selector.ranked());
+  selector.record_success("c:8885", 2000);
+  EXPECT_EQ((vector<string>{"b:8885", "c:8885", "a:8885"}), selector.ranked());
+
+  selector.record_success("b:8885", 5000);
+  EXPECT_DOUBLE_EQ(2200, selector.latency("b:8885"));
+  EXPECT_EQ((vector<string>{"c:8885", "b:8885", "a:8885"}), selector.ranked());
+  EXPECT_DOUBLE_EQ(0, selector.latency("d:8885"));
+}
+
+TEST(endpoint_selector, failures) {
+  EndpointSelector selector{{"a:8885", "b:8885", "c:8885"}, HISTORY_PATH};
+  selector.record_success("a:8885", 1000);
+  selector.record_success("b:8885", 2000);
+  selector.record_success("c:8885", 3000);
+  selector.record_failure("a:8885");
+  EXPECT_FALSE(selector.healthy("a:8885"));
+  EXPECT_TRUE(selector.healthy("b:8885"));
+  EXPECT_EQ((vector<string>{"b:8885", "c:8885", "a:8885"}), selector.ranked());
+
+  // a success ends the backoff
+  selector.record_success("a:8885", 1000);
+  EXPECT_TRUE(selector.healthy("a:8885"));
+  EXPECT_EQ((vector<string>{"a:8885", "b:8885", "c:8885"}), selector.ranked());
+}
+
+TEST(endpoint_selector, save_and_load) {
+  {
+    EndpointSelector selector{{"a:8885", "b:8885"}, HISTORY_PATH};
+    selector.record_success("a:8885", 4000);
+    selector.record_success("b:8885", 1000);
+    selector.record_failure("b:8885");
+    EXPECT_TRUE(selector.save());
+  }
+  EndpointSelector selector{{"a:8885", "b:8885", "c:8885"}, HISTORY_PATH};
+  selector.load();
+  EXPECT_DOUBLE_EQ(4000, selector.latency("a:8885"));
+  EXPECT_DOUBLE_EQ(1000, selector.latency("b:8885"));
+  EXPECT_FALSE(selector.healthy("b:8885"));
+  EXPECT_EQ((vector<string>{"c:8885", "a:8885", "b:8885"}), selector.ranked());
+  std::remove(HISTORY_PATH.c_str());
+
+  // a missing history file is ignored
+  EndpointSelector empty_selector{{"a:8885"}, HISTORY_PATH};
+  empty_selector.load();
+  EXPECT_DOUBLE_EQ(0, empty_selector.latency("a:8885"));
+}
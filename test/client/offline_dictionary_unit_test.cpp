@@ -0,0 +1,75 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Unit test for the OfflineDictionary class
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+
+#include "gtest/gtest.h"
+
+#include "client/offline_dictionary.hpp"
+#include "utils/binary_dictionary.hpp"
+#include "utils/exception.hpp"
+
+#include <json/json.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using std::string;
+
+using lgeorgieff::translate::client::OfflineDictionary;
+using lgeorgieff::translate::utils::BinaryDictionaryWriter;
+using lgeorgieff::translate::utils::DictionaryPhrase;
+using lgeorgieff::translate::utils::Exception;
+using lgeorgieff::translate::utils::Gender;
+using lgeorgieff::translate::utils::Numerus;
+using lgeorgieff::translate::utils::WordClass;
+
+namespace {
+const string DICTIONARY_PATH{"./DE-EN.bin"};
+
+// Writes a DE-EN dictionary with two translations of "Haus".
+void write_dictionary() {
+  BinaryDictionaryWriter writer{"DE", "EN"};
+  writer.add(DictionaryPhrase{"Haus", Gender::n, Numerus::none, WordClass::noun, {}, {}},
+             DictionaryPhrase{"house", Gender::none, Numerus::none, WordClass::noun, {"building"}, {"Hse."}});
+  writer.add(DictionaryPhrase{"Haus", Gender::n, Numerus::none, WordClass::noun, {}, {}},
+             DictionaryPhrase{"home", Gender::none, Numerus::none, WordClass::noun, {}, {}});
+  std::ofstream out{DICTIONARY_PATH, std::ofstream::binary};
+  writer.write(out);
+}
+}  // anonymous namespace
+
+TEST(offline_dictionary, lookup) {
+  write_dictionary();
+  OfflineDictionary dictionary{"."};
+  EXPECT_TRUE(dictionary.available("DE", "EN"));
+  EXPECT_FALSE(dictionary.available("EN", "DE"));
+
+  Json::Value options;
+  options["show_word_class"] = false;
+  options["show_abbreviation"] = false;
+  EXPECT_EQ(string{"[{\"phrase\":\"home\"},{\"comments\":[\"building\"],\"phrase\":\"house\"}]"},
+            dictionary("Haus", "DE", "EN", options));
+  EXPECT_EQ(string{"[{\"phrase\":\"home\",\"word_class\":\"noun\"},{\"abbreviations\":[\"Hse.\"],\"comments\":"
+                   "[\"building\"],\"phrase\":\"house\",\"word_class\":\"noun\"}]"},
+            dictionary("Haus", "DE", "EN", Json::Value{}));
+  EXPECT_EQ(string{"[]"}, dictionary("Baum", "DE", "EN", options));
+  EXPECT_THROW(dictionary("Haus", "EN", "DE", options), Exception);
+
+  std::remove(DICTIONARY_PATH.c_str());
+}
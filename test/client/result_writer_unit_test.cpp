@@ -0,0 +1,108 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Unit test for the ResultWriter class
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "client/result_writer.hpp"
+#include "utils/json_exception.hpp"
+
+#include <functional>
+#include <sstream>
+#include <string>
+
+using lgeorgieff::translate::client::ResultWriter;
+using lgeorgieff::translate::utils::JsonException;
+
+TEST(result_writer, write_languages) {
+  std::ostringstream destination;
+  ResultWriter writer{&destination};
+  writer.write_languages(
+      "[{\"id\":\"DE\",\"language\":\"German\"},{\"language\":\"B\\u00e4\\\"r\",\"id\":\"LONGID\",\"extra\":[1,{}]}]");
+  EXPECT_EQ(std::string{"ID        LANGUAGE\nDE        German\nLONGID    B\xC3\xA4\"r\n"}, destination.str());
+}
+
+TEST(result_writer, write_genders) {
+  std::ostringstream destination;
+  ResultWriter writer{&destination};
+  writer.write_genders("[{\"id\":\"f\",\"gender\":\"feminine\",\"description\":\"female\"}]");
+  writer.write_genders("null");
+  writer.write_gender_id("{\"description\":\"female\",\"id\":\"f\"}");
+  EXPECT_EQ(std::string{"ID    GENDER      DESCRIPTION\nf     feminine    female\nid: f, description: female\n"},
+            destination.str());
+}
+
+TEST(result_writer, write_translation) {
+  std::ostringstream destination;
+  ResultWriter writer{&destination};
+  writer.write_translation(
+      "[{\"phrase\":\"Haus\",\"word_class\":\"noun\",\"gender\":\"n\",\"numerus\":null,\"abbreviations\":[\"b\",\"a\","
+      "\"b\"],\"comments\":[\"c2\",\"c1\",null]},null,{\"phrase\":\"house\"},{\"comments\":[\"only\"]},"
+      "{\"phrase\":\"\\ud83d\\ude00\"}]");
+  EXPECT_EQ(std::string{"Haus {noun} {n} <a> <b> [c1] [c2]\nhouse\n[only]\n\xF0\x9F\x98\x80\n"}, destination.str());
+}
+
+TEST(result_writer, invalid_json) {
+  std::ostringstream destination;
+  ResultWriter writer{&destination};
+  EXPECT_THROW(writer.write_languages("[{\"id\":1,\"language\":\"German\"}]"), JsonException);
+  EXPECT_THROW(writer.write_languages("[{\"id\":\"DE\"}]"), JsonException);
+  EXPECT_THROW(writer.write_languages("[{\"id\":\"DE\",\"language\":\"German\"}"), JsonException);
+  EXPECT_THROW(writer.write_languages("{}"), JsonException);
+  EXPECT_THROW(writer.write_translation("[{\"comments\":\"c\"}]"), JsonException);
+  EXPECT_THROW(writer.write_language_id("\"DE\" x"), JsonException);
+  EXPECT_EQ(std::string{}, destination.str());
+}
+
+TEST(result_writer, invalid_translation) {
+  std::ostringstream destination;
+  ResultWriter writer{&destination};
+  EXPECT_THROW(writer.write_translation("[{\"phrase\":\"Haus\"},{\"phrase\":\"house\"}"), JsonException);
+  EXPECT_THROW(writer.write_translation("[{\"phrase\":\"Haus\"},{\"phrase\":1}]"), JsonException);
+  EXPECT_THROW(writer.write_translation("[{\"phrase\":\"Haus\"},[]]"), JsonException);
+  EXPECT_EQ(std::string{}, destination.str());
+}
+
+TEST(result_writer, error_messages) {
+  std::ostringstream destination;
+  ResultWriter writer{&destination};
+  const auto message = [](const std::function<void()> &write) -> std::string {
+    try {
+      write();
+    } catch (const JsonException &error) {
+      return error.what();
+    }
+    return "";
+  };
+  EXPECT_EQ(std::string{"Cannot process the json data 1\n. Expected a json string!"},
+            message([&writer]() { writer.write_translation("[{\"phrase\":\"Haus\"},{\"phrase\":1}]"); }));
+  EXPECT_EQ(std::string{"Cannot process the json data \"c\"\n. Expected a json array!"},
+            message([&writer]() { writer.write_translation("[{\"comments\":\"c\"}]"); }));
+  EXPECT_EQ(std::string{"Cannot process the json data null\n. Expected a json string!"},
+            message([&writer]() { writer.write_languages("[{\"id\":\"DE\"}]"); }));
+  EXPECT_EQ(std::string{"The json data [{\"phrase\":1} cannot be parsed!"},
+            message([&writer]() { writer.write_translation("[{\"phrase\":1}"); }));
+  EXPECT_EQ(std::string{"Cannot process the json data {}. Expected a json array!"},
+            message([&writer]() { writer.write_numeri("{}"); }));
+}
+
+TEST(result_writer, write_numeri) {
+  std::ostringstream destination;
+  ResultWriter writer{&destination};
+  writer.write_numeri("[\"singular\",null,1,true]");
+  EXPECT_EQ(std::string{"NUMERUS\nsingular\n\n1\ntrue\n"}, destination.str());
+}
@@ -0,0 +1,191 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Contains unit tests for the manifest of incremental imports.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "scripts/dict_parser.hpp"
+#include "scripts/import_manifest.hpp"
+#include "scripts/import_staging.hpp"
+#include "utils/exception.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using std::string;
+
+using lgeorgieff::translate::scripts::ImportManifest;
+using lgeorgieff::translate::scripts::LangItem;
+using lgeorgieff::translate::scripts::ManifestEntry;
+using lgeorgieff::translate::scripts::StagingRow;
+using lgeorgieff::translate::scripts::StagingTable;
+using lgeorgieff::translate::scripts::StagingWriter;
+using lgeorgieff::translate::scripts::hash_row;
+using lgeorgieff::translate::scripts::hash_string;
+using lgeorgieff::translate::scripts::process_line;
+using lgeorgieff::translate::scripts::staging_rows;
+using lgeorgieff::translate::utils::Exception;
+
+namespace {
+const string MANIFEST_PATH{"import_manifest_unit_test.manifest"};
+const string NEW_MANIFEST_PATH{MANIFEST_PATH + ".new"};
+const string OTHER_MANIFEST_PATH{"import_manifest_unit_test_other.manifest"};
+
+// Imports the passed lines of a DE-EN resource like trlt-import does against the manifest of the last run, but
+// without a data base. The parsed lines are appended to imported, the rows of removed lines that are not produced by
+// any remaining line are returned. Finally the new manifest replaces the old one.
+ImportManifest::removed_rows_type import_lines(const std::vector<string> &lines, std::vector<string> &imported) {
+  ImportManifest old_manifest;
+  old_manifest.load(MANIFEST_PATH);
+  {
+    std::ofstream new_manifest{NEW_MANIFEST_PATH, std::ofstream::out | std::ofstream::trunc};
+    LangItem lang_item_1, lang_item_2;
+    staging_rows rows;
+    ManifestEntry entry;
+    for (const string &line : lines) {
+      uint64_t line_hash{hash_string(line)};
+      if (!old_manifest.take_line(line_hash, new_manifest)) continue;
+      imported.push_back(line);
+      entry.facts.clear();
+      entry.line = line;
+      if (process_line(line, "DE", "EN", 0, false, lang_item_1, lang_item_2)) {
+        rows.clear();
+        StagingWriter::to_rows(lang_item_1, lang_item_2, rows);
+        for (const StagingRow &row : rows) entry.facts.push_back(hash_row(row));
+      }
+      ImportManifest::write_entry(new_manifest, line_hash, entry);
+    }
+  }
+  ImportManifest::removed_rows_type removed_rows;
+  old_manifest.collect_removed_rows("DE", "EN", removed_rows);
+  ImportManifest::keep_facts(NEW_MANIFEST_PATH, removed_rows);
+  std::rename(NEW_MANIFEST_PATH.c_str(), MANIFEST_PATH.c_str());
+  return removed_rows;
+}
+
+// Returns the number of the passed rows of the passed table whose values contain the passed string.
+size_t count_rows(const ImportManifest::removed_rows_type &rows, StagingTable table, const string &value) {
+  size_t result{0};
+  for (const ImportManifest::removed_rows_type::value_type &row : rows)
+    if (table == row.second.table && string::npos != row.second.values.find(value)) ++result;
+  return result;
+}
+}  // anonymous namespace
+
+TEST(import_manifest, hash_string) {
+  // the test vectors of the 64 bit FNV-1a hash
+  EXPECT_EQ(0xcbf29ce484222325ULL, hash_string(""));
+  EXPECT_EQ(0xaf63dc4c8601ec8cULL, hash_string("a"));
+  EXPECT_EQ(0x85944171f73967e8ULL, hash_string("foobar"));
+  EXPECT_EQ(hash_string("0('Haus', 'DE', 'n', null, 'noun')"),
+            hash_row(StagingRow{StagingTable::phrase, "('Haus', 'DE', 'n', null, 'noun')"}));
+  EXPECT_NE(hash_row(StagingRow{StagingTable::phrase, "('Haus')"}),
+            hash_row(StagingRow{StagingTable::phrase_comment, "('Haus')"}));
+}
+
+TEST(import_manifest, round_trip) {
+  {
+    std::ofstream out{MANIFEST_PATH, std::ofstream::out | std::ofstream::trunc};
+    ImportManifest::write_entry(out, 0xabcdef0123456789ULL,
+                                ManifestEntry{{1, 0xffffffffffffffffULL}, "Haus {n} [Gebäude]\thouse\tnoun"});
+    ImportManifest::write_entry(out, 42, ManifestEntry{{}, "# a comment"});
+  }
+  ImportManifest manifest;
+  manifest.load(MANIFEST_PATH);
+  ASSERT_EQ(2u, manifest.entries().size());
+  const ManifestEntry &entry(manifest.entries().at(0xabcdef0123456789ULL));
+  EXPECT_EQ((std::vector<uint64_t>{1, 0xffffffffffffffffULL}), entry.facts);
+  EXPECT_EQ(string{"Haus {n} [Gebäude]\thouse\tnoun"}, entry.line);
+  EXPECT_TRUE(manifest.entries().at(42).facts.empty());
+  EXPECT_EQ(string{"# a comment"}, manifest.entries().at(42).line);
+
+  std::vector<uint64_t> facts;
+  ImportManifest::for_each_fact(MANIFEST_PATH, [&facts](uint64_t fact) { facts.push_back(fact); });
+  EXPECT_EQ(2u, facts.size());
+
+  manifest.load("import_manifest_unit_test.missing");
+  EXPECT_TRUE(manifest.entries().empty());
+  {
+    std::ofstream out{MANIFEST_PATH, std::ofstream::out | std::ofstream::trunc};
+    out << "abc\tnot a hash\tline\n";
+  }
+  EXPECT_THROW(manifest.load(MANIFEST_PATH), Exception);
+  {
+    std::ofstream out{MANIFEST_PATH, std::ofstream::out | std::ofstream::trunc};
+    out << "abc without tabs\n";
+  }
+  EXPECT_THROW(manifest.load(MANIFEST_PATH), Exception);
+  std::remove(MANIFEST_PATH.c_str());
+}
+
+TEST(import_manifest, changed_removed_and_duplicated_lines) {
+  std::remove(MANIFEST_PATH.c_str());
+  std::vector<string> imported;
+  EXPECT_TRUE(import_lines({"Haus {n} [Gebäude]\thouse\tnoun", "Auto {n}\tcar\tnoun", "Baum {m}\ttree\tnoun",
+                            "Auto {n}\tcar\tnoun"},
+                           imported)
+                  .empty());
+  EXPECT_EQ((std::vector<string>{"Haus {n} [Gebäude]\thouse\tnoun", "Auto {n}\tcar\tnoun", "Baum {m}\ttree\tnoun"}),
+            imported);
+
+  // The comment of "Haus" is changed, "Auto" is unchanged and duplicated, "Baum" is removed.
+  imported.clear();
+  ImportManifest::removed_rows_type removed_rows{
+      import_lines({"Auto {n}\tcar\tnoun", "Haus {n} [Familie]\thouse\tnoun", "Auto {n}\tcar\tnoun"}, imported)};
+  EXPECT_EQ(std::vector<string>{"Haus {n} [Familie]\thouse\tnoun"}, imported);
+  // The phrases and the translation of the changed line are still produced by its new version, only the old comment
+  // is removed.
+  EXPECT_EQ(1u, count_rows(removed_rows, StagingTable::phrase_comment, "Gebäude"));
+  EXPECT_EQ(0u, count_rows(removed_rows, StagingTable::phrase, "Haus"));
+  EXPECT_EQ(0u, count_rows(removed_rows, StagingTable::phrase, "house"));
+  EXPECT_EQ(0u, count_rows(removed_rows, StagingTable::translation, "Haus"));
+  EXPECT_EQ(1u, count_rows(removed_rows, StagingTable::phrase, "Baum"));
+  EXPECT_EQ(1u, count_rows(removed_rows, StagingTable::phrase, "tree"));
+  EXPECT_EQ(1u, count_rows(removed_rows, StagingTable::translation, "Baum"));
+  EXPECT_EQ(4u, removed_rows.size());
+
+  ImportManifest manifest;
+  manifest.load(MANIFEST_PATH);
+  EXPECT_EQ(2u, manifest.entries().size());
+
+  // Nothing changed, so nothing is imported or removed.
+  imported.clear();
+  EXPECT_TRUE(import_lines({"Haus {n} [Familie]\thouse\tnoun", "Auto {n}\tcar\tnoun"}, imported).empty());
+  EXPECT_TRUE(imported.empty());
+  std::remove(MANIFEST_PATH.c_str());
+}
+
+TEST(import_manifest, keep_facts_of_other_resources) {
+  std::remove(MANIFEST_PATH.c_str());
+  std::vector<string> imported;
+  import_lines({"Haus {n}\thouse\tnoun"}, imported);
+  // The same line is part of another resource, e.g. a second file of the same language pair.
+  std::rename(MANIFEST_PATH.c_str(), OTHER_MANIFEST_PATH.c_str());
+  import_lines({"Haus {n}\thouse\tnoun"}, imported);
+
+  ImportManifest manifest;
+  manifest.load(MANIFEST_PATH);
+  ImportManifest::removed_rows_type removed_rows;
+  EXPECT_EQ(1u, manifest.collect_removed_rows("DE", "EN", removed_rows));
+  EXPECT_EQ(3u, removed_rows.size());
+  ImportManifest::keep_facts(OTHER_MANIFEST_PATH, removed_rows);
+  EXPECT_TRUE(removed_rows.empty());
+  std::remove(MANIFEST_PATH.c_str());
+  std::remove(OTHER_MANIFEST_PATH.c_str());
+}
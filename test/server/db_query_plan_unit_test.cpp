@@ -0,0 +1,121 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Checks the query plans of all DbQuery statements against a data base, i.e. no statement must scan
+//              one of the large tables sequentially.
+//              The connection string of the data base is read from the environment variable TRLT_TEST_DB, e.g.
+//              TRLT_TEST_DB="dbname=translate user=translate". If it is not set, all tests pass without checking.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "server/db_query.hpp"
+
+#include <pqxx/pqxx>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using lgeorgieff::translate::server::DbQuery;
+using lgeorgieff::translate::server::PhrasePage;
+using std::string;
+
+namespace {
+// The tables that grow with the language resources. All other tables contain only a few rows.
+const std::vector<string> LARGE_TABLES{"phrase",  "phrase_translation", "phrase_comment",    "phrase_abbreviation",
+                                       "comment", "abbreviation",       "translation_lookup"};
+
+// Returns all lines of the query plan in the passed DbQuery that scan a large table sequentially.
+std::vector<string> sequential_scans(const DbQuery &db_query) {
+  std::vector<string> result;
+  for (const pqxx::tuple &row : db_query) {
+    string line;
+    row[0].to(line);
+    for (const string &table : LARGE_TABLES)
+      if (string::npos != line.find("Seq Scan on " + table + " ")) result.push_back(line);
+  }
+  return result;
+}
+
+// Connects to the test data base. Sequential scans are disabled for the planner, so they only appear if no index can
+// be used at all, independent of the current size of the tables.
+class db_query_plan : public testing::Test {
+ protected:
+  void SetUp() override {
+    const char *connection_string{std::getenv("TRLT_TEST_DB")};
+    if (!connection_string) {
+      std::cout << "TRLT_TEST_DB is not set, query plans are not checked" << std::endl;
+      return;
+    }
+    this->connection_.reset(new pqxx::connection{connection_string});
+    pqxx::nontransaction settings(*this->connection_);
+    settings.exec("SET enable_seqscan = off;");
+    this->db_query_.reset(new DbQuery{this->connection_.get()});
+    this->db_query_->explain(true);
+  }
+
+  std::unique_ptr<pqxx::connection> connection_;
+  std::unique_ptr<DbQuery> db_query_;
+};
+}  // anonymous namespace
+
+TEST_F(db_query_plan, request_phrase) {
+  if (!this->db_query_) return;
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_phrase("Haus", "DE", "EN")));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_phrase("Haus", "DE", "EN", "noun")));
+}
+
+TEST_F(db_query_plan, request_phrase_translation_lookup) {
+  if (!this->db_query_) return;
+  this->db_query_->use_translation_lookup(true);
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_phrase("Haus", "DE", "EN")));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_phrase("Haus", "DE", "EN", "noun")));
+}
+
+TEST_F(db_query_plan, request_phrase_page) {
+  if (!this->db_query_) return;
+  EXPECT_EQ(std::vector<string>{},
+            sequential_scans(this->db_query_->request_phrase("Haus", "DE", "EN", PhrasePage{10, 0})));
+  EXPECT_EQ(std::vector<string>{},
+            sequential_scans(this->db_query_->request_phrase("Haus", "DE", "EN", "noun", PhrasePage{10, 42})));
+  this->db_query_->use_translation_lookup(true);
+  EXPECT_EQ(std::vector<string>{},
+            sequential_scans(this->db_query_->request_phrase("Haus", "DE", "EN", PhrasePage{10, 42})));
+}
+
+TEST_F(db_query_plan, request_pivot_phrase) {
+  if (!this->db_query_) return;
+  EXPECT_EQ(std::vector<string>{},
+            sequential_scans(this->db_query_->request_pivot_phrase("къща", "BG", "EN", "FR")));
+  EXPECT_EQ(std::vector<string>{},
+            sequential_scans(this->db_query_->request_pivot_phrase("къща", "BG", "EN", "FR", "noun")));
+}
+
+TEST_F(db_query_plan, request_descriptions) {
+  if (!this->db_query_) return;
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_language_by_name("deutsch")));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_language_by_id("DE")));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_all_languages()));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_word_class_by_name("noun")));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_word_class_by_id("noun")));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_all_word_classes()));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_gender_by_name("die")));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_gender_by_id("f")));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_all_genders()));
+  EXPECT_EQ(std::vector<string>{}, sequential_scans(this->db_query_->request_all_numeri()));
+}
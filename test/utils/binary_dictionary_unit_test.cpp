@@ -0,0 +1,206 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Contains unit tests for the binary dictionary format.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "utils/binary_dictionary.hpp"
+#include "utils/exception.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using std::string;
+
+using lgeorgieff::translate::utils::BinaryDictionary;
+using lgeorgieff::translate::utils::BinaryDictionaryWriter;
+using lgeorgieff::translate::utils::DictionaryEntry;
+using lgeorgieff::translate::utils::DictionaryPhrase;
+using lgeorgieff::translate::utils::Exception;
+using lgeorgieff::translate::utils::Gender;
+using lgeorgieff::translate::utils::Numerus;
+using lgeorgieff::translate::utils::WordClass;
+
+namespace {
+const string DICTIONARY_PATH{"binary_dictionary_unit_test.bin"};
+
+DictionaryPhrase make_phrase(const string &phrase, Gender gender, Numerus numerus, WordClass word_class,
+                             const std::vector<string> &comments = {}, const std::vector<string> &abbreviations = {}) {
+  return DictionaryPhrase{phrase, gender, numerus, word_class, comments, abbreviations};
+}
+
+// Writes a small DE-EN dictionary with 100 generated phrases, so the phrase table spans several blocks.
+void write_dictionary() {
+  BinaryDictionaryWriter writer{"DE", "EN"};
+  writer.add(make_phrase("Haus", Gender::n, Numerus::none, WordClass::noun, {"Gebäude"}),
+             make_phrase("house", Gender::none, Numerus::none, WordClass::noun, {"building"}));
+  writer.add(make_phrase("Haus", Gender::n, Numerus::none, WordClass::noun, {"Familie"}),
+             make_phrase("house", Gender::none, Numerus::none, WordClass::noun, {}, {"Hse."}));
+  writer.add(make_phrase("Haus", Gender::n, Numerus::none, WordClass::noun),
+             make_phrase("home", Gender::none, Numerus::none, WordClass::noun));
+  writer.add(make_phrase("hausen", Gender::none, Numerus::none, WordClass::verb, {}, {"ugs."}),
+             make_phrase("to dwell", Gender::none, Numerus::none, WordClass::verb));
+  writer.add(make_phrase("Leute", Gender::none, Numerus::pl, WordClass::noun),
+             make_phrase("people", Gender::none, Numerus::pl, WordClass::noun));
+  for (size_t pos{0}; pos != 100; ++pos)
+    writer.add(make_phrase("Wort " + std::to_string(pos), Gender::n, Numerus::sg, WordClass::none),
+               make_phrase("word " + std::to_string(pos), Gender::none, Numerus::sg, WordClass::none));
+  std::ofstream out{DICTIONARY_PATH, std::ofstream::binary};
+  writer.write(out);
+}
+
+// Returns the content of the written dictionary.
+string read_dictionary() {
+  std::ifstream in{DICTIONARY_PATH, std::ifstream::binary};
+  return string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+// Overwrites the dictionary with the passed content.
+void rewrite_dictionary(const string &data) {
+  std::ofstream out{DICTIONARY_PATH, std::ofstream::binary | std::ofstream::trunc};
+  out << data;
+}
+
+// Writes the passed value little endian at the passed position of data.
+void write_uint32_at(string &data, size_t pos, uint32_t value) {
+  for (size_t byte{0}; byte != 4; ++byte) data[pos + byte] = static_cast<char>((value >> (8 * byte)) & 0xff);
+}
+
+// Returns the offset of the section with the passed index from the header of data.
+size_t section_offset(const string &data, size_t index) {
+  size_t result{0};
+  for (size_t byte{0}; byte != 8; ++byte)
+    result |= static_cast<size_t>(static_cast<unsigned char>(data[16 + 8 * index + byte])) << (8 * byte);
+  return result;
+}
+
+// Opens the dictionary and looks up all of its phrases.
+void lookup_all() {
+  BinaryDictionary dictionary{DICTIONARY_PATH};
+  for (size_t pos{0}; pos != dictionary.size(); ++pos) dictionary.lookup(dictionary.phrase(pos));
+}
+}  // anonymous namespace
+
+TEST(binary_dictionary, lookup) {
+  write_dictionary();
+  BinaryDictionary dictionary{DICTIONARY_PATH};
+  EXPECT_EQ(string{"DE"}, dictionary.language_in());
+  EXPECT_EQ(string{"EN"}, dictionary.language_out());
+  EXPECT_EQ(103u, dictionary.size());
+
+  std::vector<DictionaryEntry> entries{dictionary.lookup("Haus")};
+  ASSERT_EQ(1u, entries.size());
+  EXPECT_EQ(string{"Haus"}, entries[0].phrase_in.phrase);
+  EXPECT_EQ(Gender::n, entries[0].phrase_in.gender);
+  EXPECT_EQ(Numerus::none, entries[0].phrase_in.numerus);
+  EXPECT_EQ(WordClass::noun, entries[0].phrase_in.word_class);
+  EXPECT_EQ((std::vector<string>{"Gebäude", "Familie"}), entries[0].phrase_in.comments);
+  ASSERT_EQ(2u, entries[0].phrases_out.size());
+  EXPECT_EQ(string{"home"}, entries[0].phrases_out[0].phrase);
+  EXPECT_EQ(string{"house"}, entries[0].phrases_out[1].phrase);
+  EXPECT_EQ(std::vector<string>{"building"}, entries[0].phrases_out[1].comments);
+  EXPECT_EQ(std::vector<string>{"Hse."}, entries[0].phrases_out[1].abbreviations);
+
+  entries = dictionary.lookup("hausen");
+  ASSERT_EQ(1u, entries.size());
+  EXPECT_EQ(WordClass::verb, entries[0].phrase_in.word_class);
+  EXPECT_EQ(std::vector<string>{"ugs."}, entries[0].phrase_in.abbreviations);
+
+  entries = dictionary.lookup("Leute");
+  ASSERT_EQ(1u, entries.size());
+  EXPECT_EQ(Numerus::pl, entries[0].phrase_in.numerus);
+  ASSERT_EQ(1u, entries[0].phrases_out.size());
+  EXPECT_EQ(Numerus::pl, entries[0].phrases_out[0].numerus);
+
+  for (size_t pos{0}; pos != 100; ++pos) {
+    entries = dictionary.lookup("Wort " + std::to_string(pos));
+    ASSERT_EQ(1u, entries.size());
+    ASSERT_EQ(1u, entries[0].phrases_out.size());
+    EXPECT_EQ("word " + std::to_string(pos), entries[0].phrases_out[0].phrase);
+  }
+
+  EXPECT_TRUE(dictionary.lookup("Hau").empty());
+  EXPECT_TRUE(dictionary.lookup("Hausboot").empty());
+  EXPECT_TRUE(dictionary.lookup("").empty());
+  EXPECT_TRUE(dictionary.lookup("Zebra").empty());
+  std::remove(DICTIONARY_PATH.c_str());
+}
+
+TEST(binary_dictionary, phrase) {
+  write_dictionary();
+  BinaryDictionary dictionary{DICTIONARY_PATH};
+  for (size_t pos{1}; pos != dictionary.size(); ++pos) EXPECT_LT(dictionary.phrase(pos - 1), dictionary.phrase(pos));
+  EXPECT_EQ(string{"Haus"}, dictionary.phrase(0));
+  EXPECT_THROW(dictionary.phrase(dictionary.size()), Exception);
+  std::remove(DICTIONARY_PATH.c_str());
+}
+
+TEST(binary_dictionary, bad_file) {
+  EXPECT_THROW(BinaryDictionary{"binary_dictionary_unit_test.missing"}, Exception);
+  {
+    std::ofstream out{DICTIONARY_PATH, std::ofstream::binary};
+    out << "DE-EN, but not a binary dictionary at all";
+  }
+  EXPECT_THROW(BinaryDictionary{DICTIONARY_PATH}, Exception);
+  std::remove(DICTIONARY_PATH.c_str());
+}
+
+TEST(binary_dictionary, truncated_file) {
+  write_dictionary();
+  const string data{read_dictionary()};
+  EXPECT_NO_THROW(lookup_all());
+  for (size_t size : {data.size() - 1, data.size() - 16, data.size() / 2, static_cast<size_t>(60)}) {
+    rewrite_dictionary(data.substr(0, size));
+    EXPECT_THROW(lookup_all(), Exception);
+  }
+  std::remove(DICTIONARY_PATH.c_str());
+}
+
+TEST(binary_dictionary, corrupted_file) {
+  write_dictionary();
+  const string data{read_dictionary()};
+  // the count of the comment pool, which follows the header of 56 bytes
+  string corrupted{data};
+  write_uint32_at(corrupted, 56, 0x10000000);
+  rewrite_dictionary(corrupted);
+  EXPECT_THROW(BinaryDictionary{DICTIONARY_PATH}, Exception);
+
+  // the offset of the first entry in the entry table
+  corrupted = data;
+  write_uint32_at(corrupted, section_offset(data, 4), 0xfffffff0);
+  rewrite_dictionary(corrupted);
+  {
+    BinaryDictionary dictionary{DICTIONARY_PATH};
+    EXPECT_THROW(dictionary.lookup("Haus"), Exception);
+    EXPECT_FALSE(dictionary.lookup("Leute").empty());
+  }
+
+  // the offset of the second block and the phrase count of the phrase table
+  const size_t phrases{section_offset(data, 3)};
+  corrupted = data;
+  write_uint32_at(corrupted, phrases + 12, 0x7fffffff);
+  rewrite_dictionary(corrupted);
+  EXPECT_THROW(lookup_all(), Exception);
+  corrupted = data;
+  write_uint32_at(corrupted, phrases, 0xffffffff);
+  rewrite_dictionary(corrupted);
+  EXPECT_THROW(BinaryDictionary{DICTIONARY_PATH}, Exception);
+  std::remove(DICTIONARY_PATH.c_str());
+}
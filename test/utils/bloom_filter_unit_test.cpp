@@ -0,0 +1,51 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Contains unit tests for the Bloom filter.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "utils/bloom_filter.hpp"
+
+#include <string>
+
+using std::string;
+
+using lgeorgieff::translate::utils::BloomFilter;
+
+TEST(bloom_filter, contains) {
+  BloomFilter filter{1000, 0.01};
+  EXPECT_FALSE(filter.contains("haus"));
+  for (size_t pos{0}; pos != 1000; ++pos) filter.add("wort " + std::to_string(pos));
+  EXPECT_EQ(1000u, filter.size());
+  // no false negatives
+  for (size_t pos{0}; pos != 1000; ++pos) EXPECT_TRUE(filter.contains("wort " + std::to_string(pos)));
+  size_t false_positives{0};
+  for (size_t pos{0}; pos != 10000; ++pos) false_positives += filter.contains("anderes " + std::to_string(pos));
+  EXPECT_LT(false_positives, 300u);
+  EXPECT_NEAR(0.01, filter.false_positive_rate(), 0.005);
+}
+
+TEST(bloom_filter, dimensions) {
+  BloomFilter filter{1000, 0.01};
+  // about 9.6 bits per string
+  EXPECT_EQ(1200u, filter.bytes());
+  EXPECT_EQ(7u, filter.hash_count());
+  BloomFilter empty{0, 0.01};
+  EXPECT_EQ(8u, empty.bytes());
+  EXPECT_FALSE(empty.contains(""));
+  EXPECT_EQ(0.0, empty.false_positive_rate());
+}
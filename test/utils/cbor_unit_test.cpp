@@ -0,0 +1,105 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Contains unit tests for the CBOR encoding of json values.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "utils/cbor.hpp"
+#include "utils/json_exception.hpp"
+
+#include "json/json.h"
+
+#include <string>
+
+using std::string;
+
+using lgeorgieff::translate::utils::JsonException;
+using lgeorgieff::translate::utils::cbor_to_json_string;
+using lgeorgieff::translate::utils::json_to_cbor;
+
+namespace {
+// Returns the json value of the passed json string.
+Json::Value parse(const string &json_string) {
+  Json::Value result;
+  Json::Reader reader;
+  EXPECT_TRUE(reader.parse(json_string, result));
+  return result;
+}
+}  // anonymous namespace
+
+TEST(cbor, json_to_cbor) {
+  // the examples of RFC 7049, appendix A
+  EXPECT_EQ(string("\x00", 1), json_to_cbor(Json::Value{0}));
+  EXPECT_EQ("\x17", json_to_cbor(Json::Value{23}));
+  EXPECT_EQ("\x18\x18", json_to_cbor(Json::Value{24}));
+  EXPECT_EQ(string("\x19\x03\xe8", 3), json_to_cbor(Json::Value{1000}));
+  EXPECT_EQ(string("\x1a\x00\x0f\x42\x40", 5), json_to_cbor(Json::Value{1000000}));
+  EXPECT_EQ("\x20", json_to_cbor(Json::Value{-1}));
+  EXPECT_EQ("\x38\x63", json_to_cbor(Json::Value{-100}));
+  EXPECT_EQ(string("\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a", 9), json_to_cbor(Json::Value{1.1}));
+  EXPECT_EQ("\xf4", json_to_cbor(Json::Value{false}));
+  EXPECT_EQ("\xf5", json_to_cbor(Json::Value{true}));
+  EXPECT_EQ("\xf6", json_to_cbor(Json::Value{}));
+  EXPECT_EQ("\x60", json_to_cbor(Json::Value{""}));
+  EXPECT_EQ("\x64\x49\x45\x54\x46", json_to_cbor(Json::Value{"IETF"}));
+  EXPECT_EQ("\x62\xc3\xbc", json_to_cbor(Json::Value{"\xc3\xbc"}));
+  EXPECT_EQ("\x80", json_to_cbor(Json::Value{Json::arrayValue}));
+  EXPECT_EQ("\x83\x01\x02\x03", json_to_cbor(parse("[1, 2, 3]")));
+  EXPECT_EQ("\xa0", json_to_cbor(Json::Value{Json::objectValue}));
+  EXPECT_EQ("\xa2\x61\x61\x01\x61\x62\x82\x02\x03", json_to_cbor(parse("{\"a\": 1, \"b\": [2, 3]}")));
+}
+
+TEST(cbor, cbor_to_json_string) {
+  EXPECT_EQ("0", cbor_to_json_string(string("\x00", 1)));
+  EXPECT_EQ("1000000", cbor_to_json_string(string("\x1a\x00\x0f\x42\x40", 5)));
+  EXPECT_EQ("18446744073709551615", cbor_to_json_string("\x1b\xff\xff\xff\xff\xff\xff\xff\xff"));
+  EXPECT_EQ("-18446744073709551616", cbor_to_json_string("\x3b\xff\xff\xff\xff\xff\xff\xff\xff"));
+  EXPECT_EQ("-100", cbor_to_json_string("\x38\x63"));
+  EXPECT_EQ(1.5, parse(cbor_to_json_string(string("\xf9\x3e\x00", 3))).asDouble());
+  EXPECT_EQ(100000.0, parse(cbor_to_json_string(string("\xfa\x47\xc3\x50\x00", 5))).asDouble());
+  EXPECT_EQ("null", cbor_to_json_string(string("\xf9\x7c\x00", 3)));
+  EXPECT_EQ("[false,true,null,null]", cbor_to_json_string("\x84\xf4\xf5\xf6\xf7"));
+  EXPECT_EQ("\"a\\\"\\\\\\n\\u0001\xc3\xbc\"", cbor_to_json_string("\x67\x61\x22\x5c\x0a\x01\xc3\xbc"));
+  EXPECT_EQ("{\"a\":1,\"b\":[2,3]}", cbor_to_json_string("\xa2\x61\x61\x01\x61\x62\x82\x02\x03"));
+  // indefinite length array and map
+  EXPECT_EQ("[1,[2,3],{\"a\":\"b\"}]", cbor_to_json_string("\x9f\x01\x82\x02\x03\xbf\x61\x61\x61\x62\xff\xff"));
+  EXPECT_EQ("[]", cbor_to_json_string("\x9f\xff"));
+}
+
+TEST(cbor, round_trip) {
+  const Json::Value value{parse(
+      "[{\"phrase\": \"Haus\", \"word_class\": \"noun\", \"gender\": \"n\", \"abbreviations\": [\"Hs.\"], "
+      "\"comments\": [\"building\", \"\\u00fcber \\\"home\\\"\"]}, {\"phrase\": \"\\u0394\", \"count\": -42, "
+      "\"rate\": 0.25, \"big\": 4294967296, \"empty\": {}, \"none\": null, \"flag\": true}]")};
+  EXPECT_EQ(value, parse(cbor_to_json_string(json_to_cbor(value))));
+  EXPECT_LT(json_to_cbor(value).size(), Json::FastWriter{}.write(value).size());
+}
+
+TEST(cbor, malformed) {
+  EXPECT_THROW(cbor_to_json_string(""), JsonException);
+  EXPECT_THROW(cbor_to_json_string("\x83\x01\x02"), JsonException);
+  EXPECT_THROW(cbor_to_json_string("\x64\x49\x45"), JsonException);
+  EXPECT_THROW(cbor_to_json_string("\x01\x02"), JsonException);
+  EXPECT_THROW(cbor_to_json_string("\x9f\x01"), JsonException);
+  // byte strings, tags, non string keys and indefinite length strings have no json counterpart
+  EXPECT_THROW(cbor_to_json_string("\x41\x00"), JsonException);
+  EXPECT_THROW(cbor_to_json_string("\xc1\x01"), JsonException);
+  EXPECT_THROW(cbor_to_json_string("\xa1\x01\x02"), JsonException);
+  EXPECT_THROW(cbor_to_json_string("\x7f\x61\x61\xff"), JsonException);
+  EXPECT_THROW(cbor_to_json_string("\x1c"), JsonException);
+  EXPECT_THROW(cbor_to_json_string(string(1000, '\x81')), JsonException);
+}
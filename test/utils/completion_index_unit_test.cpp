@@ -0,0 +1,76 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Contains unit tests for the prefix completion index.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "utils/completion_index.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using std::string;
+
+using lgeorgieff::translate::utils::CompletionIndex;
+
+TEST(completion_index, complete) {
+  CompletionIndex index;
+  index.add("Haus", 10);
+  index.add("Hausaufgabe", 3);
+  index.add("Hausboot", 3);
+  index.add("Haustür", 7);
+  index.add("Hase", 1);
+  index.add("Hund", 8);
+  index.add("Haus", 2);
+  index.build();
+
+  EXPECT_EQ(6u, index.size());
+  EXPECT_EQ((std::vector<string>{"Haus", "Haustür", "Hausaufgabe"}), index.complete("Ha", 3));
+  EXPECT_EQ((std::vector<string>{"Haus", "Haustür", "Hausaufgabe", "Hausboot"}), index.complete("Haus", 10));
+  EXPECT_EQ((std::vector<string>{"Haus", "Hund", "Haustür"}), index.complete("", 3));
+  EXPECT_EQ(std::vector<string>{"Hausboot"}, index.complete("Hausb", 10));
+  EXPECT_TRUE(index.complete("Hausx", 10).empty());
+  EXPECT_TRUE(index.complete("Z", 10).empty());
+  EXPECT_TRUE(index.complete("Ha", 0).empty());
+}
+
+TEST(completion_index, large_ranges) {
+  // Enough phrases, so that several trie nodes hold precomputed completions.
+  CompletionIndex index;
+  std::vector<std::pair<string, size_t>> phrases;
+  for (size_t pos{0}; pos != 1000; ++pos) phrases.emplace_back("Wort " + std::to_string(pos), (pos * 7919) % 101);
+  for (const std::pair<string, size_t> &phrase : phrases) index.add(phrase.first, phrase.second);
+  index.build();
+  ASSERT_EQ(1000u, index.size());
+
+  for (const string &prefix : {string{""}, string{"W"}, string{"Wort "}, string{"Wort 1"}, string{"Wort 12"},
+                               string{"Wort 123"}, string{"Wort 9"}}) {
+    std::vector<std::pair<string, size_t>> expected;
+    for (const std::pair<string, size_t> &phrase : phrases)
+      if (!phrase.first.compare(0, prefix.size(), prefix)) expected.push_back(phrase);
+    std::sort(expected.begin(), expected.end(),
+              [](const std::pair<string, size_t> &lft, const std::pair<string, size_t> &rgt) {
+                return lft.second != rgt.second ? lft.second > rgt.second : lft.first < rgt.first;
+              });
+    std::vector<string> expected_phrases;
+    for (size_t pos{0}; pos != std::min<size_t>(20, expected.size()); ++pos)
+      expected_phrases.push_back(expected[pos].first);
+    EXPECT_EQ(expected_phrases, index.complete(prefix, 20)) << "prefix \"" << prefix << "\"";
+  }
+  EXPECT_EQ(CompletionIndex::MAX_COMPLETIONS, index.complete("Wort", 1000).size());
+}
@@ -0,0 +1,66 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Contains unit tests for the fuzzy phrase index.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "utils/fuzzy_index.hpp"
+
+#include <string>
+#include <vector>
+
+using std::string;
+
+using lgeorgieff::translate::utils::FuzzyIndex;
+
+TEST(fuzzy_index, edit_distance) {
+  EXPECT_EQ(0u, FuzzyIndex::edit_distance(U"Haus", U"Haus", 2));
+  EXPECT_EQ(1u, FuzzyIndex::edit_distance(U"Haus", U"Hasu", 2));
+  EXPECT_EQ(1u, FuzzyIndex::edit_distance(U"Haus", U"Maus", 2));
+  EXPECT_EQ(1u, FuzzyIndex::edit_distance(U"Haus", U"Hau", 2));
+  EXPECT_EQ(2u, FuzzyIndex::edit_distance(U"Haus", U"Hxausx", 2));
+  EXPECT_EQ(1u, FuzzyIndex::edit_distance(U"français", U"francais", 2));
+  EXPECT_EQ(2u, FuzzyIndex::edit_distance(U"Haus", U"Baum", 2));
+  EXPECT_EQ(3u, FuzzyIndex::edit_distance(U"Haus", U"Hund", 2));
+  EXPECT_EQ(2u, FuzzyIndex::edit_distance(U"Haus", U"", 1));
+  EXPECT_EQ(4u, FuzzyIndex::edit_distance(U"", U"Haus", 10));
+}
+
+TEST(fuzzy_index, lookup) {
+  FuzzyIndex index;
+  index.add("Haus", 5);
+  index.add("Maus", 2);
+  index.add("Laus", 9);
+  index.add("Hausaufgabe", 3);
+  index.add("Hauptbahnhof", 4);
+  index.add("français", 1);
+  index.add("Baum", 7);
+  index.build();
+  EXPECT_EQ(7u, index.size());
+
+  EXPECT_EQ((std::vector<string>{"Haus", "Laus", "Maus"}), index.lookup("Haus", 1, 10));
+  EXPECT_EQ((std::vector<string>{"Haus"}), index.lookup("Hasu", 1, 10));
+  EXPECT_EQ((std::vector<string>{"Laus", "Haus", "Maus"}), index.lookup("Xaus", 1, 10));
+  EXPECT_EQ((std::vector<string>{"Laus"}), index.lookup("Xaus", 1, 1));
+  EXPECT_EQ((std::vector<string>{"Hauptbahnhof"}), index.lookup("Hauptbahnhoff", 1, 10));
+  EXPECT_EQ((std::vector<string>{"Hauptbahnhof"}), index.lookup("Hauptbanhoff", 2, 10));
+  EXPECT_EQ((std::vector<string>{"Hausaufgabe"}), index.lookup("Husaufgab", 2, 10));
+  EXPECT_EQ((std::vector<string>{"français"}), index.lookup("francais", 1, 10));
+  EXPECT_TRUE(index.lookup("Hauptbanhoff", 1, 10).empty());
+  EXPECT_TRUE(index.lookup("Zebra", 2, 10).empty());
+  EXPECT_EQ(index.lookup("Hauptbanhoff", 2, 10), index.lookup("Hauptbanhoff", 5, 10));
+}
@@ -1,6 +1,6 @@
 // ====================================================================================================================
 // Copyright (C) 2015  Lukas Georgieff
-// Last modified: 06/06/2015
+// Last modified: 10/19/2026
 // Description: Unit test for the helper mudule.
 // ====================================================================================================================
 
@@ -32,8 +32,13 @@ using lgeorgieff::translate::utils::trim_right;
 using lgeorgieff::translate::utils::trim;
 using lgeorgieff::translate::utils::normalize_whitespace;
 using lgeorgieff::translate::utils::split_string;
+using lgeorgieff::translate::utils::percent_encode;
 using lgeorgieff::translate::utils::parse_accept_header_item;
+using lgeorgieff::translate::utils::parse_accept_header_quality;
+using lgeorgieff::translate::utils::accept_header_quality;
 using lgeorgieff::translate::utils::check_accept_header;
+using lgeorgieff::translate::utils::utf8_to_u32string;
+using lgeorgieff::translate::utils::u32string_to_utf8;
 
 TEST(helper, trim_left) {
   string str{};
@@ -195,3 +200,45 @@ TEST(helper, check_accept_header) {
   EXPECT_FALSE(check_accept_header(accept_header, "texts/plain"));
   EXPECT_FALSE(check_accept_header(accept_header, " texts /  *  ;q=0.5"));
 }
+
+TEST(helper, accept_header_quality) {
+  EXPECT_DOUBLE_EQ(1, parse_accept_header_quality("application/json"));
+  EXPECT_DOUBLE_EQ(0.5, parse_accept_header_quality("application/json; level=1 ; q = 0.5"));
+  EXPECT_DOUBLE_EQ(0, parse_accept_header_quality("application/json;q=0"));
+  EXPECT_DOUBLE_EQ(1, parse_accept_header_quality("application/json;q=x"));
+
+  const std::string accept_header{"application/cbor;q=0, application/*;q=0.5, */*;q=0.1, text/html"};
+  EXPECT_DOUBLE_EQ(0, accept_header_quality(accept_header, "application/cbor"));
+  EXPECT_DOUBLE_EQ(0.5, accept_header_quality(accept_header, "application/json"));
+  EXPECT_DOUBLE_EQ(0.1, accept_header_quality(accept_header, "image/png"));
+  EXPECT_DOUBLE_EQ(1, accept_header_quality(accept_header, "text/html"));
+  EXPECT_DOUBLE_EQ(0, accept_header_quality(accept_header, "application/json", true));
+  EXPECT_DOUBLE_EQ(0, accept_header_quality("text/html", "application/json"));
+
+  EXPECT_FALSE(check_accept_header(accept_header, "application/cbor"));
+  EXPECT_TRUE(check_accept_header(accept_header, "application/json"));
+  EXPECT_FALSE(check_accept_header("application/json;q=0", "application/json"));
+}
+
+TEST(helper, utf8) {
+  EXPECT_EQ(std::u32string{U"Haus"}, utf8_to_u32string("Haus"));
+  EXPECT_EQ(std::u32string{U"français"}, utf8_to_u32string("français"));
+  EXPECT_EQ(std::u32string{U"ελληνικά"}, utf8_to_u32string("ελληνικά"));
+  EXPECT_EQ(std::u32string{U"\U0001F600"}, utf8_to_u32string("\xF0\x9F\x98\x80"));
+  EXPECT_EQ((std::u32string{U'a', 0xE7, U'b'}), utf8_to_u32string("a\xE7" "b"));
+  EXPECT_EQ(std::u32string{}, utf8_to_u32string(""));
+
+  EXPECT_EQ(string{"français"}, u32string_to_utf8(U"français"));
+  EXPECT_EQ(string{"ελληνικά"}, u32string_to_utf8(U"ελληνικά"));
+  EXPECT_EQ(string{"\xF0\x9F\x98\x80"}, u32string_to_utf8(U"\U0001F600"));
+}
+
+TEST(helper, percent_encode) {
+  EXPECT_EQ("Haus", percent_encode("Haus"));
+  EXPECT_EQ("a-b.c_d~e", percent_encode("a-b.c_d~e"));
+  EXPECT_EQ("to%20be", percent_encode("to be"));
+  EXPECT_EQ("Stra%C3%9Fe", percent_encode("Straße"));
+  EXPECT_EQ("Haus%0D%0AX-Injected%3A%201", percent_encode("Haus\r\nX-Injected: 1"));
+  EXPECT_EQ("100%25", percent_encode("100%"));
+  EXPECT_EQ("", percent_encode(""));
+}
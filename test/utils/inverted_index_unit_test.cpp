@@ -0,0 +1,80 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Contains unit tests for the inverted index over comments and abbreviations.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "utils/inverted_index.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using std::string;
+
+using lgeorgieff::translate::utils::InvertedIndex;
+
+TEST(inverted_index, tokenize) {
+  EXPECT_EQ((std::vector<string>{"br"}), InvertedIndex::tokenize("Br."));
+  EXPECT_EQ((std::vector<string>{"br"}), InvertedIndex::tokenize("<br>"));
+  EXPECT_EQ((std::vector<string>{"jur", "law"}), InvertedIndex::tokenize("[Jur.] law"));
+  EXPECT_EQ((std::vector<string>{"osterr", "ugs"}), InvertedIndex::tokenize("[österr.] [ugs.]"));
+  EXPECT_EQ((std::vector<string>{"sb", "s", "friend"}), InvertedIndex::tokenize("sb.'s friend"));
+  EXPECT_EQ(std::vector<string>{}, InvertedIndex::tokenize(" .,; "));
+  EXPECT_EQ(std::vector<string>{}, InvertedIndex::tokenize(""));
+}
+
+TEST(inverted_index, lookup) {
+  InvertedIndex index;
+  index.add("Br.", 7);
+  index.add("Am.", 3);
+  index.add("[Jur.]", 7);
+  index.add("[Jur.] [Br.]", 1000000);
+  index.add("Br.", 1);
+  index.add("Br.", 1);
+  index.add("[ugs.]", 3);
+  index.build();
+  EXPECT_EQ(4u, index.size());
+
+  EXPECT_EQ((std::vector<uint32_t>{1, 7, 1000000}), index.lookup("br"));
+  EXPECT_EQ((std::vector<uint32_t>{1, 7, 1000000}), index.lookup("<Br.>"));
+  EXPECT_EQ((std::vector<uint32_t>{7, 1000000}), index.lookup("jur br"));
+  EXPECT_EQ((std::vector<uint32_t>{7, 1000000}), index.lookup("Jur. Jur. Br."));
+  EXPECT_EQ((std::vector<uint32_t>{3}), index.lookup("am ugs"));
+  EXPECT_EQ(std::vector<uint32_t>{}, index.lookup("am br"));
+  EXPECT_EQ(std::vector<uint32_t>{}, index.lookup("br missing"));
+  EXPECT_EQ(std::vector<uint32_t>{}, index.lookup("..."));
+}
+
+TEST(inverted_index, compression) {
+  InvertedIndex index;
+  for (uint32_t id{0}; id != 1000; ++id) index.add("dense", 5000 + id);
+  index.add("sparse", 0);
+  index.add("sparse", 4000000000u);
+  index.build();
+  // 1 byte per gap of 1, the first id 5000 needs 2 bytes; 0 needs 1 byte and 4000000000 needs 5 bytes
+  EXPECT_EQ(1001u + 6u, index.posting_bytes());
+  EXPECT_EQ(1000u, index.lookup("dense").size());
+  EXPECT_EQ((std::vector<uint32_t>{0, 4000000000u}), index.lookup("sparse"));
+}
+
+TEST(inverted_index, empty) {
+  InvertedIndex index;
+  index.build();
+  EXPECT_EQ(0u, index.size());
+  EXPECT_EQ(std::vector<uint32_t>{}, index.lookup("br"));
+}
@@ -0,0 +1,83 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Contains unit tests for the least recently used cache.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "utils/lru_cache.hpp"
+
+#include <string>
+#include <vector>
+
+using std::string;
+
+using lgeorgieff::translate::utils::LruCache;
+
+TEST(lru_cache, get_and_put) {
+  LruCache<string, int> cache{2};
+  EXPECT_EQ(nullptr, cache.get("Haus"));
+  cache.put("Haus", 1);
+  cache.put("Hund", 2);
+  ASSERT_NE(nullptr, cache.get("Haus"));
+  EXPECT_EQ(1, *cache.get("Haus"));
+  // "Hund" is the least recently used entry now
+  cache.put("Hase", 3);
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(nullptr, cache.get("Hund"));
+  EXPECT_EQ(3, *cache.get("Hase"));
+  cache.put("Haus", 4);
+  EXPECT_EQ(4, *cache.get("Haus"));
+  EXPECT_EQ(2u, cache.size());
+  cache.clear();
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(nullptr, cache.get("Haus"));
+}
+
+TEST(lru_cache, zero_capacity) {
+  LruCache<string, int> cache{0};
+  cache.put("Haus", 1);
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(nullptr, cache.get("Haus"));
+}
+
+TEST(lru_cache, most_used) {
+  LruCache<string, int> cache{10};
+  cache.put("Haus", 1);
+  cache.put("Hund", 2);
+  cache.put("Hase", 3);
+  cache.get("Hund");
+  cache.get("Hund");
+  cache.get("Haus");
+  EXPECT_EQ((std::vector<string>{"Hund", "Haus"}), cache.most_used(2));
+  EXPECT_EQ((std::vector<string>{"Hund", "Haus", "Hase"}), cache.most_used(10));
+  EXPECT_TRUE(cache.most_used(0).empty());
+}
+
+TEST(lru_cache, erase_if) {
+  LruCache<string, int> cache{10};
+  cache.put("DE\tEN\tHaus", 1);
+  cache.put("FR\tEN\tmaison", 2);
+  cache.put("DE\tFR\tHund", 3);
+  EXPECT_EQ(2u, cache.erase_if([](const string &key) { return !key.compare(0, 2, "DE"); }));
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(nullptr, cache.get("DE\tEN\tHaus"));
+  EXPECT_EQ(2, *cache.get("FR\tEN\tmaison"));
+  EXPECT_EQ(0u, cache.erase_if([](const string &) { return false; }));
+  // erased keys can be cached again
+  cache.put("DE\tEN\tHaus", 4);
+  EXPECT_EQ(4, *cache.get("DE\tEN\tHaus"));
+}
@@ -0,0 +1,64 @@
+// ====================================================================================================================
+// Copyright (C) 2015  Lukas Georgieff
+// Last modified: 10/19/2026
+// Description: Contains unit tests for the folding of phrases into search keys.
+// ====================================================================================================================
+
+// ====================================================================================================================
+// This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation in version 2.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program; if not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+// ====================================================================================================================
+
+#include "gtest/gtest.h"
+
+#include "utils/phrase_key.hpp"
+
+#include <string>
+
+using std::string;
+
+using lgeorgieff::translate::utils::to_phrase_key;
+
+TEST(phrase_key, to_phrase_key_latin) {
+  EXPECT_EQ("haus", to_phrase_key("Haus"));
+  EXPECT_EQ("haus", to_phrase_key("HAUS"));
+  EXPECT_EQ("francais", to_phrase_key("Français"));
+  EXPECT_EQ("strasse", to_phrase_key("Straße"));
+  EXPECT_EQ("uber", to_phrase_key("Über"));
+  EXPECT_EQ("aeroskobing", to_phrase_key("Ærøskøbing"));
+  EXPECT_EQ("lodz", to_phrase_key("Łódź"));
+  EXPECT_EQ("sarpe", to_phrase_key("Șarpe"));
+  EXPECT_EQ("oeuvre", to_phrase_key("Œuvre"));
+  EXPECT_EQ("to be (sb.'s) friend", to_phrase_key("to be (sb.'s) friend"));
+  EXPECT_EQ("", to_phrase_key(""));
+}
+
+TEST(phrase_key, to_phrase_key_combining_marks) {
+  EXPECT_EQ("cafe", to_phrase_key("cafe\xCC\x81"));
+  EXPECT_EQ(to_phrase_key("café"), to_phrase_key("cafe\xCC\x81"));
+}
+
+TEST(phrase_key, to_phrase_key_greek) {
+  EXPECT_EQ("αθηνα", to_phrase_key("Αθήνα"));
+  EXPECT_EQ("λογοσ", to_phrase_key("ΛΌΓΟΣ"));
+  EXPECT_EQ("λογοσ", to_phrase_key("λόγος"));
+}
+
+TEST(phrase_key, to_phrase_key_cyrillic) {
+  EXPECT_EQ("москва", to_phrase_key("Москва"));
+  EXPECT_EQ("елка", to_phrase_key("Ёлка"));
+  EXPECT_EQ("їжак", to_phrase_key("Їжак"));
+}
+
+TEST(phrase_key, to_phrase_key_other) {
+  EXPECT_EQ("1 × 2", to_phrase_key("1 × 2"));
+  EXPECT_EQ("日本", to_phrase_key("日本"));
+  EXPECT_EQ(to_phrase_key("Haus"), to_phrase_key(to_phrase_key("Haus")));
+}